@@ -125,6 +125,14 @@ var products: [Product] = [
         name: "TextureAtlasBuilderTool",
         targets: ["TextureAtlasBuilderTool"]
     ),
+    .executable(
+        name: "AdaPhysicsBenchmark",
+        targets: ["AdaPhysicsBenchmark"]
+    ),
+    .executable(
+        name: "AdaImageBenchmark",
+        targets: ["AdaImageBenchmark"]
+    ),
     .plugin(name: "TextureAtlasBuildPlugin", targets: [
         "TextureAtlasBuildPlugin"
     ]),
@@ -613,6 +621,30 @@ targets.append(
     )
 )
 
+targets.append(
+    .executableTarget(
+        name: "AdaPhysicsBenchmark",
+        dependencies: [
+            "AdaApp",
+            "AdaECS",
+            "AdaPhysics",
+            "AdaTransform",
+            "Math",
+            "box2d",
+            "box2dBenchmarks"
+        ],
+        swiftSettings: swiftSettings
+    )
+)
+
+targets.append(
+    .executableTarget(
+        name: "AdaImageBenchmark",
+        dependencies: ["AdaRender"],
+        swiftSettings: swiftSettings
+    )
+)
+
 targets.append(
     .plugin(
         name: "TextureAtlasBuildPlugin",
@@ -699,12 +731,30 @@ targets += [
         ]
     ),
 
+    // Scenarios of the box2d benchmark app, used by AdaPhysicsBenchmark
+
+    .target(
+        name: "box2dBenchmarks",
+        dependencies: [
+            "box2d"
+        ],
+        path: "Sources/box2d/shared",
+        exclude: [
+            "CMakeLists.txt"
+        ],
+        publicHeadersPath: ".",
+        cSettings: [
+            .unsafeFlags(["-w"])
+        ]
+    ),
+
     // GLSLang & SPIRV
 
     .adaTarget(
         name: "SPIRVCompiler",
         dependencies: [
-            "glslang"
+            "glslang",
+            "SPIRV-Cross"
         ],
         publicHeadersPath: ".",
         cxxSettings: [
@@ -844,10 +894,16 @@ targets += [
             "libpng/pngwrite.c",
             "libpng/pngwtran.c",
             "libpng/pngwutil.c",
+            "libpng/intel/intel_init.c",
+            "libpng/intel/filter_sse2_intrinsics.c",
+            "libpng/intel/palette_sse2_intrinsics.c",
+            "libpng/swift_png_stream.c",
         ],
         publicHeadersPath: "libpng/include",
         cSettings: [
             .define("PNG_ARM_NEON_OPT", to: "0"),
+            // SSE2 filters are compiled only for x86 targets, AVX2 paths are selected at run time.
+            .define("PNG_INTEL_SSE"),
             .define("PNG_SETJMP_NOT_SUPPORTED", .when(platforms: [.wasi])),
             .unsafeFlags(["-mllvm", "-wasm-enable-sjlj"], .when(platforms: [.wasi])),
             .unsafeFlags(["-w"])
@@ -1079,6 +1135,7 @@ targets += [
         name: "AdaRenderTests",
         dependencies: [
             "AdaRender",
+            "AdaAssets",
             "Math",
             "AdaUtilsTesting"
         ]
@@ -1109,6 +1166,7 @@ targets += [
         name: "AdaSceneTests",
         dependencies: [
             "AdaScene",
+            "AdaAssets",
             "AdaAnimation",
             "AdaECS"
         ]
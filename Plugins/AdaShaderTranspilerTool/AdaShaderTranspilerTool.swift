@@ -59,7 +59,12 @@ struct AdaShaderTranspilerTool {
     private static func compileSPIRV(source: String, stage: ShaderStage) throws -> Data {
         var error: UnsafePointer<CChar>?
         let source = source.insertingDefaultVertexDefines()
-        let options = spirv_options(preamble: nil)
+        let options = spirv_options(
+            preamble: nil,
+            include_search_paths: nil,
+            include_search_paths_count: 0,
+            remap_flags: SPIRV_REMAP_NONE.rawValue
+        )
         let binary = source.withCString { sourcePointer in
             compile_shader_glsl(
                 sourcePointer,
@@ -69,6 +74,10 @@ struct AdaShaderTranspilerTool {
             )
         }
 
+        defer {
+            spirv_bin_free(binary)
+        }
+
         if let error {
             throw ToolError.glslCompilationFailed(String(cString: error))
         }
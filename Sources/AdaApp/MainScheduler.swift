@@ -91,11 +91,16 @@ public struct FixedTimeSchedulerSystem {
     public func update(context: UpdateContext) async {
         let deltaTime = time.deltaTime
         let result = self.fixedTimestep.advance(with: deltaTime)
+        let world = context.world
+        // Updated every frame, so systems between fixed ticks can interpolate by the overstep.
+        world.insertResource(
+            FixedTime(
+                deltaTime: self.fixedTimestep.step,
+                overstepFraction: self.fixedTimestep.overstepFraction
+            )
+        )
 
         if result.isFixedTick {
-            let step = self.fixedTimestep.step
-            let world = context.world
-            world.insertResource(FixedTime(deltaTime: step))
             for scheduler in order {
                 await world.runScheduler(scheduler)
             }
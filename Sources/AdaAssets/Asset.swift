@@ -53,6 +53,16 @@ public protocol Asset: Sendable {
     var assetMetaInfo: AssetMetaInfo? { get set }
 }
 
+/// An asset that decodes many files faster together than one by one.
+///
+/// ``AssetsManager`` passes files that aren't cached yet to this method when assets are loaded in a batch.
+public protocol BatchDecodableAsset: Asset {
+    /// Decode assets of the files.
+    ///
+    /// - Returns: Results in the order of `urls`. A nil result means the file is decoded with ``Asset/init(from:)``.
+    static func decodeAssets(contentsOf urls: [URL]) async -> [Result<Self, any Error>?]
+}
+
 public extension Asset {
     /// If resource was initiated from resource, than property will return path to that file relative source dir.
     /// - Warning: Do not override stored value.
@@ -147,6 +147,81 @@ public struct AssetsManager: Resource {
 
         return handle
     }
+
+    /// Load resources and save them to the memory cache.
+    ///
+    /// Files of ``BatchDecodableAsset`` types that aren't cached yet are decoded together,
+    /// for example a batch of images is decoded on all cores.
+    ///
+    /// ```swift
+    /// let sprites = try await AssetsManager.load(Image.self, at: ["@res://hero.png", "@res://enemy.png"])
+    /// ```
+    /// - Parameter paths: Paths to the resources.
+    /// - Returns: Handles in the order of `paths`.
+    @AssetActor
+    public static func load<A: Asset>(
+        _ type: A.Type,
+        at paths: [String]
+    ) async throws -> [AssetHandle<A>] {
+        let span = AdaTrace.startSpan("Assets.loadBatch.\(String(reflecting: A.self))")
+        defer {
+            span.end()
+        }
+
+        var handles = [AssetHandle<A>?](repeating: nil, count: paths.count)
+        var pendingIndices: [Int] = []
+        var pendingPaths: [Path] = []
+        for (index, path) in paths.enumerated() {
+            if let cachedAsset = self.getHandlingResource(path: path, resourceType: A.self)?.value as? AssetHandle<A> {
+                handles[index] = cachedAsset
+                continue
+            }
+
+            let processedPath = self.processPath(path)
+            if processedPath.url.pathExtension.isEmpty {
+                throw AssetError.notExistAtPath(processedPath.url.path)
+            }
+            if shouldCheckAssetFileExistence {
+                guard FileSystem.current.itemExists(at: processedPath.url) else {
+                    throw AssetError.notExistAtPath(processedPath.url.path)
+                }
+            }
+
+            pendingIndices.append(index)
+            pendingPaths.append(processedPath)
+        }
+
+        var results = [Result<A, any Error>?](repeating: nil, count: pendingPaths.count)
+        // Files are fetched by the browser on WebAssembly, so they are decoded one by one.
+        #if !WASM
+        if let batchType = A.self as? any BatchDecodableAsset.Type {
+            results = await self.decodeAssets(batchType, contentsOf: pendingPaths.map(\.url))
+        }
+        #endif
+
+        for (pendingIndex, index) in pendingIndices.enumerated() {
+            let path = paths[index]
+            // The same path can be listed more than once.
+            if let cachedAsset = self.getHandlingResource(path: path, resourceType: A.self)?.value as? AssetHandle<A> {
+                handles[index] = cachedAsset
+                continue
+            }
+
+            var resource: A
+            if let result = results[pendingIndex] {
+                resource = try result.get()
+                resource.assetMetaInfo = self.makeAssetMetaInfo(for: pendingPaths[pendingIndex], originalPath: path, bundle: nil)
+            } else {
+                resource = try await self.load(from: pendingPaths[pendingIndex], originalPath: path, bundle: nil)
+            }
+
+            let handle = AssetHandle(resource)
+            self.storage.loadedAssets[path, default: []].insert(WeakBox(handle))
+            handles[index] = handle
+        }
+
+        return handles.map { $0! }
+    }
     
     /// Load a resource with block current thread and saving it to memory cache.
     /// It may be useful to load resource without concurrent context.
@@ -536,15 +611,29 @@ public struct AssetsManager: Resource {
         let meta = AssetMeta(filePath: path.url, queryParams: path.query)
         let decoder = TextAssetDecoder(meta: meta, data: data)
         var resource = try await A.init(from: decoder)
+        resource.assetMetaInfo = self.makeAssetMetaInfo(for: path, originalPath: originalPath, bundle: bundle)
+
+        return resource
+    }
 
-        resource.assetMetaInfo = AssetMetaInfo(
+    private static func makeAssetMetaInfo(for path: Path, originalPath: String, bundle: Bundle?) -> AssetMetaInfo {
+        return AssetMetaInfo(
             assetId: RID(),
             assetPath: originalPath,
             assetName: path.url.lastPathComponent,
             bundlePath: bundle?.bundleIdentifier
         )
+    }
 
-        return resource
+    private static func decodeAssets<A: Asset, B: BatchDecodableAsset>(
+        _ type: B.Type,
+        contentsOf urls: [URL]
+    ) async -> [Result<A, any Error>?] {
+        return await B.decodeAssets(contentsOf: urls).map { result in
+            result.map { result in
+                result.map { $0 as! A }
+            }
+        }
     }
 
     private static func readData(from path: Path) async throws -> Data {
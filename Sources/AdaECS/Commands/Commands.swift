@@ -136,6 +136,48 @@ public extension Commands {
         return EntityCommands(queue: queue, entityId: entity.id)
     }
 
+    /// Spawn entities with components of the same types in one command.
+    /// - Parameter count: The number of entities to spawn.
+    /// - Parameter bundle: Returns components of the entity at the index.
+    /// - Returns: Identifiers of the entities, available before the command is applied.
+    @discardableResult
+    func spawnBatch<T: ComponentsBundle>(
+        _ name: String = "",
+        count: Int,
+        bundle: @escaping @Sendable (Int) -> T
+    ) -> [Entity.ID] {
+        let entities = (0..<count).map { _ in self.entities.allocate(with: name) }
+        self.queue.push { world in
+            world.insertNewEntities(entities, components: (0..<count).map { bundle($0).components })
+        }
+        return entities.map(\.id)
+    }
+
+    /// Spawn entities with components of the same types in one command.
+    /// - Parameter count: The number of entities to spawn.
+    /// - Parameter components: Returns components of the entity at the index.
+    /// - Returns: Identifiers of the entities, available before the command is applied.
+    @discardableResult
+    func spawnBatch(
+        _ name: String = "",
+        count: Int,
+        @ComponentsBuilder components: @escaping @Sendable (Int) -> ComponentsBundle
+    ) -> [Entity.ID] {
+        let entities = (0..<count).map { _ in self.entities.allocate(with: name) }
+        self.queue.push { world in
+            world.insertNewEntities(entities, components: (0..<count).map { components($0).components })
+        }
+        return entities.map(\.id)
+    }
+
+    /// Insert a component to each entity in one command.
+    /// - Parameter components: Pairs of an entity and its component.
+    func insertBatch<T: Component>(_ components: [(Entity.ID, T)]) {
+        self.queue.push { world in
+            world.insertBatch(components)
+        }
+    }
+
     @discardableResult
     func insertEntity(_ entity: Entity) -> EntityCommands {
         entities.addNotAllocatedEntity(entity)
@@ -204,6 +246,35 @@ public extension EntityCommands {
         return self
     }
 
+    /// Make an entity spawned by earlier commands a child of this entity.
+    @discardableResult
+    @inline(__always)
+    func addChild(
+        _ childId: Entity.ID
+    ) -> Self {
+        self.queue.push { [entityId] world in
+            guard let child = world.getEntityByID(childId) else {
+                return
+            }
+            world.getEntityByID(entityId)?.addChild(child)
+        }
+        return self
+    }
+
+    @discardableResult
+    @inline(__always)
+    func removeChild(
+        _ childId: Entity.ID
+    ) -> Self {
+        self.queue.push { [entityId] world in
+            guard let child = world.getEntityByID(childId) else {
+                return
+            }
+            world.getEntityByID(entityId)?.removeChild(child)
+        }
+        return self
+    }
+
     @inline(__always)
     func removeFromWorld(recursively: Bool = false) {
         self.queue.push { [entityId] world in
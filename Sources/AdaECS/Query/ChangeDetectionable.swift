@@ -43,5 +43,6 @@ public extension ChangeDetectionable {
             .change?
             .getPointer()
             .pointee = self.changeTick.currentTick
+        self.changeTick.lastChange?.update(self.changeTick.currentTick)
     }
 }
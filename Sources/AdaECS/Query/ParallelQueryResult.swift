@@ -6,21 +6,129 @@
 //
 
 import AdaUtils
+import Atomics
+import Foundation
 
-/// Information about a chunk location for parallel processing.
-private struct ChunkInfo: Sendable {
+/// Rows of a chunk processed by a job.
+struct QueryChunkRange: Sendable {
     let archetypeIndex: Int
     let chunkIndex: Int
+    let rows: Range<Int>
+}
+
+/// Jobs of a parallel query split by entity count.
+///
+/// Each job is a sequence of chunk ranges with up to `batchSize` entities in total:
+/// large chunks are split between jobs and small chunks are merged into one job.
+/// Jobs follow the order of sequential iteration, so results collected by job index are deterministic.
+/// Chunks rejected by `includesChunk` don't get jobs.
+struct QueryJobs: Sendable {
+    /// Chunk ranges of all jobs.
+    let ranges: [QueryChunkRange]
+
+    /// Indices of ``ranges`` for each job.
+    let jobs: [Range<Int>]
+
+    init(
+        state: QueryState,
+        batchSize: Int,
+        includesChunk: (borrowing Archetype, borrowing Chunk) -> Bool
+    ) {
+        precondition(batchSize > 0, "Batch size should be positive")
+
+        var ranges: [QueryChunkRange] = []
+        var jobs: [Range<Int>] = []
+        guard let world = state.world else {
+            self.ranges = ranges
+            self.jobs = jobs
+            return
+        }
+
+        var jobStart = 0
+        var jobEntityCount = 0
+        for archetypeIndex in state.archetypeIndecies {
+            let archetype = world.archetypes.archetypes[archetypeIndex]
+            let chunks = archetype.chunks.chunks
+            for chunkIndex in chunks.indices where includesChunk(archetype, chunks[chunkIndex]) {
+                var row = 0
+                let count = chunks[chunkIndex].count
+                while row < count {
+                    let rowCount = min(count - row, batchSize - jobEntityCount)
+                    ranges.append(
+                        QueryChunkRange(
+                            archetypeIndex: archetypeIndex,
+                            chunkIndex: chunkIndex,
+                            rows: row..<row + rowCount
+                        )
+                    )
+                    row += rowCount
+                    jobEntityCount += rowCount
+
+                    if jobEntityCount == batchSize {
+                        jobs.append(jobStart..<ranges.count)
+                        jobStart = ranges.count
+                        jobEntityCount = 0
+                    }
+                }
+            }
+        }
+
+        if jobStart < ranges.count {
+            jobs.append(jobStart..<ranges.count)
+        }
+
+        self.ranges = ranges
+        self.jobs = jobs
+    }
+}
+
+/// Distributes jobs between a fixed number of workers.
+///
+/// Each worker owns a contiguous segment of jobs and takes them from the front.
+/// A worker with an empty segment steals jobs from segments of other workers,
+/// so jobs with uneven cost don't leave workers idle.
+final class QueryJobQueues: Sendable {
+    private let cursors: [ManagedAtomic<Int>]
+    private let ends: [Int]
+
+    init(jobCount: Int, workerCount: Int) {
+        var cursors: [ManagedAtomic<Int>] = []
+        var ends: [Int] = []
+        for worker in 0..<workerCount {
+            cursors.append(ManagedAtomic(jobCount * worker / workerCount))
+            ends.append(jobCount * (worker + 1) / workerCount)
+        }
+        self.cursors = cursors
+        self.ends = ends
+    }
+
+    /// Returns index of the next job for the worker, nil if all jobs are taken.
+    func next(for worker: Int) -> Int? {
+        for offset in 0..<cursors.count {
+            let queue = (worker + offset) % cursors.count
+            // Skip drained segments without contention on their cursors.
+            guard cursors[queue].load(ordering: .relaxed) < ends[queue] else {
+                continue
+            }
+            let job = cursors[queue].loadThenWrappingIncrement(ordering: .relaxed)
+            if job < ends[queue] {
+                return job
+            }
+        }
+        return nil
+    }
 }
 
 /// A parallel query processor that iterates over chunks concurrently.
 ///
-/// Use this to process query results in parallel across multiple threads.
-/// The batch size determines how many chunks are processed in a single task.
+/// Entities are split into jobs of about `batchSize` entities, which run on a fixed number of workers.
+/// Workers reuse query fetches and scratch values between jobs and steal jobs from each other.
+/// Results of ``map(_:)``, ``compactMap(_:)`` and ``reduce(_:_:combine:)``
+/// are collected in the order of sequential iteration.
 ///
 /// ```swift
 /// // Process entities in parallel
-/// await query.parallel(batchSize: 4).forEach { position, velocity in
+/// await query.parallel().forEach { position, velocity in
 ///     // Process each entity concurrently
 ///     position.x += velocity.x
 /// }
@@ -35,233 +143,245 @@ public struct ParallelQueryResult<B: QuertyTargetBuilder, F: Filter>: Sendable {
     /// Create a new parallel query processor.
     /// - Parameters:
     ///   - state: The query state containing archetype indices and world reference
-    ///   - batchSize: Number of chunks to process per task (default: 4)
+    ///   - batchSize: Number of entities to process per job
     init(state: QueryState, batchSize: Int) {
         self.state = state
-        self.batchSize = batchSize
+        self.batchSize = max(batchSize, 1)
     }
 
-    /// Process each element in parallel using a TaskGroup.
+    /// Process each element in parallel.
     /// - Parameter operation: The operation to perform on each element
     @concurrent
     public func forEach(
         _ operation: @escaping @Sendable (Element) async throws -> Void
     ) async rethrows where Element: Sendable {
-        let batches = collectBatches()
-        let state = self.state
-
-        try await withThrowingTaskGroup(of: Void.self) { group in
-            for batch in batches {
-                group.addTask { [state] in
-                    try await Self.processBatch(batch, state: state, operation: operation)
-                }
+        _ = try await self.performJobs(
+            scratch: { () },
+            initialResult: { () },
+            { _, _, element in
+                try await operation(element)
             }
+        )
+    }
 
-            for try await _ in group { }
-        }
+    /// Process each element in parallel with a scratch value of the worker.
+    ///
+    /// The scratch value is created once for each worker and reused for all its elements,
+    /// for example to keep temporary buffers without allocations.
+    /// - Parameters:
+    ///   - makeScratch: Creates a scratch value of a worker.
+    ///   - operation: The operation to perform on each element
+    @concurrent
+    public func forEach<Scratch>(
+        scratch makeScratch: @escaping @Sendable () -> Scratch,
+        _ operation: @escaping @Sendable (inout Scratch, Element) async throws -> Void
+    ) async rethrows {
+        _ = try await self.performJobs(
+            scratch: makeScratch,
+            initialResult: { () },
+            { _, scratch, element in
+                try await operation(&scratch, element)
+            }
+        )
     }
 
     /// Map each element in parallel and collect results.
     /// - Parameter transform: The transformation to apply to each element
-    /// - Returns: Array of transformed results
+    /// - Returns: Array of transformed results in the order of sequential iteration
     @concurrent
     public func map<T: Sendable>(
         _ transform: @escaping @Sendable (Element) async throws -> T
     ) async rethrows -> [T] {
-        let batches = collectBatches()
-        let state = self.state
-
-        return try await withThrowingTaskGroup(of: [T].self) { group in
-            for batch in batches {
-                group.addTask { [state] in
-                    try await Self.mapBatch(batch, state: state, transform: transform)
-                }
+        let results = try await self.performJobs(
+            scratch: { () },
+            initialResult: { [T]() },
+            { results, _, element in
+                results.append(try await transform(element))
             }
-
-            var results: [T] = []
-            for try await batchResults in group {
-                results.append(contentsOf: batchResults)
-            }
-            return results
-        }
+        )
+        return Array(results.joined())
     }
 
-    /// Collect all chunks into batches for parallel processing.
-    @inline(__always)
-    private func collectBatches() -> [[ChunkInfo]] {
-        guard let world = state.world else {
-            return []
-        }
-
-        var allChunks: [ChunkInfo] = []
-
-        // Collect all chunks from all matching archetypes
-        for archetypeIndex in state.archetypeIndecies {
-            guard archetypeIndex < world.archetypes.archetypes.count else {
-                continue
+    /// Map each element in parallel and collect non-nil results.
+    /// - Parameter transform: The transformation to apply to each element
+    /// - Returns: Array of non-nil results in the order of sequential iteration
+    @concurrent
+    public func compactMap<T: Sendable>(
+        _ transform: @escaping @Sendable (Element) async throws -> T?
+    ) async rethrows -> [T] {
+        let results = try await self.performJobs(
+            scratch: { () },
+            initialResult: { [T]() },
+            { results, _, element in
+                if let result = try await transform(element) {
+                    results.append(result)
+                }
             }
+        )
+        return Array(results.joined())
+    }
 
-            let archetype = world.archetypes.archetypes[archetypeIndex]
-            for chunkIndex in 0..<archetype.chunks.chunks.count {
-                allChunks.append(ChunkInfo(
-                    archetypeIndex: archetypeIndex,
-                    chunkIndex: chunkIndex
-                ))
+    /// Reduce elements in parallel.
+    ///
+    /// Each job reduces its elements starting from `initialResult`,
+    /// then results of jobs are combined in the job order, so the result doesn't depend on scheduling.
+    /// - Parameters:
+    ///   - initialResult: The initial value of each job, usually the identity of `combine`.
+    ///   - updateAccumulatingResult: Updates a result of a job with an element.
+    ///   - combine: Combines results of two jobs.
+    /// - Returns: The combined result, `initialResult` if the query has no elements.
+    @concurrent
+    public func reduce<Result: Sendable>(
+        _ initialResult: Result,
+        _ updateAccumulatingResult: @escaping @Sendable (inout Result, Element) async throws -> Void,
+        combine: @escaping @Sendable (Result, Result) -> Result
+    ) async rethrows -> Result {
+        let results = try await self.performJobs(
+            scratch: { () },
+            initialResult: { initialResult },
+            { result, _, element in
+                try await updateAccumulatingResult(&result, element)
             }
+        )
+        guard var result = results.first else {
+            return initialResult
         }
-
-        // Split chunks into batches
-        return stride(from: 0, to: allChunks.count, by: batchSize).map { startIndex in
-            let endIndex = min(startIndex + batchSize, allChunks.count)
-            return Array(allChunks[startIndex..<endIndex])
+        for jobResult in results.dropFirst() {
+            result = combine(result, jobResult)
         }
+        return result
     }
 
-    /// Process a batch of chunks with the given operation.
+    /// Run all jobs and return their results in the job order.
     @concurrent
-    private static func processBatch(
-        _ batch: [ChunkInfo],
-        state: QueryState,
-        operation: @Sendable (Element) async throws -> Void
-    ) async rethrows {
-        guard let world = state.world else {
-            return
+    private func performJobs<JobResult: Sendable, Scratch>(
+        scratch makeScratch: @escaping @Sendable () -> Scratch,
+        initialResult: @escaping @Sendable () -> JobResult,
+        _ body: @escaping @Sendable (inout JobResult, inout Scratch, Element) async throws -> Void
+    ) async rethrows -> [JobResult] {
+        let state = self.state
+        let filterStates = Filter.initState(world: state.world)
+        var filterFetches = Filter.initFetches(world: state.world, states: filterStates, lastTick: state.lastTick)
+        // Chunks without rows passing change detection filters are skipped before splitting.
+        let jobs = QueryJobs(state: state, batchSize: batchSize) { archetype, chunk in
+            guard Filter.requiresRowEvaluation, chunk.count > 0 else {
+                return true
+            }
+            Filter.setChunk(states: filterStates, fetches: &filterFetches, chunk: chunk, archetype: archetype)
+            return Filter.chunkCondition(states: filterStates, fetches: filterFetches)
         }
-
-        let states = B.initState(world: world)
-        var fetches = B.initFetches(world: world, states: states, lastTick: world.lastTick)
-        let filterStates = Filter.initState(world: world)
-        var filterFetchs = Filter.initFetches(world: world, states: filterStates, lastTick: world.lastTick)
-
-        for chunkInfo in batch {
-            let archetypes = world.archetypes
-            guard chunkInfo.archetypeIndex < archetypes.archetypes.count else {
-                continue
+        let workerCount = min(ProcessInfo.processInfo.activeProcessorCount, jobs.jobs.count)
+
+        // A single worker doesn't need tasks.
+        guard workerCount > 1 else {
+            var worker = Worker(state: state, scratch: makeScratch())
+            var results: [JobResult] = []
+            results.reserveCapacity(jobs.jobs.count)
+            for job in jobs.jobs {
+                var result = initialResult()
+                try await worker.perform(jobs.ranges[job], result: &result, body)
+                results.append(result)
             }
+            return results
+        }
 
-            let archetype = archetypes.archetypes[chunkInfo.archetypeIndex]
-            guard chunkInfo.chunkIndex < archetype.chunks.chunks.count else {
-                continue
-            }
+        let queues = QueryJobQueues(jobCount: jobs.jobs.count, workerCount: workerCount)
 
-            let chunk = archetype.chunks.chunks[chunkInfo.chunkIndex]
-            B.setChunk(
-                states: states,
-                fetches: &fetches,
-                chunk: chunk,
-                archetype: archetype
-            )
-            Filter.setChunk(
-                states: filterStates,
-                fetches: &filterFetchs,
-                chunk: chunk,
-                archetype: archetype
-            )
-
-            // Iterate over all entities in this chunk
-            for row in 0..<chunk.count {
-                if Filter.requiresRowEvaluation {
-                    guard Filter.condition(
-                        states: filterStates,
-                        fetches: filterFetchs,
-                        at: row
-                    ) else {
-                        continue
+        return try await withThrowingTaskGroup(of: [(Int, JobResult)].self) { group in
+            for workerIndex in 0..<workerCount {
+                group.addTask { [state] in
+                    var worker = Worker(state: state, scratch: makeScratch())
+                    var results: [(Int, JobResult)] = []
+                    while let job = queues.next(for: workerIndex) {
+                        var result = initialResult()
+                        try await worker.perform(jobs.ranges[jobs.jobs[job]], result: &result, body)
+                        results.append((job, result))
                     }
+                    return results
                 }
+            }
 
-                let entityId = chunk.entities[row]
-                guard let location = state.entities.entities[entityId] else {
-                    continue
-                }
-
-                let entity = archetype.entities[location.archetypeRow]
-                if let element = B.getQueryTargets(
-                    for: entity,
-                    states: states,
-                    fetches: fetches,
-                    at: row
-                ) {
-                    try await operation(element)
+            var jobResults = [JobResult?](repeating: nil, count: jobs.jobs.count)
+            for try await workerResults in group {
+                for (job, result) in workerResults {
+                    jobResults[job] = result
                 }
             }
+            return jobResults.map { $0.unwrap(message: "Job wasn't performed") }
         }
     }
+}
 
-    /// Map a batch of chunks with the given transform.
-    @concurrent
-    private static func mapBatch<T: Sendable>(
-        _ batch: [ChunkInfo],
-        state: QueryState,
-        transform: @Sendable (Element) async throws -> T
-    ) async rethrows -> [T] {
-        guard let world = state.world else {
-            return []
+extension ParallelQueryResult {
+    /// Fetches and scratch value of a worker, reused between its jobs.
+    private struct Worker<Scratch> {
+        let state: QueryState
+        let states: B.ComponentsStates
+        var fetches: B.ComponentsFetches
+        let filterStates: Filter.ComponentsStates
+        var filterFetches: Filter.ComponentsFetches
+        var scratch: Scratch
+
+        init(state: QueryState, scratch: Scratch) {
+            let world: World = state.world
+            self.state = state
+            self.states = B.initState(world: world)
+            self.fetches = B.initFetches(world: world, states: self.states, lastTick: state.lastTick)
+            self.filterStates = Filter.initState(world: world)
+            self.filterFetches = Filter.initFetches(world: world, states: self.filterStates, lastTick: state.lastTick)
+            self.scratch = scratch
         }
 
-        let states = B.initState(world: world)
-        var fetches = B.initFetches(world: world, states: states, lastTick: world.lastTick)
-        let filterStates = Filter.initState(world: world)
-        var filterFetchs = Filter.initFetches(world: world, states: filterStates, lastTick: world.lastTick)
-
-        var results: [T] = []
-
-        for chunkInfo in batch {
-            let archetypes = world.archetypes
-            guard chunkInfo.archetypeIndex < archetypes.archetypes.count else {
-                continue
-            }
-
-            let archetype = archetypes.archetypes[chunkInfo.archetypeIndex]
-            guard chunkInfo.chunkIndex < archetype.chunks.chunks.count else {
-                continue
-            }
-
-            let chunk = archetype.chunks.chunks[chunkInfo.chunkIndex]
-            B.setChunk(
-                states: states,
-                fetches: &fetches,
-                chunk: chunk,
-                archetype: archetype
-            )
-            Filter.setChunk(
-                states: filterStates,
-                fetches: &filterFetchs,
-                chunk: chunk,
-                archetype: archetype
-            )
-
-            // Iterate over all entities in this chunk
-            for row in 0..<chunk.count {
-                let entityId = chunk.entities[row]
-                guard let location = state.entities.entities[entityId] else {
-                    continue
-                }
-
-                let entity = archetype.entities[location.archetypeRow]
+        /// Apply the body to elements of chunk ranges.
+        mutating func perform<JobResult>(
+            _ ranges: ArraySlice<QueryChunkRange>,
+            result: inout JobResult,
+            _ body: @Sendable (inout JobResult, inout Scratch, Element) async throws -> Void
+        ) async rethrows {
+            let archetypes = state.world.archetypes
+
+            for range in ranges {
+                let archetype = archetypes.archetypes[range.archetypeIndex]
+                let chunk = archetype.chunks.chunks[range.chunkIndex]
+                B.setChunk(
+                    states: states,
+                    fetches: &fetches,
+                    chunk: chunk,
+                    archetype: archetype
+                )
+                Filter.setChunk(
+                    states: filterStates,
+                    fetches: &filterFetches,
+                    chunk: chunk,
+                    archetype: archetype
+                )
+
+                for row in range.rows {
+                    if Filter.requiresRowEvaluation {
+                        guard Filter.condition(
+                            states: filterStates,
+                            fetches: filterFetches,
+                            at: row
+                        ) else {
+                            continue
+                        }
+                    }
 
-                if Filter.requiresRowEvaluation {
-                    guard Filter.condition(
-                        states: filterStates,
-                        fetches: filterFetchs,
-                        at: row
-                    ) else {
+                    guard let location = state.entities.entities[chunk.entities[row]] else {
                         continue
                     }
-                }
 
-                if let element = B.getQueryTargets(
-                    for: entity,
-                    states: states,
-                    fetches: fetches,
-                    at: row
-                ) {
-                    let result = try await transform(element)
-                    results.append(result)
+                    let entity = archetype.entities[location.archetypeRow]
+                    if let element = B.getQueryTargets(
+                        for: entity,
+                        states: states,
+                        fetches: fetches,
+                        at: row
+                    ) {
+                        try await body(&result, &scratch, element)
+                    }
                 }
             }
         }
-
-        return results
     }
 }
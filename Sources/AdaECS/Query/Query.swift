@@ -108,27 +108,27 @@ extension FilterQuery  {
     /// Returns a parallel query processor for concurrent iteration over chunks.
     ///
     /// Use this method to process query results in parallel across multiple threads.
-    /// The batch size determines how many chunks are grouped together in a single task,
-    /// which helps balance the workload across available CPU cores.
+    /// Entities are split into jobs of `batchSize` entities, which workers take from each other
+    /// to balance the workload across available CPU cores.
     ///
     /// ```swift
     /// // Process entities in parallel with custom batch size
-    /// await query.parallel(batchSize: 8).forEach { position, velocity in
+    /// await query.parallel(batchSize: 1024).forEach { position, velocity in
     ///     position.x += velocity.x * deltaTime
     ///     position.y += velocity.y * deltaTime
     /// }
     ///
-    /// // Map entities in parallel and collect results
+    /// // Map entities in parallel and collect results in the iteration order
     /// let distances = await query.parallel().map { position in
     ///     return sqrt(position.x * position.x + position.y * position.y)
     /// }
     /// ```
     ///
-    /// - Parameter batchSize: Number of chunks to process per task. Default is 4.
-    ///   Larger values reduce task overhead but may cause load imbalance.
-    ///   Smaller values provide better load distribution but increase task overhead.
+    /// - Parameter batchSize: Number of entities to process per job. Default is 256.
+    ///   Larger values reduce scheduling overhead but may cause load imbalance.
+    ///   Smaller values provide better load distribution but increase scheduling overhead.
     /// - Returns: A ``ParallelQueryResult`` instance for concurrent processing
-    public func parallel(batchSize: Int = 4) -> ParallelQueryResult<Builder, F> {
+    public func parallel(batchSize: Int = 256) -> ParallelQueryResult<Builder, F> {
         return ParallelQueryResult(state: self.state, batchSize: batchSize)
     }
 }
@@ -163,19 +163,46 @@ final class QueryState: @unchecked Sendable {
     @usableFromInline
     let filter: QueryFilter
 
+    /// The world of matched archetypes.
+    private var worldId: World.ID?
+
+    /// The archetypes generation of the last update.
+    private var archetypesGeneration: Int = 0
+
+    /// Count of archetypes evaluated by the predicate.
+    private var evaluatedArchetypeCount: Int = 0
+
     @usableFromInline
     internal init(predicate: QueryPredicate, filter: QueryFilter) {
         self.predicate = predicate
         self.filter = filter
     }
 
+    /// Match archetypes created since the last update.
+    ///
+    /// Archetypes are never removed and their layout doesn't change,
+    /// so matched indices stay valid and only new archetypes are evaluated.
     @usableFromInline
     func updateArchetypes(in world: World) {
-        self.entities = world.entities
-        self.archetypeIndecies.removeAll(keepingCapacity: true)
-        for (index, archetype) in world.archetypes.archetypes.enumerated() where self.predicate.evaluate(archetype) {
-            self.archetypeIndecies.append(index)
+        let archetypes = world.archetypes
+        if self.worldId != world.id {
+            self.worldId = world.id
+            self.archetypeIndecies.removeAll(keepingCapacity: true)
+            self.evaluatedArchetypeCount = 0
+            self.archetypesGeneration = archetypes.generation &- 1
         }
+
+        if self.archetypesGeneration != archetypes.generation {
+            let archetypeCount = archetypes.archetypes.count
+            for index in self.evaluatedArchetypeCount..<archetypeCount
+            where self.predicate.evaluate(archetypes.archetypes[index]) {
+                self.archetypeIndecies.append(index)
+            }
+            self.evaluatedArchetypeCount = archetypeCount
+            self.archetypesGeneration = archetypes.generation
+        }
+
+        self.entities = world.entities
         self.lastTick = world.lastTick
         self.world = world
     }
@@ -307,6 +334,14 @@ public struct FilterQueryIterator<
                     archetype: archetype
                 )
                 needsUpdateData = false
+
+                // Skip chunks without rows passing change detection filters.
+                if F.requiresRowEvaluation && !F.chunkCondition(states: filterStates, fetches: filterFetches) {
+                    cursor.currentChunkIndex += 1
+                    cursor.currentRow = 0
+                    needsUpdateData = true
+                    continue
+                }
             }
 
             let entityId = currentChunk.entities[cursor.currentRow]
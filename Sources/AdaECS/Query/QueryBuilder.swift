@@ -72,6 +72,12 @@ public protocol FilterTargetBuilder: QueryBuilder {
         fetches: ComponentsFetches,
         at row: Int
     ) -> Bool
+
+    /// Check if any row of the chunk set to the fetches can pass the filter.
+    static func chunkCondition(
+        states: ComponentsStates,
+        fetches: ComponentsFetches
+    ) -> Bool
 }
 
 @usableFromInline
@@ -205,4 +211,18 @@ extension QueryBuilderTargets: FilterTargetBuilder where repeat each T: Filter {
         }
         return true
     }
+
+    @inlinable
+    @inline(__always)
+    public static func chunkCondition(
+        states: ComponentsStates,
+        fetches: ComponentsFetches
+    ) -> Bool {
+        for (filter, state, fetch) in repeat ((each T).self, each states, each fetches) {
+            if !filter.chunkCondition(state: state, fetch: fetch) {
+                return false
+            }
+        }
+        return true
+    }
 }
@@ -52,6 +52,11 @@ public protocol Filter: Sendable, WorldQueryTarget {
         fetch: Fetch,
         at row: Int
     ) -> Bool
+
+    /// Check if the filter can match any row of the chunk set to the fetch.
+    /// Change detection filters use this to skip chunks without recent changes.
+    @inlinable
+    static func chunkCondition(state: State, fetch: Fetch) -> Bool
 }
 
 public extension Filter {
@@ -60,6 +65,11 @@ public extension Filter {
         true
     }
 
+    @inlinable
+    static func chunkCondition(state: State, fetch: Fetch) -> Bool {
+        true
+    }
+
     @inlinable
     static var requiresRowEvaluation: Bool {
         true
@@ -253,6 +263,16 @@ public struct And<each T: Filter>: Filter {
         }
         return true
     }
+
+    @inlinable
+    public static func chunkCondition(state: State, fetch: Fetch) -> Bool {
+        for (filter, state, fetch) in repeat ((each T).self, each state.states, each fetch.fetches) {
+            if !filter.chunkCondition(state: state, fetch: fetch) {
+                return false
+            }
+        }
+        return true
+    }
 }
 
 public struct Not<T: Filter>: Filter {
@@ -383,6 +403,16 @@ public struct Or<each T: Filter>: Filter {
         }
         return false
     }
+
+    @inlinable
+    public static func chunkCondition(state: State, fetch: Fetch) -> Bool {
+        for (filter, state, fetch) in repeat ((each T).self, each state.states, each fetch.fetches) {
+            if filter.chunkCondition(state: state, fetch: fetch) {
+                return true
+            }
+        }
+        return false
+    }
 }
 
 public struct Changed<T: Component>: Filter {
@@ -391,6 +421,8 @@ public struct Changed<T: Component>: Filter {
         @usableFromInline
         var ticks: UnsafeMutablePointer<Tick>?
         @usableFromInline
+        var lastChange: ChunkLastTick?
+        @usableFromInline
         var lastTick: Tick
         @usableFromInline
         var currentTick: Tick
@@ -398,10 +430,12 @@ public struct Changed<T: Component>: Filter {
         @usableFromInline
         init(
             ticks: UnsafeMutablePointer<Tick>? = nil,
+            lastChange: ChunkLastTick? = nil,
             lastTick: Tick,
             currentTick: Tick
         ) {
             unsafe self.ticks = ticks
+            self.lastChange = lastChange
             self.lastTick = lastTick
             self.currentTick = currentTick
         }
@@ -446,6 +480,7 @@ public struct Changed<T: Component>: Filter {
             return fetch
         }
         unsafe newFetch.ticks = slice.changed
+        newFetch.lastChange = slice.lastChanged
         return newFetch
     }
 
@@ -457,6 +492,15 @@ public struct Changed<T: Component>: Filter {
         }
         return tick.isNewerThan(lastTick: fetch.lastTick, currentTick: fetch.currentTick)
     }
+
+    /// Rows aren't newer than the most recent change of the chunk.
+    @inlinable
+    public static func chunkCondition(state: Void, fetch: ChangedFetch) -> Bool {
+        guard let lastChange = fetch.lastChange else {
+            return false
+        }
+        return lastChange.tick.isNewerThan(lastTick: fetch.lastTick, currentTick: fetch.currentTick)
+    }
 }
 
 public struct Added<T: Component>: Filter {
@@ -465,6 +509,8 @@ public struct Added<T: Component>: Filter {
         @usableFromInline
         var ticks: UnsafeMutablePointer<Tick>?
         @usableFromInline
+        var lastAdded: ChunkLastTick?
+        @usableFromInline
         var lastTick: Tick
         @usableFromInline
         var currentTick: Tick
@@ -472,10 +518,12 @@ public struct Added<T: Component>: Filter {
         @usableFromInline
         init(
             ticks: UnsafeMutablePointer<Tick>? = nil,
+            lastAdded: ChunkLastTick? = nil,
             lastTick: Tick,
             currentTick: Tick
         ) {
             unsafe self.ticks = ticks
+            self.lastAdded = lastAdded
             self.lastTick = lastTick
             self.currentTick = currentTick
         }
@@ -520,6 +568,7 @@ public struct Added<T: Component>: Filter {
             return fetch
         }
         unsafe newFetch.ticks = slice.added
+        newFetch.lastAdded = slice.lastAdded
         return newFetch
     }
 
@@ -531,6 +580,15 @@ public struct Added<T: Component>: Filter {
         }
         return tick == fetch.lastTick
     }
+
+    /// Rows can't be added at the last tick if the most recent added tick of the chunk is older.
+    @inlinable
+    public static func chunkCondition(state: Void, fetch: AddedFetch) -> Bool {
+        guard let lastAdded = fetch.lastAdded else {
+            return false
+        }
+        return lastAdded.tick >= fetch.lastTick
+    }
 }
 
 /// A filter that includes all entities.
@@ -133,6 +133,9 @@ public struct RefFetch<T> {
     @usableFromInline
     var change: UnsafeMutableBufferPointer<Tick>?
 
+    @usableFromInline
+    var lastChange: ChunkLastTick?
+
     @usableFromInline
     var lastTick: Tick
     @usableFromInline
@@ -143,12 +146,14 @@ public struct RefFetch<T> {
         data: UnsafeMutableBufferPointer<T>?,
         added: UnsafeMutableBufferPointer<Tick>?,
         change: UnsafeMutableBufferPointer<Tick>?,
+        lastChange: ChunkLastTick? = nil,
         lastTick: Tick,
         currentTick: Tick
     ) {
         unsafe self.data = data
         unsafe self.added = added
         unsafe self.change = change
+        self.lastChange = lastChange
         self.lastTick = lastTick
         self.currentTick = currentTick
     }
@@ -221,6 +226,7 @@ extension Ref: QueryTarget where T: Component {
             start: ticks.changed,
             count: chunk.count
         )
+        newFetch.lastChange = ticks.lastChanged
         return newFetch
     }
 
@@ -235,6 +241,7 @@ extension Ref: QueryTarget where T: Component {
             changeTick: ChangeDetectionTick(
                 added: fetch.added?.baseAddress?.advanced(by: row).unsafeBox(),
                 change: fetch.change?.baseAddress?.advanced(by: row).unsafeBox(),
+                lastChange: fetch.lastChange,
                 lastTick: fetch.lastTick,
                 currentTick: fetch.currentTick
             )
@@ -172,10 +172,15 @@ public struct FixedTime: Resource {
     /// The delta time.
     public let deltaTime: AdaUtils.TimeInterval
 
+    /// Part of the fixed step accumulated since the last fixed tick, in range `0..<1`.
+    public let overstepFraction: Float
+
     /// Initialize a new delta time.
     /// - Parameter deltaTime: The delta time.
-    public init(deltaTime: AdaUtils.TimeInterval) {
+    /// - Parameter overstepFraction: Part of the fixed step accumulated since the last fixed tick.
+    public init(deltaTime: AdaUtils.TimeInterval, overstepFraction: Float = 0) {
         self.deltaTime = deltaTime
+        self.overstepFraction = overstepFraction
     }
 }
 
@@ -4,40 +4,74 @@
 //
 
 import AdaUtils
+import BitCollections
 import DequeModule
 
 /// Executes dependency-ready, non-conflicting systems concurrently.
 ///
 /// The executor follows core scheduling rule: systems may run together
-/// when their declared accesses are compatible. Any system that records
-/// deferred commands causes a world flush after its current batch completes.
+/// when their declared accesses are compatible. A system starts as soon as its
+/// dependencies have completed and no running system has conflicting access,
+/// without waiting for unrelated systems.
+///
+/// Systems that record deferred commands are an apply point: after one of them is started,
+/// no new system is started until all running systems complete, then commands are applied
+/// and the world is flushed.
 public struct MultiThreadedSystemsGraphExecutor: SystemsGraphExecutor {
 
-    private struct NodeMetadata: Sendable {
-        var dependencies: Set<String>
-        var access: SystemAccessSet
+    /// A system of the compiled graph, indexed by its position in the single-threaded order.
+    private struct CompiledNode: Sendable {
+        let node: SystemsGraph.Node
+        /// Count of systems that must complete before this system starts.
+        let dependencyCount: Int
+        /// Indices of systems that depend on this system.
+        let dependents: [Int]
+        /// Indices of systems with incompatible access.
+        let conflicts: BitSet
+        let hasDeferredWorldAccess: Bool
     }
 
-    private var nodeOrder: [String] = []
-    private var metadataByNode: [String: NodeMetadata] = [:]
+    private var nodes: [CompiledNode] = []
 
     /// Initialize a new multi-threaded systems graph executor.
     public init() {}
 
     public mutating func initialize(_ graph: borrowing SystemsGraph) {
-        nodeOrder = makeSingleThreadedNodeOrder(from: graph)
-        metadataByNode = Dictionary(
-            uniqueKeysWithValues: graph.nodes.map { node in
-                let dependencies = Set(graph.getInputNodes(for: node.name).map(\.name))
-                return (
-                    node.name,
-                    NodeMetadata(
-                        dependencies: dependencies,
-                        access: node.queries.access
-                    )
-                )
+        let graphNodes = makeSingleThreadedNodeOrder(from: graph).compactMap { graph.nodes[$0] }
+        var indexByName: [String: Int] = [:]
+        for (index, node) in graphNodes.enumerated() {
+            indexByName[node.name] = index
+        }
+
+        let accesses = graphNodes.map(\.queries.access)
+        var dependencyCounts = [Int](repeating: 0, count: graphNodes.count)
+        var dependents = [[Int]](repeating: [], count: graphNodes.count)
+        var conflicts = [BitSet](repeating: BitSet(), count: graphNodes.count)
+
+        for (index, node) in graphNodes.enumerated() {
+            for inputNode in graph.getInputNodes(for: node.name) {
+                guard let inputIndex = indexByName[inputNode.name] else {
+                    continue
+                }
+                dependencyCounts[index] += 1
+                dependents[inputIndex].append(index)
             }
-        )
+
+            for otherIndex in 0..<index where !accesses[index].isCompatible(with: accesses[otherIndex]) {
+                conflicts[index].insert(otherIndex)
+                conflicts[otherIndex].insert(index)
+            }
+        }
+
+        self.nodes = graphNodes.indices.map { index in
+            CompiledNode(
+                node: graphNodes[index],
+                dependencyCount: dependencyCounts[index],
+                dependents: dependents[index],
+                conflicts: conflicts[index],
+                hasDeferredWorldAccess: accesses[index].hasDeferredWorldAccess
+            )
+        }
     }
 
     public mutating func execute(
@@ -45,72 +79,94 @@ public struct MultiThreadedSystemsGraphExecutor: SystemsGraphExecutor {
         world: World,
         scheduler: SchedulerName
     ) async {
-        if nodeOrder.isEmpty && !graph.nodes.isEmpty {
+        if nodes.isEmpty && !graph.nodes.isEmpty {
             initialize(graph)
         }
 
-        var completedSystems: Set<String> = []
-
-        while completedSystems.count < nodeOrder.count {
-            let batch = makeReadyBatch(
-                from: graph,
-                completedSystems: completedSystems
-            )
-
-            if batch.isEmpty {
-                assertionFailure("[SystemsGraph] Unable to find ready systems. Check dependency cycles.")
-                return
+        let nodes = self.nodes
+        let completedCount = await withTaskGroup(of: Int.self, returning: Int.self) { group in
+            // Only this task starts and completes systems, so counters don't need synchronization.
+            var remainingDependencies = nodes.map(\.dependencyCount)
+            var readySystems = BitSet()
+            var runningSystems = BitSet()
+            var pendingApplySystems: [Int] = []
+            var isApplyPending = false
+            var completedCount = 0
+
+            for index in nodes.indices where remainingDependencies[index] == 0 {
+                readySystems.insert(index)
             }
 
-            await withTaskGroup(of: Void.self) { group in
-                for node in batch {
-                    group.addTask {
-                        await executeSystem(
-                            system: node,
-                            world: world,
-                            scheduler: scheduler
-                        )
+            while true {
+                if !isApplyPending {
+                    // Ready systems are visited in the single-threaded order. A skipped system
+                    // blocks later conflicting systems, so they keep that order.
+                    var skippedSystems = BitSet()
+                    for index in readySystems {
+                        let conflicts = nodes[index].conflicts
+                        guard conflicts.isDisjoint(with: runningSystems),
+                              conflicts.isDisjoint(with: skippedSystems)
+                        else {
+                            skippedSystems.insert(index)
+                            continue
+                        }
+
+                        readySystems.remove(index)
+                        runningSystems.insert(index)
+                        isApplyPending = isApplyPending || nodes[index].hasDeferredWorldAccess
+
+                        let node = nodes[index].node
+                        group.addTask {
+                            await executeSystem(
+                                system: node,
+                                world: world,
+                                scheduler: scheduler
+                            )
+                            return index
+                        }
                     }
                 }
-            }
 
-            var shouldFlushDeferredCommands = false
-            for node in batch {
-                await node.queries.finish(world)
-                completedSystems.insert(node.name)
-                shouldFlushDeferredCommands = shouldFlushDeferredCommands
-                    || (metadataByNode[node.name]?.access.hasDeferredWorldAccess == true)
-            }
+                guard let index = await group.next() else {
+                    break
+                }
 
-            if shouldFlushDeferredCommands {
-                world.flush()
-            }
-        }
+                runningSystems.remove(index)
+                completedCount += 1
 
-        world.flush()
-    }
+                if nodes[index].hasDeferredWorldAccess {
+                    pendingApplySystems.append(index)
+                } else {
+                    await nodes[index].node.queries.finish(world)
+                }
 
-    private func makeReadyBatch(
-        from graph: borrowing SystemsGraph,
-        completedSystems: Set<String>
-    ) -> [SystemsGraph.Node] {
-        var batch: [SystemsGraph.Node] = []
-        var batchAccess: [SystemAccessSet] = []
-
-        for nodeName in nodeOrder where !completedSystems.contains(nodeName) {
-            guard let metadata = metadataByNode[nodeName],
-                  metadata.dependencies.isSubset(of: completedSystems),
-                  batchAccess.allSatisfy({ $0.isCompatible(with: metadata.access) }),
-                  let node = graph.nodes[nodeName]
-            else {
-                continue
+                for dependent in nodes[index].dependents {
+                    remainingDependencies[dependent] -= 1
+                    if remainingDependencies[dependent] == 0 {
+                        readySystems.insert(dependent)
+                    }
+                }
+
+                if isApplyPending && runningSystems.isEmpty {
+                    pendingApplySystems.sort()
+                    for pendingIndex in pendingApplySystems {
+                        await nodes[pendingIndex].node.queries.finish(world)
+                    }
+                    pendingApplySystems.removeAll(keepingCapacity: true)
+                    world.flush()
+                    isApplyPending = false
+                }
             }
 
-            batch.append(node)
-            batchAccess.append(metadata.access)
+            return completedCount
+        }
+
+        if completedCount < nodes.count {
+            assertionFailure("[SystemsGraph] Unable to find ready systems. Check dependency cycles.")
+            return
         }
 
-        return batch
+        world.flush()
     }
 
     private func makeSingleThreadedNodeOrder(from graph: borrowing SystemsGraph) -> [String] {
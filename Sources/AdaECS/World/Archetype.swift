@@ -46,12 +46,37 @@ public final class Entities: @unchecked Sendable {
         entity.components.entity = newId
     }
 
+    /// Allocate new ids after the id, used when entities are inserted with ids they already have.
+    func reserveIds(upTo id: Entity.ID) {
+        var current = currentId.load(ordering: .relaxed)
+        while current <= id {
+            let (exchanged, original) = currentId.weakCompareExchange(
+                expected: current,
+                desired: id + 1,
+                ordering: .relaxed
+            )
+            if exchanged {
+                return
+            }
+            current = original
+        }
+    }
+
     func insert(_ location: EntityLocation, for entity: Entity.ID) {
         lock.sync {
             entities[entity] = location
         }
     }
 
+    /// Insert locations of several entities under one lock.
+    func insert(_ locations: some Sequence<(Entity.ID, EntityLocation)>) {
+        lock.sync {
+            for (entity, location) in locations {
+                entities[entity] = location
+            }
+        }
+    }
+
     func remove(_ entity: Entity.ID) {
         lock.sync {
             entities.remove(for: entity)
@@ -70,6 +95,12 @@ public final class Archetypes: @unchecked Sendable {
     public var componentsIndex: [ComponentMaskSet: Archetype.ID]
     public var archetypes: ContiguousArray<Archetype>
 
+    /// Incremented when a new archetype is created.
+    ///
+    /// Archetypes are never removed, so queries compare it with the last seen value
+    /// and match only archetypes created after it.
+    public private(set) var generation: Int = 0
+
     public init(
         componentsIndex: [ComponentMaskSet: Archetype.ID] = [:],
         archetypes: ContiguousArray<Archetype> = []
@@ -88,6 +119,7 @@ public final class Archetypes: @unchecked Sendable {
         let archetype = Archetype.new(index: newIndex, componentLayout: componentLayout)
         self.archetypes.append(archetype)
         componentsIndex[componentLayout.maskSet] = newIndex
+        self.generation += 1
         return newIndex
     }
 
@@ -221,6 +253,16 @@ public extension Archetype {
         return self.entities.count - 1
     }
 
+    /// Append entities to the archetype.
+    /// - Parameter entities: The entities to append.
+    /// - Returns: The row of the first entity.
+    @inline(__always)
+    mutating func append(contentsOf entities: [Entity]) -> Int {
+        let row = self.entities.count
+        self.entities.append(contentsOf: entities)
+        return row
+    }
+
     /// Remove an entity from the archetype.
     /// - Parameter index: The index of the entity to remove.
     @discardableResult
@@ -280,42 +322,52 @@ extension Archetype: CustomStringConvertible {
 }
 
 extension Archetype {
+    /// An archetype reached by adding or removing components.
+    @usableFromInline
+    struct Edge: Hashable, Sendable {
+        /// The archetype after the change.
+        let archetypeId: Archetype.ID
+
+        /// Columns of components kept by the change.
+        let columns: ChunkColumnMap
+    }
+
     /// The edges of the archetype.
     @usableFromInline
     struct Edges: Hashable, Sendable {
         /// The components to add.
-        private var add: [ComponentLayout: Archetype.ID] = [:]
+        private var add: [ComponentLayout: Edge] = [:]
 
         /// The components to remove.
-        private var remove: [ComponentLayout: Archetype.ID] = [:]
+        private var remove: [ComponentLayout: Edge] = [:]
 
         @inline(__always)
         mutating func addArchetypeAfterInsertion(
-            _ archetype: Archetype.ID,
+            _ edge: Edge,
             for layout: ComponentLayout
         ) {
-            self.add[layout] = archetype
+            self.add[layout] = edge
         }
 
         @inline(__always)
         mutating func addArchetypeAfterRemoval(
-            _ archetype: Archetype.ID,
+            _ edge: Edge,
             for layout: ComponentLayout
         ) {
-            self.remove[layout] = archetype
+            self.remove[layout] = edge
         }
 
         @inline(__always)
-        mutating func getArchetypeAfterInsertion(
+        func getArchetypeAfterInsertion(
             for layout: ComponentLayout
-        ) -> Archetype.ID? {
+        ) -> Edge? {
             self.add[layout]
         }
 
         @inline(__always)
-        mutating func getArchetypeAfterRemoval(
+        func getArchetypeAfterRemoval(
             for layout: ComponentLayout
-        ) -> Archetype.ID? {
+        ) -> Edge? {
             self.remove[layout]
         }
     }
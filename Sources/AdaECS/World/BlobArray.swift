@@ -103,6 +103,33 @@ public extension BlobArray {
             .initialize(to: element)
     }
 
+    /// Initialize `count` elements starting at the index with copies of the element.
+    func initialize<T>(repeating element: T, from index: Int, count: Int) {
+        unsafe self.getMutablePointer(at: index, as: T.self)
+            .initialize(repeating: element, count: count)
+    }
+
+    /// Raw bytes of `count` elements starting at the index.
+    func bytes(at index: Int, count: Int) -> UnsafeRawBufferPointer {
+        return unsafe UnsafeRawBufferPointer(
+            start: self.buffer.pointer.baseAddress!.advanced(by: index * self.layout.size),
+            count: count * self.layout.size
+        )
+    }
+
+    /// Initialize elements starting at the index with a bitwise copy of raw bytes.
+    /// - Note: Only valid for plain old data elements.
+    func initialize(at index: Int, bytes: UnsafeRawBufferPointer) {
+        precondition(bytes.count % self.layout.size == 0, "Bytes don't match the element layout")
+        precondition(index * self.layout.size + bytes.count <= self.buffer.pointer.count, "Bytes exceed the buffer")
+        guard let source = unsafe bytes.baseAddress else {
+            return
+        }
+        unsafe self.buffer.pointer.baseAddress!
+            .advanced(by: index * self.layout.size)
+            .copyMemory(from: source, byteCount: bytes.count)
+    }
+
     func getMutablePointer<T: ~Copyable>(at index: Int, as type: T.Type) -> UnsafeMutablePointer<T> {
     #if DEBUG
         precondition(
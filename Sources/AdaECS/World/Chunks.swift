@@ -6,6 +6,8 @@
 //
 
 import AdaUtils
+import Atomics
+import BitCollections
 import Foundation
 import OrderedCollections
 import Logging
@@ -22,6 +24,100 @@ public struct MoveEntityResult: Sendable {
     public let swappedEntity: Entity.ID?
 }
 
+/// Dense indices of component columns shared by chunks of two archetypes.
+///
+/// Computed once for an archetype edge, so moving an entity copies columns without looking up components.
+public struct ChunkColumnMap: Hashable, Sendable {
+    struct Column: Hashable, Sendable {
+        let source: Int
+        let destination: Int
+    }
+
+    /// Columns present in both chunks.
+    let columns: [Column]
+
+    /// Source columns missing in the destination.
+    let droppedColumns: [Int]
+
+    init(from source: Chunks, to destination: Chunks) {
+        // All chunks of an archetype have the same column order.
+        let destinationComponents = destination.chunks[0].componentsData
+        var columns: [Column] = []
+        var droppedColumns: [Int] = []
+        for (sourceIndex, component) in source.chunks[0].componentsData.values.enumerated() {
+            if let destinationIndex = destinationComponents.firstIndex(for: component.key) {
+                columns.append(Column(source: sourceIndex, destination: destinationIndex))
+            } else {
+                droppedColumns.append(sourceIndex)
+            }
+        }
+        self.columns = columns
+        self.droppedColumns = droppedColumns
+    }
+}
+
+/// The most recent tick written to ticks of a component column in a chunk.
+///
+/// Change detection filters compare it with the last run of a system to skip chunks without changes.
+@safe
+public struct ChunkLastTick: @unchecked Sendable {
+    @usableFromInline
+    let storage: UnsafeAtomic<Int>
+
+    init(storage: UnsafeAtomic<Int>) {
+        self.storage = storage
+    }
+
+    /// The most recent tick.
+    @inlinable
+    public var tick: Tick {
+        Tick(value: storage.load(ordering: .relaxed))
+    }
+
+    /// Replace the tick if the new one is more recent.
+    @inlinable
+    public func update(_ tick: Tick) {
+        var current = storage.load(ordering: .relaxed)
+        while tick.value > current {
+            let (exchanged, original) = storage.weakCompareExchange(
+                expected: current,
+                desired: tick.value,
+                ordering: .relaxed
+            )
+            if exchanged {
+                return
+            }
+            current = original
+        }
+    }
+
+    func reset() {
+        storage.store(0, ordering: .relaxed)
+    }
+}
+
+/// Owns last ticks of a component column, shared by copies of the column.
+final class ChunkColumnTicks: Sendable {
+    let added = ChunkLastTick(storage: .create(0))
+    let changed = ChunkLastTick(storage: .create(0))
+
+    /// Raise last ticks with ticks of a written row.
+    func update(added addedTick: Tick, changed changeTick: Tick) {
+        self.added.update(addedTick)
+        self.changed.update(changeTick)
+    }
+
+    func reset() {
+        self.added.reset()
+        self.changed.reset()
+    }
+
+    deinit {
+        self.added.storage.destroy()
+        self.changed.storage.destroy()
+    }
+}
+
 /// A chunk-based storage system for ECS components
 /// Provides memory-efficient, cache-friendly storage for entities and their components
 public struct Chunks: Sendable {
@@ -32,7 +128,11 @@ public struct Chunks: Sendable {
     /// Configuration for chunk storage
     public let entitiesPerChunk: Int
 
-    private var friedLocation: [ChunkLocation] = []
+    /// Indices of chunks that may have free rows, the last one is filled first.
+    private var freeChunkIndices: [Int] = [0]
+
+    /// Chunks stored in ``freeChunkIndices``.
+    private var freeChunkMask = BitSet([0])
     
     /// Location entity in chunk
     public private(set) var entities: SparseSet<Entity.ID, ChunkLocation> = [:]
@@ -51,16 +151,22 @@ public struct Chunks: Sendable {
 }
 
 public extension Chunks {
+    /// Returns index of a chunk with a free row, a new chunk is created if all chunks are full.
+    /// - Complexity: Amortized O(1).
     mutating func getFreeChunkIndex() -> Int {
-        if let firstLocation = friedLocation.popLast() {
-            return firstLocation.chunkIndex
-        } else if let possibleIndex = chunks.firstIndex(where: { !$0.isFull }) {
-            return possibleIndex
-        } else {
-            let chunk = Chunk(entitiesPerChunk: entitiesPerChunk, layout: componentLayout)
-            self.chunks.append(chunk)
-            return self.chunks.endIndex - 1
+        while let chunkIndex = freeChunkIndices.last {
+            if !chunks[chunkIndex].isFull {
+                return chunkIndex
+            }
+            freeChunkIndices.removeLast()
+            freeChunkMask.remove(chunkIndex)
         }
+
+        let chunk = Chunk(entitiesPerChunk: entitiesPerChunk, layout: componentLayout)
+        self.chunks.append(chunk)
+        let chunkIndex = self.chunks.endIndex - 1
+        self.markChunkFree(chunkIndex)
+        return chunkIndex
     }
 
     func insert<T: Component>(
@@ -92,75 +198,121 @@ public extension Chunks {
         tick: Tick
     ) -> ChunkLocation {
         let location = self.getFreeChunkIndex()
-        var chunk = self.chunks[location]
-        guard let entityLocation = chunk.addEntity(entity) else {
+        guard let entityLocation = self.chunks[location].addEntity(entity) else {
             fatalError("Failed to add entity \(entity) to chunk \(location)")
         }
-        chunk.insert(at: entityLocation, components: components, tick: tick)
+        self.chunks[location].insert(at: entityLocation, components: components, tick: tick)
         let chunkLocation = ChunkLocation(
             chunkIndex: location,
             entityRow: entityLocation
         )
         self.entities[entity] = chunkLocation
-        self.chunks[location] = chunk
         return chunkLocation
     }
 
+    /// Insert entities with components of the same types to contiguous rows of free chunks.
+    ///
+    /// Columns are resolved once from the first entity and components are written column by column.
+    /// - Returns: Locations of the entities in the same order.
+    @discardableResult
+    mutating func insertEntities(
+        _ entities: [Entity.ID],
+        components: [[any Component]],
+        tick: Tick
+    ) -> [ChunkLocation] {
+        guard let firstComponents = components.first else {
+            return []
+        }
+        precondition(entities.count == components.count, "Each entity should have components")
+
+        let columns = firstComponents.map { component in
+            self.chunks[0].componentsData.firstIndex(for: type(of: component).identifier)
+                .unwrap(message: "Passed not registred component")
+        }
+
+        return self.insertEntities(entities) { chunk, startRow, range in
+            chunk.insert(at: startRow, components: components[range], columns: columns, tick: tick)
+        }
+    }
+
+    /// Insert entities to contiguous rows of free chunks.
+    /// - Parameter initializeRows: Writes components of entities in the range to rows of the chunk
+    ///   starting at the row.
+    /// - Returns: Locations of the entities in the same order.
+    @discardableResult
+    mutating func insertEntities(
+        _ entities: [Entity.ID],
+        initializeRows: (_ chunk: Chunk, _ startRow: Chunk.RowIndex, _ range: Range<Int>) -> Void
+    ) -> [ChunkLocation] {
+        var locations: [ChunkLocation] = []
+        locations.reserveCapacity(entities.count)
+
+        var offset = 0
+        while offset < entities.count {
+            let chunkIndex = self.getFreeChunkIndex()
+            let rowCount = min(entitiesPerChunk - self.chunks[chunkIndex].count, entities.count - offset)
+            let range = offset..<offset + rowCount
+
+            let startRow = self.chunks[chunkIndex].addEntities(entities[range])
+            initializeRows(self.chunks[chunkIndex], startRow, range)
+            for (row, entity) in entities[range].enumerated() {
+                let location = ChunkLocation(chunkIndex: chunkIndex, entityRow: startRow + row)
+                self.entities[entity] = location
+                locations.append(location)
+            }
+            offset += rowCount
+        }
+
+        return locations
+    }
+
     @discardableResult
     mutating func removeEntity(_ entity: Entity.ID) -> MoveEntityResult? {
         guard let location = self.entities[entity] else {
             return nil
         }
-        var chunk = self.chunks[location.chunkIndex]
-        let swappedEntity = chunk.swapRemoveEntity(at: entity)
-        self.chunks[location.chunkIndex] = chunk
-        self.friedLocation.append(location)
+        let swappedEntity = self.swapRemoveEntity(entity)
         return MoveEntityResult(newLocation: location, swappedEntity: swappedEntity)
     }
 
     mutating func moveEntity(_ entity: Entity.ID, to chunks: inout Chunks) -> MoveEntityResult {
+        let columns = ChunkColumnMap(from: self, to: chunks)
+        return self.moveEntity(entity, to: &chunks, columns: columns)
+    }
+
+    /// Move an entity with its shared components to chunks of another archetype.
+    /// - Parameter columns: Columns of components shared by both chunks, usually stored on the archetype edge.
+    mutating func moveEntity(
+        _ entity: Entity.ID,
+        to chunks: inout Chunks,
+        columns: ChunkColumnMap
+    ) -> MoveEntityResult {
         guard let location = self.entities[entity] else {
             fatalError("Entity \(entity) not found in chunks")
         }
-        let oldChunk = self.chunks[location.chunkIndex]
         let newLocation = chunks.getFreeChunkIndex()
-        var chunk = chunks.chunks[newLocation]
-        let entityLocation = chunk.addEntity(entity)
+        let entityLocation = chunks.chunks[newLocation].addEntity(entity)
             .unwrap(message: "Can't add entity to chunk")
         let chunkLocation = ChunkLocation(
             chunkIndex: newLocation,
             entityRow: entityLocation
         )
         chunks.entities[entity] = chunkLocation
-        for component in chunks.componentLayout.components {
-            guard
-                let oldChunkComponent = oldChunk.componentsData[component.identifier],
-                var newChunkComponent = chunk.componentsData[component.identifier]
-            else {
-                continue
-            }
 
-            oldChunkComponent.data
-                .copyElement(
-                    to: &newChunkComponent.data,
-                    from: location.entityRow,
-                    to: chunkLocation.entityRow
-                )
-            oldChunkComponent.addedTicks
-                .copyElement(
-                    to: &newChunkComponent.addedTicks,
-                    from: location.entityRow,
-                    to: chunkLocation.entityRow
-                )
-            oldChunkComponent.changeTicks
-                .copyElement(
-                    to: &newChunkComponent.changeTicks,
-                    from: location.entityRow,
-                    to: chunkLocation.entityRow
-                )
-            chunk.componentsData[component.identifier] = newChunkComponent
-        }
-        chunks.chunks[newLocation] = chunk
+        let oldComponents = self.chunks[location.chunkIndex].componentsData.values
+        let newComponents = chunks.chunks[newLocation].componentsData.values
+        for column in columns.columns {
+            oldComponents[column.source].value.copyElement(
+                to: newComponents[column.destination].value,
+                from: location.entityRow,
+                to: chunkLocation.entityRow
+            )
+        }
+        // Components missing in the new chunk are dropped with the move.
+        for column in columns.droppedColumns {
+            oldComponents[column].value.data.remove(at: location.entityRow)
+        }
+
         // Don't deinitialize - data was copied to the new chunk (bitwise copy preserves references)
         let swappedEntity = self.swapRemoveEntity(entity, deinitialize: false)
         return MoveEntityResult(newLocation: chunkLocation, swappedEntity: swappedEntity)
@@ -172,24 +324,30 @@ public extension Chunks {
             return nil
         }
 
-        var chunk = self.chunks[location.chunkIndex]
-        let swappedEntityId = chunk.swapRemoveEntity(at: entity, deinitialize: deinitialize)
+        let swappedEntityId = self.chunks[location.chunkIndex].swapRemoveEntity(at: entity, deinitialize: deinitialize)
         self.entities.remove(for: entity)
 
         if let swappedEntityId = swappedEntityId {
             self.entities[swappedEntityId] = location
         }
-        self.chunks[location.chunkIndex] = chunk
+        self.markChunkFree(location.chunkIndex)
 
         return swappedEntityId
     }
 
+    private mutating func markChunkFree(_ chunkIndex: Int) {
+        if self.freeChunkMask.insert(chunkIndex).inserted {
+            self.freeChunkIndices.append(chunkIndex)
+        }
+    }
+
     mutating func clear() {
         for index in 0..<chunks.count {
             self.chunks[index].clear()
         }
         self.entities.removeAll()
-        self.friedLocation.removeAll()
+        self.freeChunkIndices = Array(self.chunks.indices.reversed())
+        self.freeChunkMask = BitSet(self.chunks.indices)
     }
 
     func getComponentSlices<T: Component>(for type: T.Type) -> [UnsafeBufferPointer<T>] {
@@ -224,6 +382,8 @@ public struct Chunk: Sendable {
         var data: BlobArray
         var addedTicks: BlobArray
         var changeTicks: BlobArray
+        /// The most recent ticks of all rows.
+        let lastTicks = ChunkColumnTicks()
         let componentType: any Component.Type
 
         init<T: Component>(capacity: Int, component: T.Type) {
@@ -239,6 +399,18 @@ public struct Chunk: Sendable {
             self.componentType = component
         }
 
+        /// Copy the component with its ticks to a row of another column.
+        func copyElement(to other: ComponentsData, from fromIndex: Int, to toIndex: Int) {
+            var other = other
+            self.data.copyElement(to: &other.data, from: fromIndex, to: toIndex)
+            self.addedTicks.copyElement(to: &other.addedTicks, from: fromIndex, to: toIndex)
+            self.changeTicks.copyElement(to: &other.changeTicks, from: fromIndex, to: toIndex)
+            other.lastTicks.update(
+                added: self.addedTicks.get(at: fromIndex, as: Tick.self),
+                changed: self.changeTicks.get(at: fromIndex, as: Tick.self)
+            )
+        }
+
         public var description: String {
             return """
             ComponentsData(
@@ -321,6 +493,25 @@ public struct Chunk: Sendable {
         return index
     }
 
+    /// Add entities to free rows of this chunk.
+    /// - Parameter entityIds: The entity identifiers to add, should fit in the chunk.
+    /// - Returns: The index of the first added entity.
+    mutating func addEntities(_ entityIds: ArraySlice<Entity.ID>) -> RowIndex {
+        precondition(count + entityIds.count <= entitiesPerChunk, "Chunk can't fit \(entityIds.count) entities")
+
+        let startIndex = currentIndex
+        if self.entities.count > startIndex {
+            self.entities.removeSubrange(startIndex...)
+        }
+        self.entities.append(contentsOf: entityIds)
+        for (offset, entityId) in entityIds.enumerated() {
+            entityIndices[entityId] = startIndex + offset
+        }
+        count += entityIds.count
+
+        return startIndex
+    }
+
     /// Remove an entity from this chunk
     /// - Parameter index: The index of the entity to remove
     mutating func removeEntity(at entityId: Entity.ID) {
@@ -332,6 +523,7 @@ public struct Chunk: Sendable {
             data.data.clear(entities.count)
             data.addedTicks.clear(entities.count)
             data.changeTicks.clear(entities.count)
+            data.lastTicks.reset()
         }
         self.entities.removeAll(keepingCapacity: true)
         self.entityIndices.removeAll(keepingCapacity: true)
@@ -404,7 +596,51 @@ public struct Chunk: Sendable {
             array.data.insert(component, at: entityIndex)
             array.addedTicks.insert(tick, at: entityIndex)
             array.changeTicks.insert(tick, at: entityIndex)
+            array.lastTicks.update(added: tick, changed: tick)
+        }
+    }
+
+    /// Write components of consecutive rows starting at the index.
+    /// - Parameter columns: Dense indices of ``componentsData`` for each component position.
+    func insert(
+        at startIndex: RowIndex,
+        components: ArraySlice<[any Component]>,
+        columns: [Int],
+        tick: Tick
+    ) {
+        let componentsData = self.componentsData.values
+        for (position, column) in columns.enumerated() {
+            let array = componentsData[column].value
+            for (offset, entityComponents) in components.enumerated() {
+                array.data.insert(entityComponents[position], at: startIndex + offset)
+            }
+            array.addedTicks.initialize(repeating: tick, from: startIndex, count: components.count)
+            array.changeTicks.initialize(repeating: tick, from: startIndex, count: components.count)
+            array.lastTicks.update(added: tick, changed: tick)
+        }
+    }
+
+    /// Copy raw bytes of consecutive rows to a column of plain old data components.
+    /// - Parameter column: Dense index of ``componentsData``.
+    func initialize(column: Int, at startIndex: RowIndex, bytes: UnsafeRawBufferPointer, tick: Tick) {
+        let array = self.componentsData.values[column].value
+        let count = bytes.count / array.data.layout.size
+        unsafe array.data.initialize(at: startIndex, bytes: bytes)
+        array.addedTicks.initialize(repeating: tick, from: startIndex, count: count)
+        array.changeTicks.initialize(repeating: tick, from: startIndex, count: count)
+        array.lastTicks.update(added: tick, changed: tick)
+    }
+
+    /// Write components of consecutive rows to a column.
+    /// - Parameter column: Dense index of ``componentsData``.
+    func initialize(column: Int, at startIndex: RowIndex, components: ArraySlice<any Component>, tick: Tick) {
+        let array = self.componentsData.values[column].value
+        for (offset, component) in components.enumerated() {
+            array.data.insert(component, at: startIndex + offset)
         }
+        array.addedTicks.initialize(repeating: tick, from: startIndex, count: components.count)
+        array.changeTicks.initialize(repeating: tick, from: startIndex, count: components.count)
+        array.lastTicks.update(added: tick, changed: tick)
     }
 
     @inline(__always)
@@ -476,6 +712,7 @@ public struct Chunk: Sendable {
             return
         }
         componentData.changeTicks.insert(lastTick, at: entityIndex)
+        componentData.lastTicks.changed.update(lastTick)
         componentData.data.insert(component, at: entityIndex)
     }
 
@@ -525,7 +762,9 @@ public struct Chunk: Sendable {
         }
         return unsafe ChangeMutableTickSlices(
             added: componentData.addedTicks.getMutablePointer(at: 0, as: Tick.self),
-            changed: componentData.changeTicks.getMutablePointer(at: 0, as: Tick.self)
+            changed: componentData.changeTicks.getMutablePointer(at: 0, as: Tick.self),
+            lastAdded: componentData.lastTicks.added,
+            lastChanged: componentData.lastTicks.changed
         )
     }
 }
@@ -540,6 +779,10 @@ public struct ChangeTickSlices {
 public struct ChangeMutableTickSlices {
     public let added: UnsafeMutablePointer<Tick>
     public let changed: UnsafeMutablePointer<Tick>
+    /// The most recent added tick of the chunk.
+    public let lastAdded: ChunkLastTick
+    /// The most recent change tick of the chunk, writes through ``changed`` should update it.
+    public let lastChanged: ChunkLastTick
 }
 
 extension Chunk: CustomStringConvertible {
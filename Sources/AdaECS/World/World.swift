@@ -523,6 +523,40 @@ public extension World {
         return entity
     }
 
+    /// Spawn entities with components of the same types.
+    ///
+    /// The archetype is resolved once and components are written to contiguous rows of its chunks.
+    /// - Parameter count: The number of entities to spawn.
+    /// - Parameter bundle: Returns components of the entity at the index.
+    /// - Returns: The spawned entities.
+    @discardableResult
+    func spawnBatch<T: ComponentsBundle>(
+        _ name: String = "",
+        count: Int,
+        bundle: (Int) -> T
+    ) -> [Entity] {
+        let entities = (0..<count).map { _ in self.entities.allocate(with: name) }
+        self.insertNewEntities(entities, components: (0..<count).map { bundle($0).components })
+        return entities
+    }
+
+    /// Spawn entities with components of the same types.
+    ///
+    /// The archetype is resolved once and components are written to contiguous rows of its chunks.
+    /// - Parameter count: The number of entities to spawn.
+    /// - Parameter components: Returns components of the entity at the index.
+    /// - Returns: The spawned entities.
+    @discardableResult
+    func spawnBatch(
+        _ name: String = "",
+        count: Int,
+        @ComponentsBuilder components: (Int) -> ComponentsBundle
+    ) -> [Entity] {
+        let entities = (0..<count).map { _ in self.entities.allocate(with: name) }
+        self.insertNewEntities(entities, components: (0..<count).map { components($0).components })
+        return entities
+    }
+
     func get<T: Component>(from entity: Entity.ID) -> T? {
         guard let location = self.entities.entities[entity] else {
             return nil
@@ -545,8 +579,8 @@ public extension World {
         }
 
         // We have component in archetype, just update
-        var archetype = self.archetypes.archetypes[location.archetypeId]
-        if archetype.componentLayout.maskSet.contains(T.identifier) {
+        let componentLayout = self.archetypes.archetypes[location.archetypeId].componentLayout
+        if componentLayout.maskSet.contains(T.identifier) {
             self.archetypes
                 .archetypes[location.archetypeId]
                 .chunks
@@ -556,7 +590,7 @@ public extension World {
         }
 
         // Prepare new layout
-        var newLayout = archetype.componentLayout
+        var newLayout = componentLayout
         newLayout.insert(T.self)
 
         var components: [any Component] = []
@@ -578,20 +612,19 @@ public extension World {
         }
 
         // Move entity to new archetype
-        if let newArchetype = archetype.edges.getArchetypeAfterInsertion(for: newLayout) {
+        if let edge = self.archetypes.archetypes[location.archetypeId].edges.getArchetypeAfterInsertion(for: newLayout) {
             self.moveEntityToArchetype(
                 entityId,
                 oldLocation: location,
-                newArchetype: newArchetype
+                edge: edge
             )
         } else {
-            let newArchetype = self.archetypes.getOrCreate(for: newLayout)
-            archetype.edges.addArchetypeAfterInsertion(newArchetype, for: newLayout)
-            self.archetypes.archetypes[location.archetypeId] = archetype
+            let edge = self.makeArchetypeEdge(from: location.archetypeId, to: newLayout)
+            self.archetypes.archetypes[location.archetypeId].edges.addArchetypeAfterInsertion(edge, for: newLayout)
             self.moveEntityToArchetype(
                 entityId,
                 oldLocation: location,
-                newArchetype: newArchetype
+                edge: edge
             )
         }
 
@@ -614,6 +647,58 @@ public extension World {
             .insert(component, for: entityId, lastTick: currentTick)
     }
 
+    /// Insert a component to each entity.
+    ///
+    /// The target archetype and required components are resolved once for entities of the same archetype.
+    /// - Parameter components: Pairs of an entity and its component.
+    func insertBatch<T: Component>(_ components: some Sequence<(Entity.ID, T)>) {
+        let tick = self.currentTick
+        var insertions: [Archetype.ID: ComponentInsertion] = [:]
+
+        for (entityId, component) in components {
+            guard let location = self.entities.entities[entityId] else {
+                continue
+            }
+
+            // We have component in archetype, just update
+            if self.archetypes.archetypes[location.archetypeId].componentLayout.maskSet.contains(T.identifier) {
+                self.archetypes
+                    .archetypes[location.archetypeId]
+                    .chunks
+                    .chunks[location.chunkIndex]
+                    .insert(component, at: location.chunkRow, lastTick: tick)
+                continue
+            }
+
+            let insertion: ComponentInsertion
+            if let cachedInsertion = insertions[location.archetypeId] {
+                insertion = cachedInsertion
+            } else {
+                insertion = self.makeComponentInsertion(of: T.self, to: location.archetypeId)
+                insertions[location.archetypeId] = insertion
+            }
+
+            self.moveEntityToArchetype(
+                entityId,
+                oldLocation: location,
+                edge: insertion.edge
+            )
+
+            guard let newLocation = self.entities.entities[entityId] else {
+                assertionFailure("Failed to insert component to entity")
+                continue
+            }
+
+            var newComponents = insertion.requiredComponents.map { $0() }
+            newComponents.append(component)
+            self.archetypes
+                .archetypes[newLocation.archetypeId]
+                .chunks
+                .chunks[newLocation.chunkIndex]
+                .insert(at: newLocation.chunkRow, components: newComponents, tick: tick)
+        }
+    }
+
     @inline(__always)
     func remove<T: Component>(_ component: consuming T, for entity: Entity.ID) {
         self.remove(T.identifier, from: entity)
@@ -639,23 +724,21 @@ public extension World {
         }
 
         // Get the entity from the archetype
-        var archetype = self.archetypes.archetypes[location.archetypeId]
-        var newLayout = archetype.chunks.componentLayout
+        var newLayout = self.archetypes.archetypes[location.archetypeId].chunks.componentLayout
         newLayout.remove(componentId)
-        if let newArchetype = archetype.edges.getArchetypeAfterRemoval(for: newLayout) {
+        if let edge = self.archetypes.archetypes[location.archetypeId].edges.getArchetypeAfterRemoval(for: newLayout) {
             self.moveEntityToArchetype(
                 entityId,
                 oldLocation: location,
-                newArchetype: newArchetype
+                edge: edge
             )
         } else {
-            let newArchetype = self.archetypes.getOrCreate(for: newLayout)
-            archetype.edges.addArchetypeAfterRemoval(newArchetype, for: newLayout)
-            self.archetypes.archetypes[location.archetypeId] = archetype
+            let edge = self.makeArchetypeEdge(from: location.archetypeId, to: newLayout)
+            self.archetypes.archetypes[location.archetypeId].edges.addArchetypeAfterRemoval(edge, for: newLayout)
             self.moveEntityToArchetype(
                 entityId,
                 oldLocation: location,
-                newArchetype: newArchetype
+                edge: edge
             )
         }
         self.removedComponents[entityId, default: []].insert(componentId)
@@ -759,17 +842,16 @@ extension World {
             for: componentsLayout
         )
 
-        var archetype = self.archetypes.archetypes[archetypeIndex]
-        let row = archetype.append(entity)
-        let chunkLocation = archetype.chunks.insertEntity(
+        // Mutate in place, a copy of the archetype would copy its storage on write.
+        let row = self.archetypes.archetypes[archetypeIndex].append(entity)
+        let chunkLocation = self.archetypes.archetypes[archetypeIndex].chunks.insertEntity(
             entity.id,
             components: components,
             tick: self.currentTick
         )
-        self.archetypes.archetypes[archetypeIndex] = archetype
         self.entities.insert(
             EntityLocation(
-                archetypeId: archetype.id,
+                archetypeId: archetypeIndex,
                 archetypeRow: row,
                 chunkIndex: chunkLocation.chunkIndex,
                 chunkRow: chunkLocation.entityRow
@@ -781,18 +863,181 @@ extension World {
         eventManager.send(WorldEvents.DidAddEntity(entity: entity), source: self)
     }
 
+    /// Insert entities to the world. Expect, that entities are already stored in `Entities`.
+    ///
+    /// Required components and the archetype are resolved once from components of the first entity,
+    /// entities with components of other types are inserted one by one.
+    func insertNewEntities(_ entities: [Entity], components: [[any Component]]) {
+        precondition(entities.count == components.count, "Each entity should have components")
+        guard let firstComponents = components.first else {
+            return
+        }
+
+        let componentTypes = firstComponents.map { ObjectIdentifier(type(of: $0)) }
+        let requiredComponents = firstComponents.map { component in
+            var constructors: [() -> any Component] = []
+            for requiredComponent in componentsStorage.getRequiredComponents(for: component) {
+                constructors.append(requiredComponent.constructor)
+            }
+            for requiredComponent in type(of: component).requiredComponents.components {
+                constructors.append { requiredComponent.defaultValue }
+            }
+            return constructors
+        }
+
+        var batchEntities: [Entity] = []
+        var batchComponents: [[any Component]] = []
+        batchEntities.reserveCapacity(entities.count)
+        batchComponents.reserveCapacity(entities.count)
+
+        for (entity, entityComponents) in zip(entities, components) {
+            let hasSameTypes = entityComponents.count == componentTypes.count
+                && zip(entityComponents, componentTypes).allSatisfy { ObjectIdentifier(type(of: $0)) == $1 }
+            guard hasSameTypes else {
+                self.insertNewEntity(entity, components: entityComponents)
+                continue
+            }
+
+            var expandedComponents: [any Component] = []
+            for (component, constructors) in zip(entityComponents, requiredComponents) {
+                for constructor in constructors {
+                    expandedComponents.append(constructor())
+                }
+                expandedComponents.append(component)
+            }
+            batchEntities.append(entity)
+            batchComponents.append(expandedComponents)
+        }
+
+        guard let expandedComponents = batchComponents.first else {
+            return
+        }
+
+        let archetypeIndex = self.archetypes.getOrCreate(
+            for: ComponentLayout(components: expandedComponents)
+        )
+
+        // Mutate in place, a copy of the archetype would copy its storage on write.
+        let firstRow = self.archetypes.archetypes[archetypeIndex].append(contentsOf: batchEntities)
+        let chunkLocations = self.archetypes.archetypes[archetypeIndex].chunks.insertEntities(
+            batchEntities.map(\.id),
+            components: batchComponents,
+            tick: self.currentTick
+        )
+
+        self.didInsertEntities(
+            batchEntities,
+            archetypeIndex: archetypeIndex,
+            firstRow: firstRow,
+            chunkLocations: chunkLocations
+        )
+    }
+
+    /// Store locations of entities appended to the archetype and its chunks, and notify about them.
+    func didInsertEntities(
+        _ entities: [Entity],
+        archetypeIndex: Archetype.ID,
+        firstRow: Int,
+        chunkLocations: [ChunkLocation]
+    ) {
+        var locations: [(Entity.ID, EntityLocation)] = []
+        locations.reserveCapacity(entities.count)
+        for (index, chunkLocation) in chunkLocations.enumerated() {
+            locations.append((
+                entities[index].id,
+                EntityLocation(
+                    archetypeId: archetypeIndex,
+                    archetypeRow: firstRow + index,
+                    chunkIndex: chunkLocation.chunkIndex,
+                    chunkRow: chunkLocation.entityRow
+                )
+            ))
+        }
+        self.entities.insert(locations)
+
+        for entity in entities {
+            entity.world = self
+            addedEntities.insert(entity.id)
+            eventManager.send(WorldEvents.DidAddEntity(entity: entity), source: self)
+        }
+    }
+
+    /// Edge of a component insertion with constructors of required components missing in the archetype.
+    private struct ComponentInsertion {
+        let edge: Archetype.Edge
+        let requiredComponents: [() -> any Component]
+    }
+
+    /// Resolve the edge for inserting a component to the archetype.
+    private func makeComponentInsertion<T: Component>(
+        of componentType: T.Type,
+        to archetypeId: Archetype.ID
+    ) -> ComponentInsertion {
+        var newLayout = self.archetypes.archetypes[archetypeId].componentLayout
+        newLayout.insert(T.self)
+
+        var requiredComponents: [() -> any Component] = []
+        for requiredComponent in componentsStorage.getRequiredComponents(for: T.self) {
+            guard !newLayout.maskSet.contains(requiredComponent.id) else {
+                continue
+            }
+            requiredComponents.append(requiredComponent.constructor)
+            newLayout.insert(type(of: requiredComponent.constructor()))
+        }
+        for requiredComponent in T.requiredComponents.components {
+            guard !newLayout.maskSet.contains(requiredComponent.identifier) else {
+                continue
+            }
+            requiredComponents.append { requiredComponent.defaultValue }
+            newLayout.insert(requiredComponent)
+        }
+
+        if let edge = self.archetypes.archetypes[archetypeId].edges.getArchetypeAfterInsertion(for: newLayout) {
+            return ComponentInsertion(edge: edge, requiredComponents: requiredComponents)
+        }
+        let edge = self.makeArchetypeEdge(from: archetypeId, to: newLayout)
+        self.archetypes.archetypes[archetypeId].edges.addArchetypeAfterInsertion(edge, for: newLayout)
+        return ComponentInsertion(edge: edge, requiredComponents: requiredComponents)
+    }
+
+    /// Create an edge to the archetype with the layout.
+    private func makeArchetypeEdge(
+        from archetypeId: Archetype.ID,
+        to layout: ComponentLayout
+    ) -> Archetype.Edge {
+        let newArchetype = self.archetypes.getOrCreate(for: layout)
+        return Archetype.Edge(
+            archetypeId: newArchetype,
+            columns: ChunkColumnMap(
+                from: self.archetypes.archetypes[archetypeId].chunks,
+                to: self.archetypes.archetypes[newArchetype].chunks
+            )
+        )
+    }
+
     /// Move entity to new archetype.
     private func moveEntityToArchetype(
         _ entityId: Entity.ID,
         oldLocation location: EntityLocation,
-        newArchetype: Archetype.ID
+        edge: Archetype.Edge
     ) {
-        var archetype = self.archetypes.archetypes[location.archetypeId]
-        let entity = archetype.entities[location.archetypeRow]
-        var toArchetype = self.archetypes.archetypes[newArchetype]
-        let row = toArchetype.append(entity)
-        let result = archetype.swapRemove(at: location.archetypeRow)
-        let moveResult = archetype.chunks.moveEntity(entityId, to: &toArchetype.chunks)
+        let newArchetype = edge.archetypeId
+        guard newArchetype != location.archetypeId else {
+            return
+        }
+
+        // Both archetypes are mutated in place, a copy would copy their storage on write.
+        let (row, result, moveResult) = unsafe self.archetypes.archetypes.withUnsafeMutableBufferPointer { archetypes in
+            let entity = unsafe archetypes[location.archetypeId].entities[location.archetypeRow]
+            let row = unsafe archetypes[newArchetype].append(entity)
+            let result = unsafe archetypes[location.archetypeId].swapRemove(at: location.archetypeRow)
+            let moveResult = unsafe archetypes[location.archetypeId].chunks.moveEntity(
+                entityId,
+                to: &archetypes[newArchetype].chunks,
+                columns: edge.columns
+            )
+            return (row, result, moveResult)
+        }
         let newLocation = moveResult.newLocation
 
         var updatedLocations: [Entity.ID: EntityLocation] = [:]
@@ -833,8 +1078,6 @@ extension World {
             entities.insert(location, for: entity)
         }
 
-        self.archetypes.archetypes[location.archetypeId] = archetype
-        self.archetypes.archetypes[newArchetype] = toArchetype
         self.entities.insert(
             EntityLocation(
                 archetypeId: newArchetype,
@@ -854,8 +1097,7 @@ extension World {
         }
         self.entities.remove(entity)
 
-        var currentArchetype = self.archetypes.archetypes[record.archetypeId]
-        let removeResult = currentArchetype.swapRemove(at: record.archetypeRow)
+        let removeResult = self.archetypes.archetypes[record.archetypeId].swapRemove(at: record.archetypeRow)
 
         if
             let swappedEntity = removeResult.swappedEntity,
@@ -872,7 +1114,7 @@ extension World {
             )
         }
 
-        let removeChunkResult = currentArchetype.chunks.removeEntity(entity)
+        let removeChunkResult = self.archetypes.archetypes[record.archetypeId].chunks.removeEntity(entity)
         if let removeChunkResult, let swappedEntity = removeChunkResult.swappedEntity {
             if let swappedLocation = entities.entities[swappedEntity] {
                 entities.insert(
@@ -885,8 +1127,6 @@ extension World {
                 )
             }
         }
-
-        self.archetypes.archetypes[record.archetypeId] = currentArchetype
     }
 }
 
@@ -916,12 +1156,21 @@ private extension World {
 public struct ChangeDetectionTick: Sendable {
     public var added: UnsafeBox<Tick>?
     public var change: UnsafeBox<Tick>?
+    /// The most recent change tick of the chunk, updated with ``change``.
+    public var lastChange: ChunkLastTick?
     public let lastTick: Tick
     public let currentTick: Tick
 
-    public init(added: UnsafeBox<Tick>?, change: UnsafeBox<Tick>?, lastTick: Tick, currentTick: Tick) {
+    public init(
+        added: UnsafeBox<Tick>?,
+        change: UnsafeBox<Tick>?,
+        lastChange: ChunkLastTick? = nil,
+        lastTick: Tick,
+        currentTick: Tick
+    ) {
         self.added = added
         self.change = change
+        self.lastChange = lastChange
         self.lastTick = lastTick
         self.currentTick = currentTick
     }
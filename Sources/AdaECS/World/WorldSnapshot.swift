@@ -0,0 +1,373 @@
+//
+//  WorldSnapshot.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaUtils
+import Foundation
+import Logging
+
+/// A binary copy of entities and their components, used for fast scene loading, save games and rollback.
+///
+/// A snapshot stores component layouts of archetypes and their columns.
+/// Columns of plain old data components are stored as raw bytes and restored with one memory copy per chunk,
+/// other components are stored with `Codable`. Components without `Codable` conformance are skipped.
+///
+/// Components are found by name on restore, so they should be registered with ``Component/registerComponent()``.
+/// Raw bytes depend on the memory layout of components, so a snapshot should be restored by the same build of the app.
+/// - Note: Resources are not stored in a snapshot.
+public struct WorldSnapshot: Sendable {
+    /// Binary contents of the snapshot.
+    public let data: Data
+
+    /// Create a snapshot from binary contents.
+    public init(data: Data) {
+        self.data = data
+    }
+}
+
+/// Errors thrown when a snapshot can't be restored.
+public enum WorldSnapshotError: Error {
+    /// The data is not a snapshot or it is corrupted.
+    case invalidData
+    /// The snapshot was written with an unknown version of the format.
+    case unsupportedVersion(UInt32)
+    /// The memory layout of a plain old data component is different from the snapshot.
+    case layoutMismatch(String)
+}
+
+public extension World {
+    /// Write entities of the world to a binary snapshot.
+    func makeSnapshot() throws -> WorldSnapshot {
+        self.flush()
+
+        var writer = SnapshotWriter()
+        writer.write(WorldSnapshot.magic)
+        writer.write(WorldSnapshot.version)
+
+        let archetypes = self.archetypes.archetypes.filter { !$0.isEmpty }
+        writer.write(Int64(archetypes.count))
+        for archetype in archetypes {
+            try self.writeArchetype(archetype, to: &writer)
+        }
+
+        return WorldSnapshot(data: writer.data)
+    }
+
+    /// Replace entities of the world with entities of the snapshot.
+    ///
+    /// Entities keep their identifiers. Columns of plain old data components are copied to new chunks as is.
+    /// Restored components are marked as added and changed at the current tick.
+    /// - Throws: ``WorldSnapshotError`` or a decoding error. The world is not changed if the snapshot can't be read.
+    func restoreSnapshot(_ snapshot: WorldSnapshot) throws {
+        unsafe try snapshot.data.withUnsafeBytes { bytes in
+            var reader = unsafe SnapshotReader(bytes: bytes)
+            guard unsafe try reader.read(UInt32.self) == WorldSnapshot.magic else {
+                throw WorldSnapshotError.invalidData
+            }
+            let version = unsafe try reader.read(UInt32.self)
+            guard version == WorldSnapshot.version else {
+                throw WorldSnapshotError.unsupportedVersion(version)
+            }
+
+            let archetypeCount = unsafe try reader.readCount()
+            var records: [ArchetypeRecord] = unsafe []
+            for _ in 0..<archetypeCount {
+                let record = unsafe try Self.readArchetype(from: &reader)
+                unsafe records.append(record)
+            }
+
+            self.flush()
+            self.clear()
+            for record in unsafe records {
+                unsafe self.restoreArchetype(record)
+            }
+        }
+    }
+}
+
+// MARK: - Format
+
+extension WorldSnapshot {
+    /// `ADAS` in little endian.
+    static let magic: UInt32 = 0x53414441
+    static let version: UInt32 = 1
+
+    /// How component values of a column are stored.
+    enum ColumnCodec: UInt8 {
+        /// Raw bytes of the chunk column.
+        case raw = 0
+        /// JSON array of components.
+        case codable = 1
+    }
+}
+
+/// A column read from a snapshot, raw bytes point to the snapshot data.
+@unsafe
+private struct ColumnRecord {
+    enum Values {
+        case raw(UnsafeRawBufferPointer)
+        case components([any Component])
+    }
+
+    let componentType: any Component.Type
+    let values: Values
+}
+
+@unsafe
+private struct ArchetypeRecord {
+    let entities: [(id: Entity.ID, name: String)]
+    let columns: [ColumnRecord]
+}
+
+private extension World {
+    func writeArchetype(_ archetype: Archetype, to writer: inout SnapshotWriter) throws {
+        let chunks = archetype.chunks.chunks
+        let entityCount = chunks.reduce(0) { $0 + $1.count }
+
+        // All chunks of an archetype have the same column order.
+        var columns: [(index: Int, codec: WorldSnapshot.ColumnCodec, componentType: any Component.Type)] = []
+        for (index, column) in chunks[0].componentsData.values.enumerated() {
+            let componentType = column.value.componentType
+            if componentType.componentsInfo.isPlainOldData {
+                columns.append((index, .raw, componentType))
+            } else if componentType is any (Component & Codable).Type {
+                columns.append((index, .codable, componentType))
+            } else {
+                Logger(label: "org.adaengine.AdaECS.WorldSnapshot")
+                    .warning("Component \(componentType.swiftName) is not Codable and skipped in the snapshot")
+            }
+        }
+
+        writer.write(Int64(columns.count))
+        for column in columns {
+            let layout = chunks[0].componentsData.values[column.index].value.data.layout
+            writer.write(column.componentType.swiftName)
+            writer.write(column.codec.rawValue)
+            writer.write(Int64(layout.size))
+            writer.write(Int64(layout.alignment))
+        }
+
+        writer.write(Int64(entityCount))
+        for chunk in chunks {
+            for entityId in chunk.entities.prefix(chunk.count) {
+                let location = self.entities.entities[entityId]
+                    .unwrap(message: "Entity \(entityId) not found in the world")
+                writer.write(Int64(entityId))
+                writer.write(archetype.entities[location.archetypeRow].name)
+            }
+        }
+
+        for column in columns {
+            switch column.codec {
+            case .raw:
+                writer.write(Int64(entityCount * chunks[0].componentsData.values[column.index].value.data.layout.size))
+                for chunk in chunks where chunk.count > 0 {
+                    unsafe writer.write(chunk.componentsData.values[column.index].value.data.bytes(at: 0, count: chunk.count))
+                }
+            case .codable:
+                let componentType = column.componentType as! any (Component & Codable).Type
+                let data = try Self.encodeColumn(componentType, at: column.index, in: chunks)
+                writer.write(Int64(data.count))
+                unsafe data.withUnsafeBytes { unsafe writer.write($0) }
+            }
+        }
+    }
+
+    static func encodeColumn<T: Component & Codable>(
+        _ type: T.Type,
+        at column: Int,
+        in chunks: ContiguousArray<Chunk>
+    ) throws -> Data {
+        var components: [T] = []
+        for chunk in chunks {
+            let data = chunk.componentsData.values[column].value.data
+            for row in 0..<chunk.count {
+                components.append(data.get(at: row, as: T.self))
+            }
+        }
+        return try JSONEncoder().encode(components)
+    }
+
+    static func decodeColumn<T: Component & Codable>(_ type: T.Type, from data: Data) throws -> [any Component] {
+        return try JSONDecoder().decode([T].self, from: data)
+    }
+
+    static func readArchetype(from reader: inout SnapshotReader) throws -> ArchetypeRecord {
+        let columnCount = unsafe try reader.readCount()
+        var layouts: [(name: String, codec: WorldSnapshot.ColumnCodec, size: Int, alignment: Int)] = []
+        for _ in 0..<columnCount {
+            let name = unsafe try reader.readString()
+            let rawCodec = unsafe try reader.read(UInt8.self)
+            guard let codec = WorldSnapshot.ColumnCodec(rawValue: rawCodec) else {
+                throw WorldSnapshotError.invalidData
+            }
+            let size = unsafe try reader.readCount()
+            let alignment = unsafe try reader.readCount()
+            layouts.append((name, codec, size, alignment))
+        }
+
+        let entityCount = unsafe try reader.readCount()
+        var entities: [(id: Entity.ID, name: String)] = []
+        entities.reserveCapacity(entityCount)
+        for _ in 0..<entityCount {
+            let id = unsafe try reader.read(Int64.self)
+            let name = unsafe try reader.readString()
+            entities.append((Entity.ID(id), name))
+        }
+
+        var columns: [ColumnRecord] = unsafe []
+        for layout in layouts {
+            let byteCount = unsafe try reader.readCount()
+            let bytes = unsafe try reader.readBytes(count: byteCount)
+            guard let componentType = ComponentStorage.getRegisteredComponent(for: layout.name) else {
+                Logger(label: "org.adaengine.AdaECS.WorldSnapshot")
+                    .warning("Component \(layout.name) is not registered and skipped in the snapshot")
+                continue
+            }
+
+            switch layout.codec {
+            case .raw:
+                guard
+                    componentType.componentsInfo.isPlainOldData,
+                    componentType.memoryStride == layout.size,
+                    componentType.memoryAlignment == layout.alignment
+                else {
+                    throw WorldSnapshotError.layoutMismatch(layout.name)
+                }
+                guard unsafe bytes.count == entityCount * layout.size else {
+                    throw WorldSnapshotError.invalidData
+                }
+                unsafe columns.append(ColumnRecord(componentType: componentType, values: .raw(bytes)))
+            case .codable:
+                guard let codableType = componentType as? any (Component & Codable).Type else {
+                    throw WorldSnapshotError.layoutMismatch(layout.name)
+                }
+                let components = unsafe try Self.decodeColumn(codableType, from: Data(bytes))
+                guard components.count == entityCount else {
+                    throw WorldSnapshotError.invalidData
+                }
+                unsafe columns.append(ColumnRecord(componentType: componentType, values: .components(components)))
+            }
+        }
+
+        return unsafe ArchetypeRecord(entities: entities, columns: columns)
+    }
+
+    func restoreArchetype(_ record: ArchetypeRecord) {
+        let entities = unsafe record.entities.map { Entity(name: $0.name, id: $0.id) }
+        guard let maxId = entities.map(\.id).max() else {
+            return
+        }
+        self.entities.reserveIds(upTo: maxId)
+
+        let archetypeIndex = self.archetypes.getOrCreate(
+            for: ComponentLayout(componentTypes: unsafe record.columns.map(\.componentType))
+        )
+        let componentsData = self.archetypes.archetypes[archetypeIndex].chunks.chunks[0].componentsData
+        let chunkColumns = unsafe record.columns.map { column in
+            unsafe componentsData.firstIndex(for: column.componentType.identifier)
+                .unwrap(message: "Component not found in the archetype")
+        }
+        let tick = self.currentTick
+
+        // Mutate in place, a copy of the archetype would copy its storage on write.
+        let firstRow = self.archetypes.archetypes[archetypeIndex].append(contentsOf: entities)
+        let chunkLocations = self.archetypes.archetypes[archetypeIndex].chunks.insertEntities(
+            entities.map(\.id)
+        ) { chunk, startRow, range in
+            for (column, chunkColumn) in unsafe zip(record.columns, chunkColumns) {
+                switch unsafe column.values {
+                case .raw(let bytes):
+                    let size = unsafe bytes.count / record.entities.count
+                    unsafe chunk.initialize(
+                        column: chunkColumn,
+                        at: startRow,
+                        bytes: UnsafeRawBufferPointer(
+                            rebasing: bytes[range.lowerBound * size..<range.upperBound * size]
+                        ),
+                        tick: tick
+                    )
+                case .components(let components):
+                    chunk.initialize(column: chunkColumn, at: startRow, components: components[range], tick: tick)
+                }
+            }
+        }
+
+        self.didInsertEntities(
+            entities,
+            archetypeIndex: archetypeIndex,
+            firstRow: firstRow,
+            chunkLocations: chunkLocations
+        )
+    }
+}
+
+// MARK: - Binary IO
+
+private extension Component {
+    static var memoryStride: Int {
+        MemoryLayout<Self>.stride
+    }
+
+    static var memoryAlignment: Int {
+        MemoryLayout<Self>.alignment
+    }
+}
+
+/// Appends little endian values to data.
+private struct SnapshotWriter {
+    var data = Data()
+
+    mutating func write<T: FixedWidthInteger>(_ value: T) {
+        unsafe withUnsafeBytes(of: value.littleEndian) { bytes in
+            unsafe data.append(contentsOf: bytes)
+        }
+    }
+
+    mutating func write(_ string: String) {
+        let utf8 = Array(string.utf8)
+        self.write(Int64(utf8.count))
+        data.append(contentsOf: utf8)
+    }
+
+    mutating func write(_ bytes: UnsafeRawBufferPointer) {
+        unsafe data.append(contentsOf: bytes)
+    }
+}
+
+/// Reads little endian values written by ``SnapshotWriter``.
+@unsafe
+private struct SnapshotReader {
+    let bytes: UnsafeRawBufferPointer
+    var offset = 0
+
+    mutating func read<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+        let valueBytes = unsafe try self.readBytes(count: MemoryLayout<T>.size)
+        return T(littleEndian: unsafe valueBytes.loadUnaligned(as: T.self))
+    }
+
+    /// Read a non negative count.
+    mutating func readCount() throws -> Int {
+        let value = unsafe try self.read(Int64.self)
+        guard value >= 0, value <= Int64(unsafe bytes.count) else {
+            throw WorldSnapshotError.invalidData
+        }
+        return Int(value)
+    }
+
+    mutating func readString() throws -> String {
+        let count = unsafe try self.readCount()
+        return unsafe String(decoding: try self.readBytes(count: count), as: UTF8.self)
+    }
+
+    mutating func readBytes(count: Int) throws -> UnsafeRawBufferPointer {
+        guard unsafe count <= bytes.count - offset else {
+            throw WorldSnapshotError.invalidData
+        }
+        defer { unsafe offset += count }
+        return unsafe UnsafeRawBufferPointer(rebasing: bytes[offset..<offset + count])
+    }
+}
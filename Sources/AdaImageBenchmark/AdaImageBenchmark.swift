@@ -0,0 +1,268 @@
+//
+//  AdaImageBenchmark.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaRender
+import Foundation
+
+// PNG decode throughput over the asset corpus. Files are read to memory first,
+// so only `Image.decode(from:)` is measured. With `--service` files are read and decoded
+// by `ImageDecodeService` on all cores instead. Results are written to `png_decode.csv`.
+// Examples:
+// swift run -c release AdaImageBenchmark
+// swift run -c release AdaImageBenchmark --service --baseline ./baseline
+// swift run -c release AdaImageBenchmark --corpus Assets,Demos/Resources --runs 8 --baseline ./baseline --threshold 3
+
+struct ImageBenchmarkOptions {
+    var corpusDirectories = ["Assets", "Demos/Resources", "Sources/AdaEngine"].map {
+        URL(fileURLWithPath: $0, isDirectory: true)
+    }
+    var runCount = 4
+    var usesDecodeService = false
+    var outputDirectory = URL(fileURLWithPath: FileManager.default.currentDirectoryPath, isDirectory: true)
+    var baselineDirectory: URL?
+    /// Allowed slowdown in percents.
+    var threshold: Double = 5
+
+    static let usage = """
+        AdaImageBenchmark [options]
+        --corpus <path,...>: directories searched for PNG files (default is Assets,Demos/Resources,Sources/AdaEngine)
+        --runs <integer>: number of repeats, the best time is reported (default is 4)
+        --service: read and decode files with ImageDecodeService on all cores
+        --output <path>: directory for the CSV file (default is current directory)
+        --baseline <path>: directory with the CSV file to compare with
+        --threshold <percent>: slowdown reported as regression (default is 5)
+        """
+
+    init(arguments: [String]) throws {
+        var iterator = arguments.makeIterator()
+
+        func value(for option: String) throws -> String {
+            guard let value = iterator.next() else {
+                throw ImageBenchmarkError.usage("Missing value for \(option)\n\(Self.usage)")
+            }
+            return value
+        }
+
+        while let argument = iterator.next() {
+            switch argument {
+            case "--corpus":
+                self.corpusDirectories = try value(for: argument).split(separator: ",").map {
+                    URL(fileURLWithPath: String($0), isDirectory: true)
+                }
+            case "--runs":
+                guard let runCount = Int(try value(for: argument)), runCount > 0 else {
+                    throw ImageBenchmarkError.usage("Expected a positive integer for \(argument)\n\(Self.usage)")
+                }
+                self.runCount = min(runCount, 1000)
+            case "--service":
+                self.usesDecodeService = true
+            case "--output":
+                self.outputDirectory = URL(fileURLWithPath: try value(for: argument), isDirectory: true)
+            case "--baseline":
+                self.baselineDirectory = URL(fileURLWithPath: try value(for: argument), isDirectory: true)
+            case "--threshold":
+                guard let threshold = Double(try value(for: argument)), threshold >= 0 else {
+                    throw ImageBenchmarkError.usage("Expected a non negative number for \(argument)\n\(Self.usage)")
+                }
+                self.threshold = threshold
+            case "-h", "--help":
+                print(Self.usage)
+                exit(0)
+            default:
+                throw ImageBenchmarkError.usage("Unknown option \(argument)\n\(Self.usage)")
+            }
+        }
+    }
+}
+
+/// Best decode time of the corpus, stored as `png_decode.csv`.
+struct ImageDecodeResult {
+    static let fileName = "png_decode.csv"
+
+    let imageCount: Int
+    /// Size of decoded RGBA pixels.
+    let decodedBytes: Int
+    let milliseconds: Double
+
+    var megabytesPerSecond: Double {
+        return Double(self.decodedBytes) / 1_000_000 / (self.milliseconds / 1000)
+    }
+
+    func write(to directory: URL) throws {
+        let csv = "images,bytes,ms\n\(self.imageCount),\(self.decodedBytes),\(self.milliseconds)\n"
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        try csv.write(to: directory.appendingPathComponent(Self.fileName), atomically: true, encoding: .utf8)
+    }
+
+    /// Read a result from the directory, nil if the directory has no file.
+    static func read(from directory: URL) throws -> ImageDecodeResult? {
+        let url = directory.appendingPathComponent(Self.fileName)
+        guard FileManager.default.fileExists(atPath: url.path) else {
+            return nil
+        }
+
+        let lines = try String(contentsOf: url, encoding: .utf8).split(whereSeparator: \.isNewline)
+        guard
+            lines.count == 2,
+            lines[0] == "images,bytes,ms"
+        else {
+            throw ImageBenchmarkError.invalidBaseline(url)
+        }
+
+        let columns = lines[1].split(separator: ",")
+        guard
+            columns.count == 3,
+            let imageCount = Int(columns[0]),
+            let decodedBytes = Int(columns[1]),
+            let milliseconds = Double(columns[2]),
+            milliseconds > 0
+        else {
+            throw ImageBenchmarkError.invalidBaseline(url)
+        }
+
+        return ImageDecodeResult(imageCount: imageCount, decodedBytes: decodedBytes, milliseconds: milliseconds)
+    }
+}
+
+enum ImageBenchmarkError: LocalizedError {
+    case usage(String)
+    case emptyCorpus
+    case invalidBaseline(URL)
+
+    var errorDescription: String? {
+        switch self {
+        case .usage(let s):
+            return s
+        case .emptyCorpus:
+            return "No PNG files found in the corpus directories"
+        case .invalidBaseline(let u):
+            return "Invalid baseline CSV: \(u.path)"
+        }
+    }
+}
+
+@main
+enum AdaImageBenchmark {
+    static func main() async throws {
+        let options = try ImageBenchmarkOptions(arguments: Array(CommandLine.arguments.dropFirst()))
+
+        #if DEBUG
+        print("Debug build, timings are not representative. Use `swift run -c release`.")
+        #endif
+
+        let urls = self.corpusURLs(options.corpusDirectories)
+        guard !urls.isEmpty else {
+            throw ImageBenchmarkError.emptyCorpus
+        }
+        let files: [Data] = try options.usesDecodeService ? [] : urls.map { try Data(contentsOf: $0) }
+        let service = ImageDecodeService()
+
+        print("Starting PNG decode benchmark")
+        print("======================================")
+        if options.usesDecodeService {
+            print("images: \(urls.count), workers: \(service.maxConcurrentDecodes)")
+        } else {
+            print("images: \(urls.count), encoded: \(files.reduce(0) { $0 + $1.count }) bytes")
+        }
+
+        var best: ImageDecodeResult?
+        let clock = ContinuousClock()
+        for runIndex in 0..<options.runCount {
+            var decodedBytes = 0
+            var failedCount = 0
+            let duration: Duration
+            if options.usesDecodeService {
+                duration = await clock.measure {
+                    for result in await service.decodeImages(contentsOf: urls) {
+                        switch result {
+                        case .success(let decoded):
+                            decodedBytes += decoded.image.data.count
+                        case .failure:
+                            failedCount += 1
+                        }
+                    }
+                }
+            } else {
+                duration = clock.measure {
+                    for data in files {
+                        do {
+                            decodedBytes += try Image.decode(from: data).data.count
+                        } catch {
+                            failedCount += 1
+                        }
+                    }
+                }
+            }
+
+            let milliseconds = Double(duration.components.seconds) * 1000
+                + Double(duration.components.attoseconds) / 1e15
+            let result = ImageDecodeResult(
+                imageCount: urls.count - failedCount,
+                decodedBytes: decodedBytes,
+                milliseconds: milliseconds
+            )
+            print(
+                "run \(runIndex) : \(milliseconds) (ms), "
+                + String(format: "%.1f MB/s", result.megabytesPerSecond)
+                + (failedCount > 0 ? ", \(failedCount) failed" : "")
+            )
+            if best == nil || milliseconds < best!.milliseconds {
+                best = result
+            }
+        }
+
+        guard let best else {
+            return
+        }
+
+        try best.write(to: options.outputDirectory)
+        print("======================================")
+        print("Results written to \(options.outputDirectory.path)")
+
+        guard let baselineDirectory = options.baselineDirectory else {
+            return
+        }
+
+        guard let baseline = try ImageDecodeResult.read(from: baselineDirectory) else {
+            print("png_decode: no baseline")
+            return
+        }
+
+        // Corpora may differ, so throughput is compared instead of time.
+        let change = (baseline.megabytesPerSecond - best.megabytesPerSecond) / baseline.megabytesPerSecond * 100
+        let isRegression = change > options.threshold
+        print(
+            "png_decode: "
+            + String(format: "%.1f MB/s -> %.1f MB/s (%+.1f%% slower)", baseline.megabytesPerSecond, best.megabytesPerSecond, change)
+            + (isRegression ? " REGRESSION" : "")
+        )
+
+        if isRegression {
+            exit(1)
+        }
+    }
+
+    /// PNG files of the directories found recursively, sorted by path for a stable order.
+    private static func corpusURLs(_ directories: [URL]) -> [URL] {
+        var urls: [URL] = []
+        for directory in directories {
+            guard let enumerator = FileManager.default.enumerator(
+                at: directory,
+                includingPropertiesForKeys: nil
+            ) else {
+                print("Skipping missing corpus directory \(directory.path)")
+                continue
+            }
+
+            for case let url as URL in enumerator where url.pathExtension.lowercased() == "png" {
+                urls.append(url)
+            }
+        }
+
+        return urls.sorted { $0.path < $1.path }
+    }
+}
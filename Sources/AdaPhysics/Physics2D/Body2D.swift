@@ -13,27 +13,42 @@ import Math
 /// This class is used to hold a box2d body reference.
 public final class Body2D: @unchecked Sendable {
 
+    /// The world that owns the body, nil once the world was reset or destroyed.
     weak var world: PhysicsWorld2D?
     weak var entity: Entity?
     
     let bodyId: b2BodyId
 
+    /// Transforms before and after the last step the body moved in.
+    private var previousTransform: b2Transform
+    private var currentTransform: b2Transform
+    /// Index of the world step the body moved in last time.
+    private var lastMoveStep: Int = -1
+
     internal init(world: consuming PhysicsWorld2D, bodyId: b2BodyId, entity: consuming Entity) {
         self.world = world
         self.bodyId = bodyId
         self.entity = entity
+        self.currentTransform = b2Body_GetTransform(bodyId)
+        self.previousTransform = self.currentTransform
     }
     
     deinit {
         world?.destroyBody(self)
     }
 
+    /// - Returns: Created shape, or nil for a chain. Chain segments are returned by ``getShapes()``.
     @discardableResult
     func appendShape(
         _ shapeResource: Shape2DResource,
         transform: Transform,
         shapeDef: b2ShapeDef
-    ) -> BoxShape2D {
+    ) -> BoxShape2D? {
+        if case .chain(let chain) = shapeResource.fixture {
+            unsafe BoxShape2D.makeChain(for: chain, transform: transform, shapeDef: shapeDef, bodyId: bodyId)
+            return nil
+        }
+
         let shapeId = unsafe BoxShape2D.makeShape(
             for: shapeResource,
             transform: transform,
@@ -89,6 +104,30 @@ public final class Body2D: @unchecked Sendable {
     
     func setTransform(position: Vector2, angle: Angle) {
         b2Body_SetTransform(bodyId, position.b2Vec, b2MakeRot(angle.radians))
+        // Teleport isn't interpolated.
+        self.currentTransform = b2Body_GetTransform(bodyId)
+        self.lastMoveStep = -1
+    }
+
+    /// Called for each move event of the body.
+    func didMove(to transform: b2Transform, step: Int) {
+        self.previousTransform = self.currentTransform
+        self.currentTransform = transform
+        self.lastMoveStep = step
+    }
+
+    /// Returns the body transform blended between the two last steps.
+    /// - Parameter fraction: Fixed time overstep fraction.
+    /// - Parameter step: Index of the last world step.
+    func getInterpolatedTransform(fraction: Float, step: Int) -> (position: Vector2, angle: Angle) {
+        guard self.lastMoveStep == step else {
+            // Body didn't move in the last step.
+            return (getPosition(), getAngle())
+        }
+
+        let position = b2Lerp(previousTransform.p, currentTransform.p, fraction)
+        let rotation = b2NLerp(previousTransform.q, currentTransform.q, fraction)
+        return (position.asVector2, Angle.radians(b2Rot_GetAngle(rotation)))
     }
     
     /// Set the linear velocity of the center of mass.
@@ -214,14 +253,16 @@ final class BoxShape2D {
                 }
             }
         case .circle(let shape):
-            var circle = b2Circle(center: Vector2.zero.b2Vec, radius: shape.radius * transform.scale.x)
+            var circle = b2Circle(center: shape.offset.b2Vec, radius: shape.radius * transform.scale.x)
             return unsafe withUnsafePointer(to: shapeDef) { shapeDefPtr in
                 unsafe b2CreateCircleShape(bodyId, shapeDefPtr, &circle)
             }
         case .box(let shape):
-            let polygon = b2MakeBox(
+            let polygon = b2MakeOffsetBox(
                 transform.scale.x * shape.halfWidth,
-                transform.scale.y * shape.halfHeight
+                transform.scale.y * shape.halfHeight,
+                shape.offset.b2Vec,
+                b2Rot_identity
             )
             
             return unsafe withUnsafePointer(to: shapeDef) { shapeDefPtr in
@@ -229,6 +270,40 @@ final class BoxShape2D {
                     unsafe b2CreatePolygonShape(bodyId, shapeDefPtr, polygonPtr)
                 }
             }
+        case .chain:
+            fatalError("Chain shapes are created by makeChain(for:transform:shapeDef:bodyId:)")
+        }
+    }
+
+    /// Create one-sided segments of the chain with surface and filter of the shape definition.
+    ///
+    /// Points are scaled by the transform scale like sizes of boxes and circles.
+    @discardableResult
+    static func makeChain(
+        for chain: Shape2DResource.ChainShape,
+        transform: Transform,
+        shapeDef: b2ShapeDef,
+        bodyId: b2BodyId
+    ) -> b2ChainId {
+        var material = b2DefaultSurfaceMaterial()
+        material.friction = shapeDef.friction
+        material.restitution = shapeDef.restitution
+        material.customColor = shapeDef.customColor
+
+        let scale = transform.scale.xy
+        let points = chain.points.map { (($0 + chain.offset) * scale).b2Vec }
+        var chainDef = unsafe b2DefaultChainDef()
+        unsafe chainDef.count = Int32(points.count)
+        unsafe chainDef.materialCount = 1
+        unsafe chainDef.filter = shapeDef.filter
+        unsafe chainDef.isLoop = chain.isLoop
+
+        return unsafe points.withUnsafeBufferPointer { pointsPtr in
+            unsafe withUnsafePointer(to: material) { materialPtr in
+                unsafe chainDef.points = pointsPtr.baseAddress
+                unsafe chainDef.materials = materialPtr
+                return unsafe b2CreateChain(bodyId, &chainDef)
+            }
         }
     }
 }
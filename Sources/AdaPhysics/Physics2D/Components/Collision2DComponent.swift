@@ -11,7 +11,16 @@ import AdaUtils
 @Component
 public struct Collision2DComponent: Sendable, Codable {
     
-    internal var runtimeBody: Body2D?
+    /// Body in the physics world, nil if the body was detached by ``PhysicsWorld2D/reset()``.
+    internal var runtimeBody: Body2D? {
+        get {
+            self.attachedBody?.world == nil ? nil : self.attachedBody
+        }
+        set {
+            self.attachedBody = newValue
+        }
+    }
+    private var attachedBody: Body2D?
     internal private(set) var shapes: [Shape2DResource] = []
     
     /// The physics body’s mode, indicating how or if it moves.
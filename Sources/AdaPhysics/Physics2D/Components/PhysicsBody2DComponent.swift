@@ -19,7 +19,16 @@ public struct PhysicsBody2DComponent {
     /// The physics body's filter.
     public var filter: CollisionFilter = CollisionFilter()
     
-    internal var runtimeBody: Body2D?
+    /// Body in the physics world, nil if the body was detached by ``PhysicsWorld2D/reset()``.
+    internal var runtimeBody: Body2D? {
+        get {
+            self.attachedBody?.world == nil ? nil : self.attachedBody
+        }
+        set {
+            self.attachedBody = newValue
+        }
+    }
+    private var attachedBody: Body2D?
     internal private(set) var shapes: [Shape2DResource]
     
     /// The physics body’s material properties, like friction.
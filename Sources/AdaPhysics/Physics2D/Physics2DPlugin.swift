@@ -17,8 +17,12 @@ public struct Physics2DPlugin: Plugin {
 
     public let gravity: Vector2
 
-    public init(gravity: Vector2 = [0, -9.81]) {
+    /// Describes how transforms of moving bodies are written between fixed steps.
+    public let interpolationMode: PhysicsInterpolationMode
+
+    public init(gravity: Vector2 = [0, -9.81], interpolationMode: PhysicsInterpolationMode = .none) {
         self.gravity = gravity
+        self.interpolationMode = interpolationMode
     }
 
     public func setup(in app: AppWorlds) {
@@ -26,12 +30,16 @@ public struct Physics2DPlugin: Plugin {
         PhysicsJoint2DComponent.registerComponent()
         Collision2DComponent.registerComponent()
         
+        let world = PhysicsWorld2D(gravity: gravity)
+        world.interpolationMode = interpolationMode
+
         app
             .insertResource(
                 Physics2DWorldHolder(
-                    world: PhysicsWorld2D(gravity: gravity)
+                    world: world
                 )
             )
+            .insertResource(PhysicsStats())
             .insertResource(PhysicsDebugOptions())
             .addSystem(Physics2DSyncSystem.self, on: .postUpdate)
             .addSystem(Physics2DUpdateSystem.self, on: .fixedUpdate)
@@ -57,6 +65,16 @@ public struct Physics2DPlugin: Plugin {
 /// Resource contains ``PhysicsWorld2D``.
 public struct Physics2DWorldHolder: Resource {
     public let world: PhysicsWorld2D
+
+    /// Worlds stepped by ``Physics2DUpdateSystem``, contains ``world`` by default.
+    ///
+    /// Add independent worlds to the group to step them concurrently with the main world.
+    public let group: PhysicsWorld2DGroup
+
+    public init(world: PhysicsWorld2D) {
+        self.world = world
+        self.group = PhysicsWorld2DGroup(worlds: [world])
+    }
 }
 
 public extension World {
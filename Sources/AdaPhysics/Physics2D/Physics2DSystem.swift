@@ -11,17 +11,28 @@ import AdaUtils
 import box2d
 import Math
 
-@MainActor
-@System
-public func Physics2DUpdate(
-    _ physicsWorld: Res<Physics2DWorldHolder>,
-    _ fixedTime: Res<FixedTime>
-) {
-    let deltaTime = fixedTime.deltaTime
-    let world = physicsWorld.world
-    world.updateSimulation(deltaTime)
-    world.processContacts()
-    world.processSensors()
+/// A system that steps worlds of ``Physics2DWorldHolder/group`` and sends their events.
+@PlainSystem
+public struct Physics2DUpdateSystem: Sendable {
+
+    @Res<Physics2DWorldHolder>
+    private var physicsWorld
+
+    @Res<FixedTime>
+    private var fixedTime
+
+    @ResMut<PhysicsStats>
+    private var stats
+
+    public init(world: World) { }
+
+    public func update(context: UpdateContext) async {
+        await physicsWorld.group.step(fixedTime.deltaTime)
+
+        let stepEnd = AdaTrace.nowNanoseconds
+        stats = physicsWorld.world.getStats()
+        stats.recordTrace(endedAt: stepEnd)
+    }
 }
 
 // - TODO: (Vlad) Runtime update shape resource
@@ -42,6 +53,9 @@ public struct Physics2DSyncSystem: Sendable {
     @Res<Physics2DWorldHolder>
     private var physicsWorld
 
+    @Res<FixedTime?>
+    private var fixedTime
+
     public init(world: World) { }
 
     public func update(context: UpdateContext) {
@@ -52,6 +66,9 @@ public struct Physics2DSyncSystem: Sendable {
     // MARK: - Private
 
     private func updatePhysicsBodyEntities(in world: PhysicsWorld2D) {
+        let isInterpolated = world.interpolationMode == .interpolate
+        let overstepFraction = fixedTime?.overstepFraction ?? 0
+
         self.physicsBodyQuery.forEach { entity, physicsBody, transform in
             if let body = physicsBody.runtimeBody {
                 if physicsBody.mode == .static {
@@ -60,10 +77,12 @@ public struct Physics2DSyncSystem: Sendable {
                         angle: transform.rotation.angle2D
                     )
                 } else {
-                    let position = body.getPosition()
+                    let (position, angle) = isInterpolated
+                        ? body.getInterpolatedTransform(fraction: overstepFraction, step: world.stepIndex)
+                        : (body.getPosition(), body.getAngle())
                     transform.position.x = position.x
                     transform.position.y = position.y
-                    transform.rotation = Quat(axis: [0, 0, 1], angle: -body.getAngle().radians)
+                    transform.rotation = Quat(axis: [0, 0, 1], angle: -angle.radians)
                 }
                 
                 body.massData.mass = physicsBody.massProperties.mass
@@ -0,0 +1,133 @@
+//
+//  PhysicsStats.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaECS
+import AdaUtils
+import box2d
+
+/// Resource contains timings and counters of the last step of ``PhysicsWorld2D``.
+public struct PhysicsStats: Resource {
+
+    /// Time of step stages in milliseconds.
+    public struct StageTimings: Sendable {
+        /// The whole step.
+        public var step: Float = 0
+        /// Update of broadphase pairs.
+        public var pairs: Float = 0
+        /// Narrowphase collision.
+        public var collide: Float = 0
+        /// Solver, includes ``constraints``, ``continuous`` and ``sleepIslands``.
+        public var solve: Float = 0
+        /// Solving of contact and joint constraints.
+        public var constraints: Float = 0
+        /// Continuous collision of fast bodies.
+        public var continuous: Float = 0
+        /// Putting islands to sleep.
+        public var sleepIslands: Float = 0
+        /// Sensor overlaps.
+        public var sensors: Float = 0
+    }
+
+    /// Size of the simulation.
+    public struct Counters: Sendable {
+        public var bodyCount: Int = 0
+        public var shapeCount: Int = 0
+        public var contactCount: Int = 0
+        public var jointCount: Int = 0
+        public var islandCount: Int = 0
+        public var awakeIslandCount: Int = 0
+        /// Height of the broadphase tree of static bodies.
+        public var staticTreeHeight: Int = 0
+        /// Height of the broadphase tree of moving bodies.
+        public var treeHeight: Int = 0
+        /// Tasks used by the last step.
+        public var taskCount: Int = 0
+    }
+
+    public var timings = StageTimings()
+    public var counters = Counters()
+
+    public init() {}
+}
+
+extension PhysicsStats {
+    init(profile: b2Profile, counters: b2Counters) {
+        self.timings = StageTimings(
+            step: profile.step,
+            pairs: profile.pairs,
+            collide: profile.collide,
+            solve: profile.solve,
+            constraints: profile.solveConstraints,
+            continuous: profile.bullets,
+            sleepIslands: profile.sleepIslands,
+            sensors: profile.sensors
+        )
+        self.counters = Counters(
+            bodyCount: Int(counters.bodyCount),
+            shapeCount: Int(counters.shapeCount),
+            contactCount: Int(counters.contactCount),
+            jointCount: Int(counters.jointCount),
+            islandCount: Int(counters.islandCount),
+            awakeIslandCount: Int(counters.awakeIslandCount),
+            staticTreeHeight: Int(counters.staticTreeHeight),
+            treeHeight: Int(counters.treeHeight),
+            taskCount: Int(counters.taskCount)
+        )
+    }
+
+    /// Record timings of the step ended at the time as nested trace spans.
+    ///
+    /// box2d reports only durations, so stages are laid out one after another from the start of the step.
+    func recordTrace(endedAt end: UInt64) {
+        let timings = self.timings
+        let step = Self.nanoseconds(timings.step)
+        let start = end >= step ? end - step : 0
+        let stepSpan = AdaTrace.recordSpan(
+            "Physics2D.step",
+            start: start,
+            duration: step,
+            attributes: [
+                "physics.bodies": counters.bodyCount,
+                "physics.contacts": counters.contactCount,
+                "physics.awake_islands": counters.awakeIslandCount,
+                "physics.static_tree_height": counters.staticTreeHeight,
+                "physics.tree_height": counters.treeHeight,
+                "physics.tasks": counters.taskCount
+            ]
+        )
+
+        var offset = start
+        for (name, time) in [("pairs", timings.pairs), ("collide", timings.collide)] {
+            AdaTrace.recordSpan("Physics2D.\(name)", start: offset, duration: Self.nanoseconds(time), parent: stepSpan)
+            offset += Self.nanoseconds(time)
+        }
+
+        let solveSpan = AdaTrace.recordSpan(
+            "Physics2D.solve",
+            start: offset,
+            duration: Self.nanoseconds(timings.solve),
+            parent: stepSpan
+        )
+        var solveOffset = offset
+        let solveStages = [
+            ("constraints", timings.constraints),
+            ("continuous", timings.continuous),
+            ("sleepIslands", timings.sleepIslands)
+        ]
+        for (name, time) in solveStages {
+            AdaTrace.recordSpan("Physics2D.\(name)", start: solveOffset, duration: Self.nanoseconds(time), parent: solveSpan)
+            solveOffset += Self.nanoseconds(time)
+        }
+        offset += Self.nanoseconds(timings.solve)
+
+        AdaTrace.recordSpan("Physics2D.sensors", start: offset, duration: Self.nanoseconds(timings.sensors), parent: stepSpan)
+    }
+
+    private static func nanoseconds(_ milliseconds: Float) -> UInt64 {
+        return UInt64(max(milliseconds, 0) * 1_000_000)
+    }
+}
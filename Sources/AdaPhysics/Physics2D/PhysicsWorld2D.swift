@@ -8,6 +8,7 @@
 import AdaECS
 import AdaUtils
 import box2d
+import Foundation
 import Math
 
 /// A protocol that defines a delegate for the physics world.
@@ -122,8 +123,18 @@ public final class PhysicsWorld2D: Codable, @unchecked Sendable {
             b2World_SetHitEventThreshold(worldId, newValue)
         }
     }
+    /// Describes how transforms of moving bodies are written between fixed steps.
+    public var interpolationMode: PhysicsInterpolationMode = .none
+
     private let worldId: b2WorldId
     var eventManager: EventManager = .default
+
+    /// Count of simulated steps.
+    private(set) var stepIndex: Int = 0
+
+    private let bodiesLock = NSLock()
+    /// Bodies created by the world, detached from it on ``reset()``.
+    private var bodies: [ObjectIdentifier: WeakBox<Body2D>] = [:]
     
     /// - Parameter gravity: default gravity is 9.8.
     nonisolated init(gravity: Vector2 = [0, -9.81]) {
@@ -210,13 +221,71 @@ public final class PhysicsWorld2D: Codable, @unchecked Sendable {
     
     // MARK: - Internal
     
-    @MainActor
-    func updateSimulation(_ delta: TimeInterval) {
+    /// Step the simulation without processing events.
+    ///
+    /// Separate worlds don't share state, so different worlds can be stepped concurrently.
+    /// A world must not be stepped from two threads at once, and the delegate is called on the main actor,
+    /// so a world with delegate must be stepped on the main actor.
+    nonisolated func step(_ delta: TimeInterval) {
         b2World_Step(
             worldId,
             Float(delta), /* timeStep */
             Int32(self.substepIterations) /* velocityIterations */
         )
+        self.stepIndex += 1
+    }
+
+    /// Returns timings and counters of the last step.
+    public func getStats() -> PhysicsStats {
+        return PhysicsStats(
+            profile: b2World_GetProfile(worldId),
+            counters: b2World_GetCounters(worldId)
+        )
+    }
+
+    /// Destroy all bodies of the world, keeping its memory and settings for new bodies.
+    ///
+    /// Cheaper than creating a new world when a level is reloaded.
+    /// Runtime bodies of existing components are detached from the world,
+    /// components treat them as missing and ``Physics2DSyncSystem`` creates new bodies for them.
+    @MainActor
+    public func reset() {
+        bodiesLock.lock()
+        let bodies = self.bodies.values.compactMap(\.value)
+        self.bodies.removeAll()
+        bodiesLock.unlock()
+
+        // Ids of old bodies are reused by new bodies, so old bodies must not destroy them.
+        for body in bodies {
+            body.world = nil
+        }
+
+        b2World_Reset(worldId)
+        self.stepIndex = 0
+    }
+
+    /// Send events of the last step.
+    @MainActor
+    func processEvents() {
+        self.processBodyMoves()
+        self.processContacts()
+        self.processSensors()
+    }
+
+    /// Store transforms of bodies moved by the last step.
+    @MainActor
+    func processBodyMoves() {
+        let bodyEvents = unsafe b2World_GetBodyEvents(self.worldId)
+
+        for index in unsafe 0..<Int(bodyEvents.moveCount) {
+            let event = unsafe bodyEvents.moveEvents[index]
+            guard let userData = unsafe event.userData else {
+                continue
+            }
+
+            let body = unsafe Unmanaged<Body2D>.fromOpaque(userData).takeUnretainedValue()
+            body.didMove(to: event.transform, step: self.stepIndex)
+        }
     }
 
     func debugDraw(with definitions: b2DebugDraw) {
@@ -260,6 +329,14 @@ public final class PhysicsWorld2D: Codable, @unchecked Sendable {
     }
 
     nonisolated func destroyBody(_ body: Body2D) {
+        bodiesLock.lock()
+        self.bodies[ObjectIdentifier(body)] = nil
+        bodiesLock.unlock()
+
+        guard b2Body_IsValid(body.bodyId) else {
+            return
+        }
+
         b2DestroyBody(body.bodyId)
     }
     
@@ -272,6 +349,10 @@ public final class PhysicsWorld2D: Codable, @unchecked Sendable {
         let pointer = unsafe Unmanaged.passUnretained(body2d).toOpaque()
         unsafe b2Body_SetUserData(body, pointer)
 
+        bodiesLock.lock()
+        self.bodies[ObjectIdentifier(body2d)] = WeakBox(body2d)
+        bodiesLock.unlock()
+
         return body2d
     }
 }
@@ -381,6 +462,10 @@ private func PhysicsWorld2D_PreSolve(
         return false
     }
     let world = unsafe Unmanaged<PhysicsWorld2D>.fromOpaque(context).takeUnretainedValue()
+    // Worlds without delegate can be stepped outside of the main actor.
+    guard world.delegate != nil else {
+        return false
+    }
     let manifold = unsafe manifold.flatMap { ptr in
         unsafe Manifold2D(
             normal: ptr.pointee.normal.asVector2,
@@ -421,6 +506,9 @@ private func PhysicsWorld2D_CustomFilterCallback(
         return true
     }
     let world = unsafe Unmanaged<PhysicsWorld2D>.fromOpaque(context).takeUnretainedValue()
+    guard world.delegate != nil else {
+        return true
+    }
     return MainActor.assumeIsolated {
         
         let shapeIdA = BoxShape2D(shape: shapeA)
@@ -595,6 +683,16 @@ fileprivate final class _Raycast2DCallback {
 //    }
 //}
 
+/// Describes how transforms of moving bodies are written between fixed steps.
+public enum PhysicsInterpolationMode: Codable, Sendable {
+    /// Transform is equal to the body transform after the last step.
+    case none
+    /// Transform is blended between the two last steps by the fixed time overstep.
+    /// It keeps motion smooth when frame rate is higher than the physics tick rate,
+    /// with latency of one physics step.
+    case interpolate
+}
+
 /// A manifold of a collision.
 public struct Manifold2D: Sendable {
     /// The normal of the manifold.
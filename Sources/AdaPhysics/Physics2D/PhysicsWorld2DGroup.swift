@@ -0,0 +1,89 @@
+//
+//  PhysicsWorld2DGroup.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaUtils
+import Foundation
+
+/// A set of independent physics worlds stepped together.
+///
+/// Worlds are stepped concurrently on the shared concurrency pool, so throughput scales with the number of cores.
+/// A group with a single world steps it on the main actor.
+/// Events are sent on the main actor after all worlds are stepped, one world after another in order of the group.
+/// Worlds can be added and removed from any thread, the change applies from the next step.
+///
+/// - Note: ``PhysicsWorld2D/delegate`` is called on the main actor,
+/// so worlds with delegate are stepped on the main actor after the others.
+public final class PhysicsWorld2DGroup: @unchecked Sendable {
+
+    /// The worlds of the group in order of event processing.
+    public var worlds: [PhysicsWorld2D] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return self._worlds
+    }
+
+    private let lock = NSLock()
+    private var _worlds: [PhysicsWorld2D]
+
+    public init(worlds: [PhysicsWorld2D] = []) {
+        self._worlds = worlds
+    }
+
+    /// Add a world to the group. A world must be stepped only by one group.
+    public func addWorld(_ world: PhysicsWorld2D) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard !self._worlds.contains(where: { $0 === world }) else {
+            return
+        }
+
+        self._worlds.append(world)
+    }
+
+    /// Remove a world from the group.
+    public func removeWorld(_ world: PhysicsWorld2D) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        self._worlds.removeAll(where: { $0 === world })
+    }
+
+    /// Step all worlds of the group and send their events.
+    /// - Parameter deltaTime: The time step of each world.
+    public func step(_ deltaTime: TimeInterval) async {
+        // Step works on a snapshot, so worlds added or removed meanwhile don't race with stepping.
+        let worlds = self.worlds
+
+        if worlds.count == 1 {
+            await MainActor.run {
+                worlds[0].step(deltaTime)
+                worlds[0].processEvents()
+            }
+            return
+        }
+
+        await withTaskGroup(of: Void.self) { group in
+            for world in worlds where world.delegate == nil {
+                group.addTask {
+                    world.step(deltaTime)
+                }
+            }
+        }
+
+        await MainActor.run {
+            for world in worlds where world.delegate != nil {
+                world.step(deltaTime)
+            }
+
+            for world in worlds {
+                world.processEvents()
+            }
+        }
+    }
+}
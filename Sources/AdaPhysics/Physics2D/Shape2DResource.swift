@@ -25,11 +25,18 @@ public final class Shape2DResource: Codable, Sendable {
         let verticies: [Vector2]
         var offset: Vector2 = .zero
     }
+
+    struct ChainShape: Codable, Hashable, Equatable, Sendable {
+        let points: [Vector2]
+        let isLoop: Bool
+        var offset: Vector2 = .zero
+    }
     
     enum Fixture: Codable, Hashable, Equatable, Sendable {
         case circle(CircleShape)
         case box(BoxShape)
         case polygon(PolygonShape)
+        case chain(ChainShape)
     }
     
     let fixture: Fixture
@@ -58,6 +65,14 @@ public final class Shape2DResource: Codable, Sendable {
     public static func generatePolygon(vertices: [Vector2]) -> Shape2DResource {
         return Shape2DResource(fixture: .polygon(PolygonShape(verticies: vertices)))
     }
+
+    /// Creates a chain of one-sided segments. Segments collide on the right side,
+    /// so a counter-clockwise loop collides from outside.
+    /// - Parameter points: At least 4 points of the chain.
+    /// - Parameter isLoop: Connects the last point to the first one.
+    public static func generateChain(points: [Vector2], isLoop: Bool = true) -> Shape2DResource {
+        return Shape2DResource(fixture: .chain(ChainShape(points: points, isLoop: isLoop)))
+    }
     
     /// Creates a new shape resource by applying a rotation.
     public func offsetBy(x: Float, y: Float) -> Shape2DResource {
@@ -74,6 +89,24 @@ public final class Shape2DResource: Codable, Sendable {
             shape.offset = [x, y]
             
             return Shape2DResource(fixture: .polygon(shape))
+        case .chain(var shape):
+            shape.offset = [x, y]
+
+            return Shape2DResource(fixture: .chain(shape))
+        }
+    }
+
+    /// Creates a new shape resource moved by the vector from the current offset.
+    public func translated(by vector: Vector2) -> Shape2DResource {
+        switch self.fixture {
+        case .box(let shape):
+            return self.offsetBy(x: shape.offset.x + vector.x, y: shape.offset.y + vector.y)
+        case .circle(let shape):
+            return self.offsetBy(x: shape.offset.x + vector.x, y: shape.offset.y + vector.y)
+        case .polygon(let shape):
+            return self.offsetBy(x: shape.offset.x + vector.x, y: shape.offset.y + vector.y)
+        case .chain(let shape):
+            return self.offsetBy(x: shape.offset.x + vector.x, y: shape.offset.y + vector.y)
         }
     }
 }
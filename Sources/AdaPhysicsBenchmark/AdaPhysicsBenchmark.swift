@@ -0,0 +1,213 @@
+//
+//  AdaPhysicsBenchmark.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import Foundation
+
+// Headless physics benchmarks. Runs the box2d benchmark scenarios for each worker count and the ECS scenario,
+// writes `<name>.csv` files and compares them with a baseline directory,
+// for example `Sources/box2d/benchmark/amd7950x_avx2`.
+// Examples:
+// swift run -c release AdaPhysicsBenchmark --threads 4
+// swift run -c release AdaPhysicsBenchmark --benchmark rain,ecs_pyramids --runs 8 --baseline ./baseline --threshold 3
+
+struct BenchmarkOptions {
+    var maxThreadCount = ProcessInfo.processInfo.activeProcessorCount
+    var singleWorkerCount: Int?
+    var runCount = 4
+    var benchmarkNames: Set<String>?
+    var enableContinuous = true
+    var outputDirectory = URL(fileURLWithPath: FileManager.default.currentDirectoryPath, isDirectory: true)
+    var baselineDirectory: URL?
+    /// Allowed slowdown in percents.
+    var threshold: Float = 5
+
+    static let usage = """
+        AdaPhysicsBenchmark [options]
+        --threads <integer>: the maximum number of threads to use
+        --workers <integer>: run a single worker count
+        --runs <integer>: number of repeats, the best time is reported (default is 4)
+        --benchmark <name,...>: run only listed benchmarks
+        --no-continuous: disable continuous collision
+        --output <path>: directory for CSV files (default is current directory)
+        --baseline <path>: directory with CSV files to compare with
+        --threshold <percent>: slowdown reported as regression (default is 5)
+        """
+
+    init(arguments: [String]) throws {
+        var iterator = arguments.makeIterator()
+
+        func value(for option: String) throws -> String {
+            guard let value = iterator.next() else {
+                throw BenchmarkError.usage("Missing value for \(option)\n\(Self.usage)")
+            }
+            return value
+        }
+
+        func intValue(for option: String) throws -> Int {
+            guard let value = Int(try value(for: option)), value > 0 else {
+                throw BenchmarkError.usage("Expected a positive integer for \(option)\n\(Self.usage)")
+            }
+            return value
+        }
+
+        while let argument = iterator.next() {
+            switch argument {
+            case "--threads":
+                self.maxThreadCount = min(try intValue(for: argument), self.maxThreadCount)
+            case "--workers":
+                self.singleWorkerCount = try intValue(for: argument)
+            case "--runs":
+                self.runCount = min(try intValue(for: argument), 1000)
+            case "--benchmark":
+                self.benchmarkNames = Set(try value(for: argument).split(separator: ",").map(String.init))
+            case "--no-continuous":
+                self.enableContinuous = false
+            case "--output":
+                self.outputDirectory = URL(fileURLWithPath: try value(for: argument), isDirectory: true)
+            case "--baseline":
+                self.baselineDirectory = URL(fileURLWithPath: try value(for: argument), isDirectory: true)
+            case "--threshold":
+                guard let threshold = Float(try value(for: argument)), threshold >= 0 else {
+                    throw BenchmarkError.usage("Expected a non negative number for \(argument)\n\(Self.usage)")
+                }
+                self.threshold = threshold
+            case "-h", "--help":
+                print(Self.usage)
+                exit(0)
+            default:
+                throw BenchmarkError.usage("Unknown option \(argument)\n\(Self.usage)")
+            }
+        }
+
+        if let singleWorkerCount {
+            self.singleWorkerCount = min(singleWorkerCount, self.maxThreadCount)
+        }
+    }
+
+    var workerCounts: [Int] {
+        if let singleWorkerCount {
+            return [singleWorkerCount]
+        }
+        return Array(1...self.maxThreadCount)
+    }
+
+    func shouldRun(_ name: String) -> Bool {
+        return self.benchmarkNames?.contains(name) ?? true
+    }
+
+    func stepCount(for totalStepCount: Int) -> Int {
+        #if DEBUG
+        return 10
+        #else
+        return totalStepCount
+        #endif
+    }
+}
+
+@main
+enum AdaPhysicsBenchmark {
+    @MainActor
+    static func main() async throws {
+        let options = try BenchmarkOptions(arguments: Array(CommandLine.arguments.dropFirst()))
+
+        #if DEBUG
+        print("Debug build, timings are not representative. Use `swift run -c release`.")
+        #endif
+
+        print("Starting AdaPhysics benchmarks")
+        print("======================================")
+
+        var results: [BenchmarkTimes] = []
+
+        for benchmark in Box2DBenchmark.all where options.shouldRun(benchmark.name) {
+            let stepCount = options.stepCount(for: benchmark.totalStepCount)
+            print("benchmark: \(benchmark.name), steps = \(stepCount)")
+
+            var times = BenchmarkTimes(name: benchmark.name, stepCount: benchmark.totalStepCount)
+            for workerCount in options.workerCounts {
+                var minTime = Float.greatestFiniteMagnitude
+                for runIndex in 0..<options.runCount {
+                    let ms = benchmark.run(
+                        workerCount: workerCount,
+                        stepCount: stepCount,
+                        enableContinuous: options.enableContinuous
+                    )
+                    print("thread count: \(workerCount), run \(runIndex) : \(ms) (ms)")
+                    minTime = min(minTime, ms)
+                }
+                times.milliseconds[workerCount] = minTime
+            }
+
+            results.append(times)
+        }
+
+        if options.shouldRun(ECSPhysicsBenchmark.name) {
+            let stepCount = options.stepCount(for: ECSPhysicsBenchmark.totalStepCount)
+            print("benchmark: \(ECSPhysicsBenchmark.name), steps = \(stepCount)")
+
+            // PhysicsWorld2D steps box2d on the calling thread, so only a single worker is reported.
+            var best: ECSPhysicsBenchmark.Result?
+            for runIndex in 0..<options.runCount {
+                let result = try await ECSPhysicsBenchmark().run(stepCount: stepCount)
+                print("thread count: 1, run \(runIndex) : \(result.milliseconds) (ms), physics \(result.physicsMilliseconds) (ms)")
+                if best == nil || result.milliseconds < best!.milliseconds {
+                    best = result
+                }
+            }
+
+            if let best {
+                print("sync overhead: \(best.milliseconds - best.physicsMilliseconds) (ms)")
+                var times = BenchmarkTimes(name: ECSPhysicsBenchmark.name, stepCount: ECSPhysicsBenchmark.totalStepCount)
+                times.milliseconds[1] = best.milliseconds
+                results.append(times)
+            }
+        }
+
+        for times in results {
+            try times.write(to: options.outputDirectory)
+        }
+
+        print("======================================")
+        print("Results written to \(options.outputDirectory.path)")
+
+        guard let baselineDirectory = options.baselineDirectory else {
+            return
+        }
+
+        print("Comparison with \(baselineDirectory.path), threshold \(options.threshold)%")
+
+        var regressionCount = 0
+        for times in results {
+            guard let baseline = try BenchmarkTimes.read(
+                name: times.name,
+                stepCount: times.stepCount,
+                from: baselineDirectory
+            ) else {
+                print("\(times.name): no baseline")
+                continue
+            }
+
+            for comparison in BenchmarkComparison.compare(times, with: baseline) {
+                let isRegression = comparison.change > options.threshold
+                if isRegression {
+                    regressionCount += 1
+                }
+
+                print(
+                    "\(comparison.name) threads \(comparison.threadCount): "
+                    + String(format: "%.2f ms -> %.2f ms (%+.1f%%)", comparison.baseline, comparison.current, comparison.change)
+                    + (isRegression ? " REGRESSION" : "")
+                )
+            }
+        }
+
+        if regressionCount > 0 {
+            print("\(regressionCount) regression(s) above \(options.threshold)%")
+            exit(1)
+        }
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  BenchmarkReport.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import Foundation
+
+/// Times of a benchmark for each worker count, stored as `<name>.csv` in the format of the box2d benchmark app.
+struct BenchmarkTimes: Sendable {
+    let name: String
+    let stepCount: Int
+    /// Time of all steps in milliseconds by worker count.
+    var milliseconds: [Int: Float] = [:]
+
+    /// Write `threads,ms` rows to the directory.
+    func write(to directory: URL) throws {
+        var csv = "threads,ms\n"
+        for threadCount in self.milliseconds.keys.sorted() {
+            csv += "\(threadCount),\(self.milliseconds[threadCount]!)\n"
+        }
+
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        try csv.write(to: directory.appendingPathComponent("\(self.name).csv"), atomically: true, encoding: .utf8)
+    }
+
+    /// Read times from the directory, nil if the benchmark has no file.
+    ///
+    /// Older files of box2d store `threads,fps` rows, they are converted with the step count of the benchmark.
+    static func read(name: String, stepCount: Int, from directory: URL) throws -> BenchmarkTimes? {
+        let url = directory.appendingPathComponent("\(name).csv")
+        guard FileManager.default.fileExists(atPath: url.path) else {
+            return nil
+        }
+
+        let lines = try String(contentsOf: url, encoding: .utf8)
+            .split(whereSeparator: \.isNewline)
+            .map { $0.trimmingCharacters(in: .whitespaces) }
+            .filter { !$0.isEmpty }
+
+        guard let header = lines.first?.split(separator: ","), header.count == 2, header[0] == "threads" else {
+            throw BenchmarkError.invalidBaseline(url)
+        }
+
+        let isFramesPerSecond: Bool
+        switch header[1] {
+        case "ms":
+            isFramesPerSecond = false
+        case "fps":
+            isFramesPerSecond = true
+        default:
+            throw BenchmarkError.invalidBaseline(url)
+        }
+
+        var times = BenchmarkTimes(name: name, stepCount: stepCount)
+        for line in lines.dropFirst() {
+            let columns = line.split(separator: ",")
+            guard columns.count == 2, let threadCount = Int(columns[0]), let value = Float(columns[1]), value > 0 else {
+                throw BenchmarkError.invalidBaseline(url)
+            }
+
+            times.milliseconds[threadCount] = isFramesPerSecond ? Float(stepCount) * 1000 / value : value
+        }
+
+        return times
+    }
+}
+
+/// Difference of a benchmark time from the baseline.
+struct BenchmarkComparison: Sendable {
+    let name: String
+    let threadCount: Int
+    let baseline: Float
+    let current: Float
+
+    /// Change of time in percents, positive if the benchmark became slower.
+    var change: Float {
+        return (self.current - self.baseline) / self.baseline * 100
+    }
+
+    /// Compare times with worker counts present in both.
+    static func compare(_ current: BenchmarkTimes, with baseline: BenchmarkTimes) -> [BenchmarkComparison] {
+        return current.milliseconds.keys.sorted().compactMap { threadCount in
+            guard let baselineTime = baseline.milliseconds[threadCount] else {
+                return nil
+            }
+
+            return BenchmarkComparison(
+                name: current.name,
+                threadCount: threadCount,
+                baseline: baselineTime,
+                current: current.milliseconds[threadCount]!
+            )
+        }
+    }
+}
+
+enum BenchmarkError: LocalizedError {
+    case usage(String)
+    case invalidBaseline(URL)
+
+    var errorDescription: String? {
+        switch self {
+        case .usage(let s):
+            return s
+        case .invalidBaseline(let u):
+            return "Invalid baseline CSV: \(u.path)"
+        }
+    }
+}
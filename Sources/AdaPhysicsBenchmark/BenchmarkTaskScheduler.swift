@@ -0,0 +1,178 @@
+//
+//  BenchmarkTaskScheduler.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import box2d
+import Foundation
+
+/// A thread pool running box2d tasks, the same role enkiTS has in the box2d benchmark app.
+///
+/// Ranges of a task are taken in the order of enqueueing. box2d solver workers wait for the first one,
+/// so the first worker of a solve is always started before the others and the pool can't deadlock.
+final class BenchmarkTaskScheduler: @unchecked Sendable {
+
+    private final class TaskSet {
+        let callback: b2TaskCallback
+        let context: UnsafeMutableRawPointer?
+        var pendingCount: Int
+
+        init(callback: @escaping b2TaskCallback, context: UnsafeMutableRawPointer?, pendingCount: Int) {
+            self.callback = callback
+            unsafe self.context = context
+            self.pendingCount = pendingCount
+        }
+    }
+
+    private struct WorkItem {
+        let taskSet: TaskSet
+        let start: Int32
+        let end: Int32
+    }
+
+    /// Count of threads running tasks, including the thread calling box2d.
+    let workerCount: Int
+
+    private let condition = NSCondition()
+    private var queue: [WorkItem] = []
+    private var queueHead = 0
+    private var isStopped = false
+    private var runningThreadCount = 0
+
+    init(workerCount: Int) {
+        self.workerCount = max(workerCount, 1)
+        self.runningThreadCount = self.workerCount - 1
+
+        // The calling thread is the worker 0.
+        for workerIndex in 1..<self.workerCount {
+            let thread = Thread { [self] in
+                self.runWorker(index: UInt32(workerIndex))
+            }
+            thread.name = "AdaPhysicsBenchmark.worker\(workerIndex)"
+            thread.start()
+        }
+    }
+
+    /// Stop and wait all worker threads.
+    func stop() {
+        self.condition.lock()
+        self.isStopped = true
+        self.condition.broadcast()
+        while self.runningThreadCount > 0 {
+            self.condition.wait()
+        }
+        self.condition.unlock()
+    }
+
+    /// Set callbacks of the world definition to run tasks on this scheduler.
+    func configure(_ worldDef: inout b2WorldDef) {
+        worldDef.workerCount = Int32(self.workerCount)
+        unsafe worldDef.userTaskContext = Unmanaged.passUnretained(self).toOpaque()
+        unsafe worldDef.enqueueTask = { task, itemCount, minRange, taskContext, userContext in
+            let scheduler = unsafe Unmanaged<BenchmarkTaskScheduler>.fromOpaque(userContext!).takeUnretainedValue()
+            return unsafe scheduler.enqueue(task!, itemCount: itemCount, minRange: minRange, context: taskContext)
+        }
+        unsafe worldDef.finishTask = { userTask, userContext in
+            let scheduler = unsafe Unmanaged<BenchmarkTaskScheduler>.fromOpaque(userContext!).takeUnretainedValue()
+            unsafe scheduler.finish(userTask!)
+        }
+    }
+
+    // MARK: - Private
+
+    private func enqueue(
+        _ callback: @escaping b2TaskCallback,
+        itemCount: Int32,
+        minRange: Int32,
+        context: UnsafeMutableRawPointer?
+    ) -> UnsafeMutableRawPointer? {
+        if self.workerCount == 1 {
+            // Executed serially, box2d doesn't call finish for a nil task.
+            unsafe callback(0, itemCount, 0, context)
+            return nil
+        }
+
+        let rangeCount = min(self.workerCount, max(Int(itemCount) / max(Int(minRange), 1), 1))
+        let taskSet = unsafe TaskSet(callback: callback, context: context, pendingCount: rangeCount)
+
+        self.condition.lock()
+        for rangeIndex in 0..<rangeCount {
+            let start = Int(itemCount) * rangeIndex / rangeCount
+            let end = Int(itemCount) * (rangeIndex + 1) / rangeCount
+            self.queue.append(WorkItem(taskSet: taskSet, start: Int32(start), end: Int32(end)))
+        }
+        self.condition.broadcast()
+        self.condition.unlock()
+
+        return unsafe Unmanaged.passRetained(taskSet).toOpaque()
+    }
+
+    private func finish(_ userTask: UnsafeMutableRawPointer) {
+        let taskSet = unsafe Unmanaged<TaskSet>.fromOpaque(userTask).takeRetainedValue()
+
+        // Help with queued work while waiting, like enkiTS does.
+        self.condition.lock()
+        while taskSet.pendingCount > 0 {
+            if let item = self.dequeue() {
+                self.condition.unlock()
+                self.execute(item, workerIndex: 0)
+                self.condition.lock()
+                self.complete(item)
+            } else {
+                self.condition.wait()
+            }
+        }
+        self.condition.unlock()
+    }
+
+    private func runWorker(index: UInt32) {
+        self.condition.lock()
+        while true {
+            if let item = self.dequeue() {
+                self.condition.unlock()
+                self.execute(item, workerIndex: index)
+                self.condition.lock()
+                self.complete(item)
+            } else if self.isStopped {
+                break
+            } else {
+                self.condition.wait()
+            }
+        }
+
+        self.runningThreadCount -= 1
+        self.condition.broadcast()
+        self.condition.unlock()
+    }
+
+    /// - Note: Must be called with locked condition.
+    private func dequeue() -> WorkItem? {
+        guard self.queueHead < self.queue.count else {
+            return nil
+        }
+
+        let item = self.queue[self.queueHead]
+        self.queueHead += 1
+
+        if self.queueHead == self.queue.count {
+            self.queue.removeAll(keepingCapacity: true)
+            self.queueHead = 0
+        }
+
+        return item
+    }
+
+    /// - Note: Must be called with locked condition.
+    private func complete(_ item: WorkItem) {
+        item.taskSet.pendingCount -= 1
+        if item.taskSet.pendingCount == 0 {
+            self.condition.broadcast()
+        }
+    }
+
+    private func execute(_ item: WorkItem, workerIndex: UInt32) {
+        unsafe item.taskSet.callback(item.start, item.end, workerIndex, item.taskSet.context)
+    }
+}
@@ -0,0 +1,62 @@
+//
+//  Box2DBenchmarks.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import box2d
+import box2dBenchmarks
+
+/// A scenario from `box2d/shared/benchmarks.c`, the same list as the box2d benchmark app.
+struct Box2DBenchmark: Sendable {
+    let name: String
+    let create: @Sendable (b2WorldId) -> Void
+    let step: (@Sendable (b2WorldId, Int32) -> Float)?
+    let totalStepCount: Int
+
+    static let all: [Box2DBenchmark] = [
+        Box2DBenchmark(name: "joint_grid", create: { CreateJointGrid($0) }, step: nil, totalStepCount: 500),
+        Box2DBenchmark(name: "large_pyramid", create: { CreateLargePyramid($0) }, step: nil, totalStepCount: 500),
+        Box2DBenchmark(name: "many_pyramids", create: { CreateManyPyramids($0) }, step: nil, totalStepCount: 200),
+        Box2DBenchmark(name: "rain", create: { CreateRain($0) }, step: { StepRain($0, $1) }, totalStepCount: 1000),
+        Box2DBenchmark(name: "smash", create: { CreateSmash($0) }, step: nil, totalStepCount: 300),
+        Box2DBenchmark(name: "spinner", create: { CreateSpinner($0) }, step: { StepSpinner($0, $1) }, totalStepCount: 1400),
+        Box2DBenchmark(name: "tumbler", create: { CreateTumbler($0) }, step: nil, totalStepCount: 750)
+    ]
+
+    /// Run the benchmark with the worker count and returns time of all steps in milliseconds.
+    func run(workerCount: Int, stepCount: Int, enableContinuous: Bool) -> Float {
+        let scheduler = BenchmarkTaskScheduler(workerCount: workerCount)
+        defer {
+            scheduler.stop()
+        }
+
+        var worldDef = b2DefaultWorldDef()
+        worldDef.enableContinuous = enableContinuous
+        scheduler.configure(&worldDef)
+        let worldId = unsafe b2CreateWorld(&worldDef)
+        defer {
+            b2DestroyWorld(worldId)
+        }
+
+        self.create(worldId)
+
+        // Initial step can be expensive and skew benchmark
+        _ = self.step?(worldId, 0)
+        b2World_Step(worldId, BenchmarkConstants.timeStep, BenchmarkConstants.subStepCount)
+
+        let ticks = b2GetTicks()
+        for stepIndex in 1..<max(stepCount, 1) {
+            _ = self.step?(worldId, Int32(stepIndex))
+            b2World_Step(worldId, BenchmarkConstants.timeStep, BenchmarkConstants.subStepCount)
+        }
+
+        return b2GetMilliseconds(ticks)
+    }
+}
+
+enum BenchmarkConstants {
+    static let timeStep: Float = 1.0 / 60.0
+    static let subStepCount: Int32 = 4
+}
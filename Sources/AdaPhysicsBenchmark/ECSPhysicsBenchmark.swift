@@ -0,0 +1,89 @@
+//
+//  ECSPhysicsBenchmark.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaApp
+import AdaECS
+import AdaPhysics
+import AdaTransform
+import box2d
+import Math
+
+/// Pyramids of boxes simulated through ``Physics2DPlugin``.
+///
+/// Each step runs the fixed update with the physics step and the post update with the sync of bodies and transforms,
+/// so the time includes the cost of ECS on top of box2d.
+@MainActor
+struct ECSPhysicsBenchmark {
+
+    struct Result {
+        /// Time of all steps in milliseconds.
+        var milliseconds: Float
+        /// Time of box2d steps in milliseconds.
+        var physicsMilliseconds: Float
+    }
+
+    static let name = "ecs_pyramids"
+    static let totalStepCount = 500
+
+    let pyramidCount = 10
+    let baseCount = 10
+
+    func run(stepCount: Int) async throws -> Result {
+        let app = AppWorlds(main: World())
+        app
+            .addPlugin(MainSchedulerPlugin())
+            .addPlugin(Physics2DPlugin())
+            .addPlugin(TransformPlugin())
+        try await app.build()
+
+        let world = app.main
+        world.insertResource(FixedTime(deltaTime: BenchmarkConstants.timeStep))
+        self.spawnPyramids(in: world)
+
+        // Bodies are created by the first sync
+        await world.runScheduler(.postUpdate)
+        await world.runScheduler(.fixedUpdate)
+        await world.runScheduler(.postUpdate)
+
+        var physicsMilliseconds: Float = 0
+        let ticks = b2GetTicks()
+        for _ in 1..<max(stepCount, 1) {
+            await world.runScheduler(.fixedUpdate)
+            physicsMilliseconds += world.getResource(PhysicsStats.self)?.timings.step ?? 0
+            await world.runScheduler(.postUpdate)
+        }
+
+        return Result(milliseconds: b2GetMilliseconds(ticks), physicsMilliseconds: physicsMilliseconds)
+    }
+
+    private func spawnPyramids(in world: World) {
+        let spacing: Float = Float(self.baseCount) + 2
+        let groundWidth = spacing * Float(self.pyramidCount)
+
+        world.spawn {
+            Collision2DComponent(shapes: [.generateBox(width: groundWidth, height: 2)])
+            Transform(position: [0, -1, 0])
+        }
+
+        for pyramidIndex in 0..<self.pyramidCount {
+            let centerX = (Float(pyramidIndex) - Float(self.pyramidCount - 1) * 0.5) * spacing
+
+            for row in 0..<self.baseCount {
+                let columnCount = self.baseCount - row
+                for column in 0..<columnCount {
+                    let x = centerX + (Float(column) - Float(columnCount - 1) * 0.5) * 1.05
+                    let y = 0.5 + Float(row) * 1.05
+
+                    world.spawn {
+                        PhysicsBody2DComponent(shapes: [.generateBox()], mass: 1, mode: .dynamic)
+                        Transform(position: [x, y, 0])
+                    }
+                }
+            }
+        }
+    }
+}
@@ -124,14 +124,11 @@ public extension Image {
     
     private enum LoadingError: LocalizedError {
         case formatNotSupported(String)
-        case readFileFailedAtPath(URL)
         
         var errorDescription: String? {
             switch self {
             case .formatNotSupported(let format):
                 return "Image with format \"\(format)\" not supported."
-            case .readFileFailedAtPath(let path):
-                return "Can't read file at path \(path.absoluteString)."
             }
         }
     }
@@ -145,11 +142,7 @@ public extension Image {
             throw LoadingError.formatNotSupported(file.pathExtension)
         }
         
-        guard let data = FileSystem.current.readFile(at: file) else {
-            throw LoadingError.readFileFailedAtPath(file)
-        }
-        
-        let image = try loader.decodeImage(from: data)
+        let image = try loader.decodeImage(contentsOf: file)
         
         self.init(
             width: image.width,
@@ -219,6 +212,22 @@ extension Image: Asset {
     }
 }
 
+extension Image: BatchDecodableAsset {
+
+    /// PNG files are decoded by ``ImageDecodeService/shared`` on all cores, other files by ``init(from:)``.
+    public static func decodeAssets(contentsOf urls: [URL]) async -> [Result<Image, any Error>?] {
+        let loader = PNGImageSerializer()
+        let pngIndices = urls.indices.filter { loader.canDecodeImage(with: urls[$0].pathExtension) }
+        let decodedImages = await ImageDecodeService.shared.decodeImages(contentsOf: pngIndices.map { urls[$0] })
+
+        var results = [Result<Image, any Error>?](repeating: nil, count: urls.count)
+        for (index, result) in zip(pngIndices, decodedImages) {
+            results[index] = result.map(\.image)
+        }
+        return results
+    }
+}
+
 private extension Image {
     static func makeEmptyData(
         for format: Format,
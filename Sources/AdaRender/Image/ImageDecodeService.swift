@@ -0,0 +1,404 @@
+//
+//  ImageDecodeService.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaUtils
+import Foundation
+import Math
+
+/// Options of image decoding with ``ImageDecodeService``.
+public struct ImageDecodeOptions: Hashable, Sendable {
+    /// Multiply color channels by alpha.
+    public var premultipliesAlpha: Bool
+    /// Generate mipmap levels down to 1x1 with a 2x2 box filter.
+    public var generatesMipmaps: Bool
+    /// Size of file reads passed to the decoder, in bytes.
+    public var readChunkSize: Int
+    /// Decode with SIMD paths of the decoder. Tests turn it off to compare with the generic code.
+    var usesSIMD = true
+
+    public init(
+        premultipliesAlpha: Bool = false,
+        generatesMipmaps: Bool = false,
+        readChunkSize: Int = 64 * 1024
+    ) {
+        self.premultipliesAlpha = premultipliesAlpha
+        self.generatesMipmaps = generatesMipmaps
+        self.readChunkSize = readChunkSize
+    }
+}
+
+/// Memory layout of decoded pixels.
+///
+/// Levels are RGBA8 rows without padding, stored one after another.
+/// Level `n` is `max(1, width >> n)` by `max(1, height >> n)` pixels.
+public struct ImageDecodeLayout: Hashable, Sendable {
+    public let width: Int
+    public let height: Int
+    /// Number of levels, 1 if mipmaps aren't generated.
+    public let levelCount: Int
+
+    public init(width: Int, height: Int, levelCount: Int) {
+        self.width = width
+        self.height = height
+        self.levelCount = levelCount
+    }
+
+    /// Size of all levels in bytes.
+    public var byteCount: Int {
+        return self.byteRange(ofLevel: self.levelCount - 1).upperBound
+    }
+
+    /// Size of the level in pixels.
+    public func size(ofLevel level: Int) -> SizeInt {
+        return SizeInt(width: max(1, self.width >> level), height: max(1, self.height >> level))
+    }
+
+    /// Bytes of the level in the decoded memory.
+    public func byteRange(ofLevel level: Int) -> Range<Int> {
+        var offset = 0
+        for index in 0..<level {
+            offset += self.byteCount(ofLevel: index)
+        }
+        return offset..<offset + self.byteCount(ofLevel: level)
+    }
+
+    private func byteCount(ofLevel level: Int) -> Int {
+        let size = self.size(ofLevel: level)
+        return size.width * size.height * 4
+    }
+}
+
+/// An image decoded by ``ImageDecodeService``.
+public struct DecodedImage: Sendable {
+    /// The base level.
+    public var image: Image
+    /// Levels after the base one, empty if mipmaps weren't requested.
+    public var mipmaps: [Image]
+    /// Indicates whether color channels are multiplied by alpha.
+    public var isAlphaPremultiplied: Bool
+}
+
+public enum ImageDecodeError: LocalizedError {
+    case readFailed(URL)
+    case invalidData(String)
+    case truncatedData
+    case outOfMemory
+
+    public var errorDescription: String? {
+        switch self {
+        case .readFailed(let url):
+            return "Can't read file at path \(url.path)."
+        case .invalidData(let message):
+            return "Invalid png data: \(message)."
+        case .truncatedData:
+            return "Png data ended before the image end."
+        case .outOfMemory:
+            return "Not enough memory to decode the image."
+        }
+    }
+}
+
+/// A service that decodes PNG images on a bounded number of workers.
+///
+/// Files are read in chunks which are decoded as they arrive, so a file is never held in memory whole.
+/// Pixels are decoded into pooled buffers that become the image data without a copy,
+/// a buffer returns to the pool when its images are released.
+///
+/// ```swift
+/// let results = await ImageDecodeService.shared.decodeImages(
+///     contentsOf: spriteURLs,
+///     options: ImageDecodeOptions(premultipliesAlpha: true)
+/// )
+/// ```
+public final class ImageDecodeService: Sendable {
+
+    /// The service shared by the process, it decodes on all cores.
+    public static let shared = ImageDecodeService()
+
+    /// Maximum number of images decoded at once by ``decodeImages(contentsOf:options:)``.
+    public let maxConcurrentDecodes: Int
+
+    private let bufferPool: ImageBufferPool
+
+    /// Create a new decode service.
+    /// - Parameter maxConcurrentDecodes: Maximum number of images decoded at once.
+    /// - Parameter maxPooledBytes: Maximum size of released buffers kept for reuse.
+    public init(
+        maxConcurrentDecodes: Int = ProcessInfo.processInfo.activeProcessorCount,
+        maxPooledBytes: Int = 64 * 1024 * 1024
+    ) {
+        self.maxConcurrentDecodes = max(maxConcurrentDecodes, 1)
+        self.bufferPool = ImageBufferPool(maxPooledBytes: maxPooledBytes)
+    }
+
+    /// Decode images of the files, at most ``maxConcurrentDecodes`` at once.
+    ///
+    /// Each worker takes the next file when it's done with the previous one, and reuses its read buffer.
+    /// - Returns: Results in the order of `urls`.
+    @concurrent
+    public func decodeImages(
+        contentsOf urls: [URL],
+        options: ImageDecodeOptions = ImageDecodeOptions()
+    ) async -> [Result<DecodedImage, any Error>] {
+        let workerCount = min(self.maxConcurrentDecodes, urls.count)
+        let queue = ImageDecodeQueue(count: urls.count)
+
+        return await withTaskGroup(of: [(Int, Result<DecodedImage, any Error>)].self) { group in
+            for _ in 0..<workerCount {
+                group.addTask {
+                    let readBuffer = unsafe Self.makeReadBuffer(options)
+                    defer { unsafe readBuffer.deallocate() }
+
+                    var results: [(Int, Result<DecodedImage, any Error>)] = []
+                    while let index = queue.next() {
+                        let result = Result {
+                            unsafe try self.decodeImage(contentsOf: urls[index], options: options, readBuffer: readBuffer)
+                        }
+                        results.append((index, result))
+                    }
+                    return results
+                }
+            }
+
+            var results = [Result<DecodedImage, any Error>?](repeating: nil, count: urls.count)
+            for await workerResults in group {
+                for (index, result) in workerResults {
+                    results[index] = result
+                }
+            }
+            return results.compactMap { $0 }
+        }
+    }
+
+    /// Decode an image of the file on the current thread.
+    public func decodeImage(
+        contentsOf url: URL,
+        options: ImageDecodeOptions = ImageDecodeOptions()
+    ) throws -> DecodedImage {
+        let readBuffer = unsafe Self.makeReadBuffer(options)
+        defer { unsafe readBuffer.deallocate() }
+
+        return unsafe try self.decodeImage(contentsOf: url, options: options, readBuffer: readBuffer)
+    }
+
+    /// Decode an image from memory on the current thread.
+    public func decodeImage(
+        from data: Data,
+        options: ImageDecodeOptions = ImageDecodeOptions()
+    ) throws -> DecodedImage {
+        var buffer: ImageBufferPool.Buffer?
+        let decoder = try PNGStreamDecoder(options: options) { layout in
+            let pooledBuffer = self.bufferPool.take(byteCount: layout.byteCount)
+            buffer = pooledBuffer
+            return unsafe pooledBuffer.pointer
+        }
+
+        unsafe try data.withUnsafeBytes { bytes in
+            unsafe try decoder.push(bytes)
+        }
+
+        guard decoder.isFinished, let buffer, let layout = decoder.layout else {
+            throw ImageDecodeError.truncatedData
+        }
+        return self.makeDecodedImage(buffer, layout: layout, options: options)
+    }
+
+    /// Decode an image of the file into memory provided by the caller.
+    ///
+    /// - Parameter allocate: Returns memory for the decoded pixels of at least ``ImageDecodeLayout/byteCount`` bytes.
+    ///   It's called once, when the image header is read. The memory doesn't need to be initialized.
+    /// - Returns: Layout of the pixels written to the memory.
+    public func decodeImage(
+        contentsOf url: URL,
+        options: ImageDecodeOptions = ImageDecodeOptions(),
+        into allocate: (ImageDecodeLayout) throws -> UnsafeMutableRawPointer
+    ) throws -> ImageDecodeLayout {
+        let readBuffer = unsafe Self.makeReadBuffer(options)
+        defer { unsafe readBuffer.deallocate() }
+
+        return try withoutActuallyEscaping(allocate) { allocate in
+            let decoder = try PNGStreamDecoder(options: options, allocate: allocate)
+            unsafe try self.read(url, into: decoder, readBuffer: readBuffer)
+
+            guard let layout = decoder.layout else {
+                throw ImageDecodeError.truncatedData
+            }
+            return layout
+        }
+    }
+
+    // MARK: - Private
+
+    private func decodeImage(
+        contentsOf url: URL,
+        options: ImageDecodeOptions,
+        readBuffer: UnsafeMutableRawBufferPointer
+    ) throws -> DecodedImage {
+        var buffer: ImageBufferPool.Buffer?
+        let decoder = try PNGStreamDecoder(options: options) { layout in
+            let pooledBuffer = self.bufferPool.take(byteCount: layout.byteCount)
+            buffer = pooledBuffer
+            return unsafe pooledBuffer.pointer
+        }
+
+        unsafe try self.read(url, into: decoder, readBuffer: readBuffer)
+
+        guard let buffer, let layout = decoder.layout else {
+            throw ImageDecodeError.truncatedData
+        }
+        return self.makeDecodedImage(buffer, layout: layout, options: options)
+    }
+
+    /// Pass the file to the decoder by chunks of the read buffer size, until the image end.
+    private func read(
+        _ url: URL,
+        into decoder: PNGStreamDecoder,
+        readBuffer: UnsafeMutableRawBufferPointer
+    ) throws {
+        let isRead = unsafe try FileSystem.current.readFile(at: url, into: readBuffer) { chunk in
+            unsafe try decoder.push(chunk)
+            return !decoder.isFinished
+        }
+        guard isRead else {
+            throw ImageDecodeError.readFailed(url)
+        }
+
+        guard decoder.isFinished else {
+            throw ImageDecodeError.truncatedData
+        }
+    }
+
+    private static func makeReadBuffer(_ options: ImageDecodeOptions) -> UnsafeMutableRawBufferPointer {
+        return unsafe UnsafeMutableRawBufferPointer.allocate(byteCount: max(options.readChunkSize, 1), alignment: 16)
+    }
+
+    /// Wrap levels of the buffer in images without copying pixels.
+    private func makeDecodedImage(
+        _ buffer: ImageBufferPool.Buffer,
+        layout: ImageDecodeLayout,
+        options: ImageDecodeOptions
+    ) -> DecodedImage {
+        let levels = (0..<layout.levelCount).map { level in
+            let range = layout.byteRange(ofLevel: level)
+            let size = layout.size(ofLevel: level)
+            // Levels share the buffer, it returns to the pool after the last of them is released.
+            let data = unsafe Data(
+                bytesNoCopy: buffer.pointer + range.lowerBound,
+                count: range.count,
+                deallocator: .custom { _, _ in
+                    withExtendedLifetime(buffer) {}
+                }
+            )
+            return Image(width: size.width, height: size.height, data: data, format: .rgba8)
+        }
+
+        return DecodedImage(
+            image: levels[0],
+            mipmaps: Array(levels.dropFirst()),
+            isAlphaPremultiplied: options.premultipliesAlpha
+        )
+    }
+}
+
+/// Indices of images not taken by decode workers yet.
+private final class ImageDecodeQueue: @unchecked Sendable {
+    private let lock = NSLock()
+    private let count: Int
+    private var nextIndex = 0
+
+    init(count: Int) {
+        self.count = count
+    }
+
+    /// Returns index of the next image, nil if all images are taken.
+    func next() -> Int? {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard self.nextIndex < self.count else {
+            return nil
+        }
+        defer { self.nextIndex += 1 }
+        return self.nextIndex
+    }
+}
+
+/// Keeps pixel buffers of released images for reuse.
+///
+/// Capacities are rounded up to a page, so images of the same size reuse each other's buffers.
+@safe
+final class ImageBufferPool: @unchecked Sendable {
+
+    /// Memory of decoded pixels, returned to the pool on deinit.
+    @safe
+    final class Buffer: @unchecked Sendable {
+        let pointer: UnsafeMutableRawPointer
+        let capacity: Int
+        private let pool: ImageBufferPool
+
+        fileprivate init(pointer: UnsafeMutableRawPointer, capacity: Int, pool: ImageBufferPool) {
+            unsafe self.pointer = pointer
+            self.capacity = capacity
+            self.pool = pool
+        }
+
+        deinit {
+            unsafe self.pool.recycle(self.pointer, capacity: self.capacity)
+        }
+    }
+
+    private static let pageSize = 4096
+
+    let maxPooledBytes: Int
+
+    private let lock = NSLock()
+    private var freeBuffers: [Int: [UnsafeMutableRawPointer]] = [:]
+    private var pooledBytes = 0
+
+    init(maxPooledBytes: Int) {
+        self.maxPooledBytes = maxPooledBytes
+    }
+
+    deinit {
+        for pointers in unsafe self.freeBuffers.values {
+            for pointer in unsafe pointers {
+                unsafe pointer.deallocate()
+            }
+        }
+    }
+
+    /// Returns a buffer of at least `byteCount` bytes, its memory isn't initialized.
+    func take(byteCount: Int) -> Buffer {
+        let capacity = (max(byteCount, 1) + Self.pageSize - 1) / Self.pageSize * Self.pageSize
+
+        lock.lock()
+        let pointer = unsafe self.freeBuffers[capacity]?.popLast()
+        if unsafe pointer != nil {
+            self.pooledBytes -= capacity
+        }
+        lock.unlock()
+
+        return unsafe Buffer(
+            pointer: pointer ?? UnsafeMutableRawPointer.allocate(byteCount: capacity, alignment: 16),
+            capacity: capacity,
+            pool: self
+        )
+    }
+
+    fileprivate func recycle(_ pointer: UnsafeMutableRawPointer, capacity: Int) {
+        lock.lock()
+        if self.pooledBytes + capacity <= self.maxPooledBytes {
+            unsafe self.freeBuffers[capacity, default: []].append(pointer)
+            self.pooledBytes += capacity
+            lock.unlock()
+            return
+        }
+        lock.unlock()
+
+        unsafe pointer.deallocate()
+    }
+}
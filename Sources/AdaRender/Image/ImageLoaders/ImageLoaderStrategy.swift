@@ -13,4 +13,6 @@ protocol ImageLoaderStrategy: Sendable {
     func canDecodeImage(with fileExtensions: String) -> Bool
     
     func decodeImage(from data: Data) throws -> Image
+
+    func decodeImage(contentsOf file: URL) throws -> Image
 }
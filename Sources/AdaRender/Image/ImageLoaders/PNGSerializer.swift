@@ -6,17 +6,10 @@
 //
 
 import Foundation
-import libpng
 
 /// An object that serialize png raw data to an ``Image``
 struct PNGImageSerializer: ImageLoaderStrategy {
     
-    enum DecodingError: String, Error {
-        case cannotReadFromMemmory
-        case cannotFinishReading
-        case notSupportedImageFormat = "Unsupported png format"
-    }
-    
     // MARK: - ImageLoaderStrategy
     
     func canDecodeImage(with fileExtensions: String) -> Bool {
@@ -24,38 +17,12 @@ struct PNGImageSerializer: ImageLoaderStrategy {
     }
     
     func decodeImage(from data: Data) throws -> Image {
-        var pngImage = unsafe png_image()
-        unsafe pngImage.version = png_uint_32(PNG_IMAGE_VERSION)
-
-        var isSuccess = unsafe data.withUnsafeBytes { bufferPtr in
-            return unsafe png_image_begin_read_from_memory(&pngImage, bufferPtr.baseAddress, data.count) == 1
-        }
-        
-        unsafe pngImage.format = PNG_FORMAT_FLAG_COLOR | PNG_FORMAT_FLAG_ALPHA
-
-        let format: Image.Format = .rgba8
-        
-        if !isSuccess {
-            unsafe png_image_free(&pngImage)
-            throw DecodingError.cannotReadFromMemmory
-        }
-        
-        let stride = unsafe swift_png_image_row_stride(pngImage)
-        var imageBuffer = unsafe Data(count: Int(swift_png_image_buffer_size(pngImage, stride)))
+        // Pixels are decoded right into a pooled buffer, which isn't zero filled first.
+        return try ImageDecodeService.shared.decodeImage(from: data).image
+    }
 
-        isSuccess = unsafe imageBuffer.withUnsafeMutableBytes {
-            unsafe png_image_finish_read(&pngImage, nil, $0.baseAddress, png_int_32(stride), nil) == 1
-        }
-        
-        if !isSuccess {
-            throw DecodingError.cannotFinishReading
-        }
-        
-        return unsafe Image(
-            width: Int(pngImage.width),
-            height: Int(pngImage.height),
-            data: imageBuffer,
-            format: format
-        )
+    func decodeImage(contentsOf file: URL) throws -> Image {
+        // The file is passed to the decoder by chunks while it's read.
+        return try ImageDecodeService.shared.decodeImage(contentsOf: file).image
     }
 }
@@ -0,0 +1,81 @@
+//
+//  PNGStreamDecoder.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import Foundation
+import libpng
+
+/// A progressive PNG decoder that takes bytes as they are read.
+///
+/// Once the header is read, the decoder asks `allocate` for memory of ``ImageDecodeLayout/byteCount`` bytes
+/// and writes RGBA8 rows right into it. Premultiplied alpha and mipmaps are computed while rows arrive.
+@safe
+final class PNGStreamDecoder {
+
+    /// Layout of decoded pixels, nil until the header is read.
+    private(set) var layout: ImageDecodeLayout?
+
+    private let allocate: (ImageDecodeLayout) throws -> UnsafeMutableRawPointer
+    private var allocationError: (any Error)?
+    private var stream: OpaquePointer?
+
+    /// Indicates whether all rows are decoded.
+    var isFinished: Bool {
+        return unsafe swift_png_stream_is_finished(self.stream) == 1
+    }
+
+    init(
+        options: ImageDecodeOptions,
+        allocate: @escaping (ImageDecodeLayout) throws -> UnsafeMutableRawPointer
+    ) throws {
+        unsafe self.allocate = allocate
+
+        var flags: UInt32 = 0
+        if options.premultipliesAlpha {
+            flags |= SWIFT_PNG_STREAM_PREMULTIPLY_ALPHA
+        }
+        if options.generatesMipmaps {
+            flags |= SWIFT_PNG_STREAM_MIPMAPS
+        }
+        if !options.usesSIMD {
+            flags |= SWIFT_PNG_STREAM_NO_SIMD
+        }
+
+        let context = unsafe Unmanaged.passUnretained(self).toOpaque()
+        let stream = unsafe swift_png_stream_create(context, { context, width, height, levelCount, _ in
+            let decoder = unsafe Unmanaged<PNGStreamDecoder>.fromOpaque(context!).takeUnretainedValue()
+            let layout = ImageDecodeLayout(width: Int(width), height: Int(height), levelCount: Int(levelCount))
+            decoder.layout = layout
+
+            do {
+                return unsafe try decoder.allocate(layout)
+            } catch {
+                decoder.allocationError = error
+                return nil
+            }
+        }, flags)
+
+        guard let stream = unsafe stream else {
+            throw ImageDecodeError.outOfMemory
+        }
+        unsafe self.stream = stream
+    }
+
+    deinit {
+        unsafe swift_png_stream_destroy(self.stream)
+    }
+
+    /// Decode the next bytes of the file. Bytes after the image end are ignored.
+    func push(_ bytes: UnsafeRawBufferPointer) throws {
+        guard unsafe swift_png_stream_push(self.stream, bytes.baseAddress, bytes.count) == 1 else {
+            if let allocationError = self.allocationError {
+                throw allocationError
+            }
+            let message = unsafe String(cString: swift_png_stream_error_message(self.stream))
+            throw ImageDecodeError.invalidData(message)
+        }
+    }
+}
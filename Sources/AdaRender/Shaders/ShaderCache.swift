@@ -8,335 +8,433 @@
 import AdaUtils
 import Foundation
 import Logging
-#if !WASM
-@unsafe @preconcurrency import Yams
-#endif
 
-/// Contains information about shader changes and store/load spirv binary in cache folder.
+/// Contains information about shader changes and store/load spirv binary in the shader cache archive.
+///
+/// Entries are addressed by content: a SHA-256 digest of the stage source, defines version, stage, language,
+/// include search paths and ``Constants/compilerVersion``. Compiled entries are additionally keyed by
+/// the include closure of the last compilation, so editing an included file invalidates only shaders that include it.
 enum ShaderCache {
 
-    private typealias Cache = [String : [ShaderStage : ShaderCache]]
-    
-    struct ShaderCache: Equatable, Codable {
-        let sourceHashValue: Int
-        let headers: [ShaderSource.IncludeSearchPath]
-        let version: Int
-    }
-
     private static let fileSystem = FileSystem.current
     private static let logger = Logger(label: "org.adaengine.shader-cache")
 
-    static func hasChanges(for source: ShaderSource, version: Int) -> Set<ShaderStage> {
-        guard let cacheKey = source.fileURL?.relativeString else {
-            return []
+    private static let archiveURL: URL = {
+        let cacheDirectory: URL
+        do {
+            cacheDirectory = try self.getCacheDirectory()
+            if !fileSystem.itemExists(at: cacheDirectory) {
+                try fileSystem.createDirectory(at: cacheDirectory, withIntermediateDirectories: true)
+            }
+        } catch {
+            logger.error("Failed to create shader cache directory: \(error)")
+            cacheDirectory = FileManager.default.temporaryDirectory
         }
-        
-        var cacheData = self.getCacheData()
-        let cache = cacheData[cacheKey]
-        
+
+        return cacheDirectory.appending(path: Constants.archiveFileName, directoryHint: .notDirectory)
+    }()
+
+    private static let archive = ShaderCacheArchive(fileURL: archiveURL)
+
+    private static let lock = NSLock()
+    /// Include closures already checked against files, keyed by source digest.
+    nonisolated(unsafe) private static var validatedIncludes: [SHA256Digest: ValidatedIncludes] = [:]
+
+    /// Returns stages which weren't compiled from the current source and content of included files.
+    ///
+    /// Stage stays changed until its compiled SPIR-V is stored with ``save(_:source:stage:version:includeSearchPaths:)``.
+    /// - Parameter includeSearchPaths: Search paths of the compiler, the source search paths if nil.
+    static func hasChanges(
+        for source: ShaderSource,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
+    ) -> Set<ShaderStage> {
         var changedValues: Set<ShaderStage> = []
 
         for stage in source.stages {
-            guard let shaderSource = source.getSource(for: stage) else {
+            guard let sourceDigest = self.sourceDigest(
+                for: source,
+                stage: stage,
+                version: version,
+                includeSearchPaths: includeSearchPaths
+            ) else {
                 continue
             }
-            
-            let shaderCache = ShaderCache(
-                sourceHashValue: shaderSource.uniqueHashValue,
-                headers: source.includeSearchPaths,
-                version: version
-            )
-            
-            if cache == nil || (cache?[stage] != shaderCache) {
+
+            if self.getValidIncludes(for: sourceDigest) == nil {
                 changedValues.insert(stage)
-                cacheData[cacheKey, default: [:]][stage] = shaderCache
-                
-                Self.removeReflection(for: source.fileURL!, stage: stage)
             }
         }
-        
-        if !changedValues.isEmpty {
-            self.saveCacheData(cacheData)
-        }
-        
+
         return changedValues
     }
-    
+
     // MARK: Save/Load SPIRV
 
     static func getCachedDeviceCompiledShader(
         for source: ShaderSource,
-        stage: ShaderStage
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
     ) -> DeviceCompiledShader? {
-        guard let fileURL = source.fileURL else {
+        guard let data = self.entry(
+            .deviceCompiledShader,
+            for: source,
+            stage: stage,
+            version: version,
+            includeSearchPaths: includeSearchPaths
+        ) else {
             return nil
         }
-        
-        let path = fileURL.prepareCachePath
-        
+
         do {
-            let cacheDir = try self.getCacheDirectory()
-            let cacheFile = cacheDir
-                .appending(path: path, directoryHint: .isDirectory)
-                .appending(path: "cache-\(stage.rawValue).device-compiled-shader.\(Constants.shaderCacheFileExtension)", directoryHint: .notDirectory)
-            guard let data = fileSystem.readFile(at: cacheFile) else {
-                return nil
-            }
-            #if WASM
             return try JSONDecoder().decode(DeviceCompiledShader.self, from: data)
-            #else
-            return try YAMLDecoder().decode(DeviceCompiledShader.self, from: data)
-            #endif
         } catch {
             logger.error("Failed to get cached device compiled shader: \(error)")
             return nil
-        } 
+        }
     }
-    
+
     static func getCachedShader(
         for source: ShaderSource,
         stage: ShaderStage,
         version: Int,
-        entryPoint: String
+        entryPoint: String,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
     ) -> SpirvBinary? {
-        guard let fileURL = source.fileURL else {
+        guard
+            let module = self.entry(.spirv, for: source, stage: stage, version: version, includeSearchPaths: includeSearchPaths),
+            let names = self.entry(.spirvNames, for: source, stage: stage, version: version, includeSearchPaths: includeSearchPaths)
+        else {
             return nil
         }
-        
-        let path = fileURL.prepareCachePath
-        
+
+        let data: Data
         do {
-            let cacheFile = try self.getCacheDirectory()
-                .appending(path: path, directoryHint: .isDirectory)
-                .appendingPathExtension("cache-\(stage.rawValue)-\(version).spv")
-            guard let data = fileSystem.readFile(at: cacheFile) else {
-                return nil
-            }
-            return SpirvBinary(
-                stage: stage,
-                data: data,
-                language: source.language,
-                entryPoint: entryPoint,
-                version: version
-            )
+            data = try SpirvBinary.restoringNames(names, in: module)
         } catch {
-            logger.error("Failed to get cached device compiled shader: \(error)")
+            logger.error("Failed to restore cached spirv names: \(error)")
             return nil
         }
+
+        return SpirvBinary(
+            stage: stage,
+            data: data,
+            language: source.language,
+            entryPoint: entryPoint,
+            version: version
+        )
     }
-    
+
     static func save(
         _ spirvBin: SpirvBinary,
         source: ShaderSource,
         stage: ShaderStage,
-        version: Int
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
     ) throws {
-        guard let fileURL = source.fileURL else {
-            throw CompileError.failed("Source file URL not found")
+        guard let sourceDigest = self.sourceDigest(
+            for: source,
+            stage: stage,
+            version: version,
+            includeSearchPaths: includeSearchPaths
+        ) else {
+            throw CompileError.failed("Source for stage `\(stage.rawValue)` not found")
         }
-        
-        let path = fileURL.prepareCachePath
-        
-        let cacheDir = try self.getCacheDirectory()
-        
-        let cacheURL = cacheDir
-            .appending(path: path, directoryHint: .isDirectory)
-
-        if !fileSystem.itemExists(at: cacheURL) {
-            try fileSystem.createDirectory(at: cacheURL, withIntermediateDirectories: true)
-        }
-            
-        let cacheFile = cacheURL
-            .appending(path: "cache-\(stage.rawValue)-\(version).spv", directoryHint: .notDirectory)
-        _ = fileSystem.createFile(at: cacheFile, contents: spirvBin.data)
+
+        // Debug names are stored separately, so the module itself is smaller and compresses better.
+        let (module, names) = try spirvBin.compacted()
+        let buildDigest = self.buildDigest(sourceDigest, includes: spirvBin.includes)
+
+        // Include closure goes first, compiled entries are keyed by it.
+        // Included files are checked again on the next lookup, they may have changed after compilation.
+        self.saveIncludes(spirvBin.includes, for: sourceDigest)
+        self.setValidIncludes(nil, for: sourceDigest)
+        try self.archive.write(names, for: ShaderCacheArchive.Key(digest: buildDigest, kind: .spirvNames))
+        try self.archive.write(module, for: ShaderCacheArchive.Key(digest: buildDigest, kind: .spirv))
     }
-    
+
     // MARK: - Save/Load Reflection
-    
+
+    /// Save reflection blob produced by ``SpirvCompiler/reflectionBlob()``.
     static func saveReflection(
-        _ reflectionData: ShaderReflectionData,
+        _ reflectionBlob: Data,
         for source: ShaderSource,
-        stage: ShaderStage
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
     ) throws {
-        guard reflectionData.isEmpty == false else {
-            return
-        }
-        
-        guard let fileURL = source.fileURL else {
-            return
-        }
-        
-        let path = fileURL.prepareCachePath
-        
-        let cacheDir = try self.getCacheDirectory()
-        
-        let cacheURL = cacheDir
-            .appending(path: path, directoryHint: .isDirectory)
-
-        if !fileSystem.itemExists(at: cacheURL) {
-            try fileSystem.createDirectory(at: cacheURL, withIntermediateDirectories: true)
-        }
-
-        let cacheFile = cacheURL
-            .appending(path: "cache-\(stage.rawValue).\(Constants.shaderCacheFileExtension)", directoryHint: .notDirectory)
-        
-        #if WASM
-        let stringData = try JSONEncoder().encode(reflectionData)
-        _ = fileSystem.createFile(at: cacheFile, contents: stringData)
-        #else
-        let stringData = try YAMLEncoder().encode(reflectionData)
-        _ = fileSystem.createFile(at: cacheFile, contents: stringData.data(using: .utf8)!)
-        #endif
+        try self.saveEntry(
+            reflectionBlob,
+            kind: .reflection,
+            for: source,
+            stage: stage,
+            version: version,
+            includeSearchPaths: includeSearchPaths
+        )
     }
 
     static func saveDeviceCompiledShader(
         _ compiledShader: DeviceCompiledShader,
         for source: ShaderSource,
-        stage: ShaderStage
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
     ) throws {
-        guard let fileURL = source.fileURL else {
-            throw CompileError.failed("Source file URL not found")
+        try self.saveEntry(
+            JSONEncoder().encode(compiledShader),
+            kind: .deviceCompiledShader,
+            for: source,
+            stage: stage,
+            version: version,
+            includeSearchPaths: includeSearchPaths
+        )
+    }
+
+    static func getReflection(
+        for source: ShaderSource,
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]? = nil
+    ) -> ShaderReflectionData? {
+        guard let data = self.entry(
+            .reflection,
+            for: source,
+            stage: stage,
+            version: version,
+            includeSearchPaths: includeSearchPaths
+        ) else {
+            return nil
         }
-        
-        let path = fileURL.prepareCachePath
-        
-        let cacheDir = try self.getCacheDirectory()
 
-        let cacheURL = cacheDir
-            .appending(path: path, directoryHint: .isDirectory)
+        do {
+            return try ShaderReflectionData(reflectionBlob: data, stage: stage)
+        } catch {
+            logger.error("Failed to get cached reflection: \(error)")
+            return nil
+        }
+    }
 
-        if !fileSystem.itemExists(at: cacheURL) {
-            try fileSystem.createDirectory(at: cacheURL, withIntermediateDirectories: true)
+    // MARK: - Include Dependencies
+
+    /// Same 64-bit FNV-1a hash as used by SPIRVCompiler for included files.
+    static func contentHash(of data: Data) -> UInt64 {
+        var hash: UInt64 = 14695981039346656037
+        for byte in data {
+            hash ^= UInt64(byte)
+            hash = hash &* 1099511628211
         }
-        
-        let cacheFile = cacheURL
-            .appending(path: "cache-\(stage.rawValue).device-compiled-shader.\(Constants.shaderCacheFileExtension)", directoryHint: .notDirectory)
-        
-        #if WASM
-        let stringData = try JSONEncoder().encode(compiledShader)
-        _ = fileSystem.createFile(at: cacheFile, contents: stringData)
-        #else
-        let stringData = try YAMLEncoder().encode(compiledShader)
-        _ = fileSystem.createFile(at: cacheFile, contents: stringData.data(using: .utf8)!)
-        #endif
-
-        let shaderFileForTest = cacheURL
-            .appending(path: "cache-\(stage.rawValue).shader-source.\(Constants.shaderCacheFileExtension)", directoryHint: .notDirectory)
-        _ = fileSystem.createFile(at: shaderFileForTest, contents: compiledShader.source.data(using: .utf8)!)
+        return hash
     }
-    
-    static func getReflection(for source: ShaderSource, stage: ShaderStage) -> ShaderReflectionData? {
-        guard let fileURL = source.fileURL else {
+
+    private static func getIncludes(for sourceDigest: SHA256Digest) -> [ShaderIncludeDependency]? {
+        guard let data = self.archive.entry(for: ShaderCacheArchive.Key(digest: sourceDigest, kind: .manifest)) else {
             return nil
         }
-        
-        let path = fileURL.prepareCachePath
+
+        return try? JSONDecoder().decode([ShaderIncludeDependency].self, from: data)
+    }
+
+    private static func saveIncludes(_ includes: [ShaderIncludeDependency], for sourceDigest: SHA256Digest) {
+        guard self.getIncludes(for: sourceDigest) != includes else {
+            return
+        }
 
         do {
-            let cacheFile = try self.getCacheDirectory()
-                .appending(path: path, directoryHint: .isDirectory)
-                .appending(path: "cache-\(stage.rawValue).\(Constants.shaderCacheFileExtension)", directoryHint: .notDirectory)
-            guard let data = fileSystem.readFile(at: cacheFile) else {
-                return nil
-            }
-            #if WASM
-            return try JSONDecoder().decode(ShaderReflectionData.self, from: data)
-            #else
-            return try YAMLDecoder().decode(ShaderReflectionData.self, from: data)
-            #endif
+            try self.archive.write(
+                JSONEncoder().encode(includes),
+                for: ShaderCacheArchive.Key(digest: sourceDigest, kind: .manifest)
+            )
         } catch {
-            logger.error("Failed to get cached reflection: \(error)")
+            logger.error("Failed to save shader includes: \(error)")
+        }
+    }
+
+    /// Returns stored include closure of the source if none of included files was changed or removed.
+    ///
+    /// Files are read and hashed once, later lookups only compare their modification dates and sizes.
+    private static func getValidIncludes(for sourceDigest: SHA256Digest) -> [ShaderIncludeDependency]? {
+        lock.lock()
+        let validated = self.validatedIncludes[sourceDigest]
+        lock.unlock()
+
+        if let validated, validated.stamps == self.fileStamps(of: validated.includes) {
+            return validated.includes
+        }
+
+        guard let includes = self.getIncludes(for: sourceDigest) else {
+            self.setValidIncludes(nil, for: sourceDigest)
             return nil
         }
+
+        // Stamps are taken before files are hashed, so an edit made meanwhile is seen on the next lookup.
+        let stamps = self.fileStamps(of: includes)
+        guard !self.hasIncludeChanges(includes) else {
+            self.setValidIncludes(nil, for: sourceDigest)
+            return nil
+        }
+
+        self.setValidIncludes(ValidatedIncludes(includes: includes, stamps: stamps), for: sourceDigest)
+        return includes
     }
-    
-    static func removeReflection(for fileURL: URL, stage: ShaderStage) {
-        let path = fileURL.prepareCachePath
-        
-        do {
-            let cacheFile = try self.getCacheDirectory()
-                .appending(path: path, directoryHint: .isDirectory)
-                .appending(path: "cache-\(stage.rawValue).\(Constants.shaderCacheFileExtension)", directoryHint: .notDirectory)
-            
-            guard fileSystem.itemExists(at: cacheFile) else {
-                return
-            }
-            
-            try fileSystem.removeItem(at: cacheFile)
-        } catch {
-            logger.error("Failed to remove cached reflection: \(error)")
+
+    private static func setValidIncludes(_ validated: ValidatedIncludes?, for sourceDigest: SHA256Digest) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        self.validatedIncludes[sourceDigest] = validated
+    }
+
+    /// Modification dates and sizes of included files, nil for files that can't be read.
+    private static func fileStamps(of includes: [ShaderIncludeDependency]) -> [FileStamp?] {
+        return includes.map { include in
+            let values = try? URL(fileURLWithPath: include.path)
+                .resourceValues(forKeys: [.contentModificationDateKey, .fileSizeKey])
+            return values.map { FileStamp(modificationDate: $0.contentModificationDate, size: $0.fileSize) }
+        }
+    }
+
+    /// Returns true if any of included files was changed or removed.
+    private static func hasIncludeChanges(_ includes: [ShaderIncludeDependency]) -> Bool {
+        return includes.contains { include in
+            let contentHash = self.fileSystem
+                .readFile(at: URL(fileURLWithPath: include.path))
+                .map { self.contentHash(of: $0) }
+            return contentHash != include.contentHash
         }
     }
-    
+
     // MARK: - Private
-    
-    private static func getCacheData() -> Cache {
-        self.createCacheDirectoryIfNeeded()
-        
-        do {
-            let cacheFile = try getCacheFile()
-            guard let data = fileSystem.readFile(at: cacheFile) else {
-                return [:]
+
+    /// Digest of everything that affects compilation, except included files.
+    private static func sourceDigest(
+        for source: ShaderSource,
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]?
+    ) -> SHA256Digest? {
+        guard let stageSource = source.getSource(for: stage) else {
+            return nil
+        }
+
+        var hasher = SHA256Hasher()
+        hasher.combine(Constants.compilerVersion)
+        hasher.combine(source.language.rawValue)
+        hasher.combine(stage.rawValue)
+        hasher.combine(version)
+        hasher.combine(stageSource)
+
+        for include in includeSearchPaths ?? source.includeSearchPaths {
+            switch include {
+            case ._local(let url):
+                hasher.combine(url.path)
+            case ._module(let moduleName, let url):
+                hasher.combine(moduleName)
+                hasher.combine(url.path)
             }
-            
-            #if WASM
-            return try JSONDecoder().decode(Cache.self, from: data)
-            #else
-            return try YAMLDecoder().decode(Cache.self, from: data)
-            #endif
-        } catch {
-            fatalError("[ShaderCache] \(error)")
         }
+
+        return hasher.finalize()
     }
-    
-    private static func saveCacheData(_ cacheData: Cache) {
-        self.createCacheDirectoryIfNeeded()
-        
-        do {
-            let cacheFile = try getCacheFile()
-            #if WASM
-            let data = try JSONEncoder().encode(cacheData)
-            _ = fileSystem.createFile(at: cacheFile, contents: data)
-            #else
-            let string = try YAMLEncoder().encode(cacheData)
-            _ = fileSystem.createFile(at: cacheFile, contents: string.data(using: .utf8)!)
-            #endif
-        } catch {
-            fatalError("[ShaderCache] \(error)")
+
+    /// Digest of the source together with content of the included files.
+    private static func buildDigest(_ sourceDigest: SHA256Digest, includes: [ShaderIncludeDependency]) -> SHA256Digest {
+        var hasher = SHA256Hasher()
+        hasher.combine(sourceDigest.word0)
+        hasher.combine(sourceDigest.word1)
+        hasher.combine(sourceDigest.word2)
+        hasher.combine(sourceDigest.word3)
+
+        for include in includes {
+            hasher.combine(include.path)
+            hasher.combine(include.contentHash)
+        }
+
+        return hasher.finalize()
+    }
+
+    /// Returns entry compiled from the current source and current content of included files.
+    private static func entry(
+        _ kind: ShaderCacheArchive.EntryKind,
+        for source: ShaderSource,
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]?
+    ) -> Data? {
+        guard
+            let sourceDigest = self.sourceDigest(
+                for: source,
+                stage: stage,
+                version: version,
+                includeSearchPaths: includeSearchPaths
+            ),
+            let includes = self.getValidIncludes(for: sourceDigest)
+        else {
+            return nil
         }
+
+        return self.archive.entry(
+            for: ShaderCacheArchive.Key(digest: self.buildDigest(sourceDigest, includes: includes), kind: kind)
+        )
     }
-    
+
+    private static func saveEntry(
+        _ data: Data,
+        kind: ShaderCacheArchive.EntryKind,
+        for source: ShaderSource,
+        stage: ShaderStage,
+        version: Int,
+        includeSearchPaths: [ShaderSource.IncludeSearchPath]?
+    ) throws {
+        guard
+            let sourceDigest = self.sourceDigest(
+                for: source,
+                stage: stage,
+                version: version,
+                includeSearchPaths: includeSearchPaths
+            ),
+            let includes = self.getValidIncludes(for: sourceDigest)
+        else {
+            return
+        }
+
+        try self.archive.write(
+            data,
+            for: ShaderCacheArchive.Key(digest: self.buildDigest(sourceDigest, includes: includes), kind: kind)
+        )
+    }
+
+    /// Rewrite the archive without records overwritten by later compilations.
+    /// - Returns: Number of records left in the archive.
+    @discardableResult
+    static func compact() throws -> Int {
+        return try ShaderCacheArchive.compact(at: self.archiveURL)
+    }
+
     static func getCacheDirectory() throws -> URL {
         return try self.fileSystem
             .url(for: .cachesDirectory)
             .appendingPathComponent(Constants.cacheDirectoryName)
             .appending(path: Constants.shadersDirectoryName, directoryHint: .isDirectory)
     }
-    
-    private static func getCacheFile() throws -> URL {
-        try self.getCacheDirectory().appending(path: Constants.shaderCacheFileName, directoryHint: .notDirectory)
-    }
-    
-    private static func createCacheDirectoryIfNeeded() {
-        do {
-            let cacheDir = try getCacheDirectory()
-            
-            if fileSystem.itemExists(at: cacheDir) {
-                return
-            }
-            
-            return try fileSystem.createDirectory(at: cacheDir, withIntermediateDirectories: true)
-        } catch {
-            fatalError("[ShaderCache] \(error)")
-        }
-    }
 
     enum Constants {
         static let cacheDirectoryName = "AdaEngine"
         static let shadersDirectoryName = "Shaders"
-        static let shaderCacheFileName = "ShaderCache.cache"
-        static let shaderCacheFileExtension = "yaml"
-        static let separator = "/"
+        static let archiveFileName = "ShaderCache.archive"
+        /// Bump when compiler output changes, to invalidate all cached entries.
+        static let compilerVersion: UInt32 = 3
+    }
+
+    private struct ValidatedIncludes {
+        let includes: [ShaderIncludeDependency]
+        /// Stamps of included files when their content was checked.
+        let stamps: [FileStamp?]
+    }
+
+    private struct FileStamp: Equatable {
+        let modificationDate: Date?
+        let size: Int?
     }
 
     enum CompileError: LocalizedError {
@@ -350,9 +448,3 @@ enum ShaderCache {
         }
     }
 }
-
-private extension URL {
-    var prepareCachePath: String {
-        return self.pathComponents.suffix(3).joined(separator: ShaderCache.Constants.separator).replacingOccurrences(of: ".bundle", with: "")
-    }
-}
@@ -0,0 +1,349 @@
+//
+//  ShaderCacheArchive.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaUtils
+import Foundation
+
+/// Single file, append-only storage for shader cache entries addressed by content hash.
+///
+/// The archive is memory mapped on open and every record is indexed by its key,
+/// so a cache hit is a dictionary lookup into mapped memory without file system calls.
+///
+/// Layout:
+/// ```
+/// Header: magic (8 bytes) | format version (UInt32) | reserved (UInt32)
+/// Record: magic (UInt32) | kind (UInt8) | padding (3 bytes) | payload length (UInt32) | reserved (UInt32)
+///         | key digest (32 bytes) | payload checksum (UInt64) | payload | padding to 8 bytes
+/// ```
+/// All integers are little-endian. If the same key was written several times, the last record wins.
+/// Incomplete or broken records at the end of the file (for example, after a crash during write) are ignored
+/// and overwritten by the next write. Stale records are removed only by ``compact(at:keeping:)``.
+///
+/// Several processes may share the archive. Appends take an exclusive `flock` on the file,
+/// and records appended by other processes are picked up before the next write.
+/// Writers that were waiting for the lock while the file was replaced by compaction reopen the new file.
+final class ShaderCacheArchive: @unchecked Sendable {
+
+    enum EntryKind: UInt8 {
+        /// Include closure of the last compiled shader.
+        case manifest = 1
+        case spirv = 2
+        case reflection = 3
+        case deviceCompiledShader = 4
+        /// Names stripped from the compact SPIR-V module.
+        case spirvNames = 5
+    }
+
+    struct Key: Hashable {
+        let digest: SHA256Digest
+        let kind: EntryKind
+    }
+
+    enum Constants {
+        static let magic: [UInt8] = Array("ADASHCA\0".utf8)
+        static let formatVersion: UInt32 = 1
+        static let headerSize = 16
+        static let recordMagic: UInt32 = 0x52_43_48_53 // "SHCR"
+        static let recordHeaderSize = 56
+        static let alignment = 8
+    }
+
+    let fileURL: URL
+
+    private let lock = NSLock()
+    private var mappedData: Data
+    /// File which is mapped, nil if it didn't exist.
+    private var mappedFileID: FileID?
+    private var index: [Key: Range<Int>] = [:]
+    /// Records written after the archive was mapped.
+    private var writtenEntries: [Key: Data] = [:]
+    private var verifiedKeys: Set<Key> = []
+    /// End of the last valid record in the file.
+    private var validLength: Int
+    private var recordsCount: Int
+
+    /// Number of records overwritten by later records with the same key.
+    var staleRecordsCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return self.recordsCount - self.index.count
+    }
+
+    /// Open archive at given url. Missing or unreadable archive is treated as empty.
+    init(fileURL: URL) {
+        self.fileURL = fileURL
+
+        let fileID = Self.fileID(at: fileURL)
+        let data = (try? Data(contentsOf: fileURL, options: .alwaysMapped)) ?? Data()
+        let (index, validLength, recordsCount) = Self.readIndex(from: data)
+        self.mappedData = data
+        self.mappedFileID = fileID
+        self.index = index
+        self.validLength = validLength
+        self.recordsCount = recordsCount
+    }
+
+    /// Returns payload for the key or nil if entry doesn't exist or broken.
+    func entry(for key: Key) -> Data? {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if let data = self.writtenEntries[key] {
+            return data
+        }
+
+        guard let range = self.index[key] else {
+            return nil
+        }
+
+        let payload = self.mappedData[range]
+
+        // Checksum is verified once, on the first access.
+        if !self.verifiedKeys.contains(key) {
+            guard Self.checksum(of: payload) == Self.readInteger(UInt64.self, from: self.mappedData, at: range.lowerBound - 8) else {
+                self.index[key] = nil
+                return nil
+            }
+            self.verifiedKeys.insert(key)
+        }
+
+        return payload
+    }
+
+    /// Append entry to the archive.
+    func write(_ payload: Data, for key: Key) throws {
+        let record = Self.makeRecord(payload, for: key)
+
+        lock.lock()
+        defer { lock.unlock() }
+
+        let handle = try Self.openLocked(self.fileURL)
+        defer {
+            try? handle.close()
+        }
+
+        let fileLength = Int(try handle.seekToEnd())
+        if fileLength != self.validLength || Self.fileID(of: handle.fileDescriptor) != self.mappedFileID {
+            // Another process appended records, compacted the archive or the file has a broken tail.
+            self.remap()
+        }
+
+        if self.validLength == 0 {
+            var header = Data(Constants.magic)
+            Self.append(Constants.formatVersion, to: &header)
+            Self.append(UInt32(0), to: &header)
+            try handle.truncate(atOffset: 0)
+            try handle.write(contentsOf: header)
+            self.validLength = Constants.headerSize
+        } else if self.validLength < fileLength {
+            try handle.truncate(atOffset: UInt64(self.validLength))
+        }
+
+        try handle.seek(toOffset: UInt64(self.validLength))
+        try handle.write(contentsOf: record)
+        self.validLength += record.count
+        self.recordsCount += 1
+        self.writtenEntries[key] = payload
+    }
+
+    // MARK: - Compaction
+
+    /// Rewrite archive keeping only the last record for each key.
+    ///
+    /// Compacted archive replaces the file atomically under the file lock. Writers waiting for the lock
+    /// find that the path points to a new file and append to it, so records of other processes aren't lost.
+    /// Archives opened before compaction keep reading the old file and remap on the next write.
+    ///
+    /// Compaction rewrites the whole file, run it offline instead of on every launch.
+    /// - Parameter isAlive: Return false to drop records for the key.
+    /// - Returns: Number of records in compacted archive.
+    @discardableResult
+    static func compact(at fileURL: URL, keeping isAlive: (Key) -> Bool = { _ in true }) throws -> Int {
+        let handle = try Self.openLocked(fileURL)
+        defer {
+            try? handle.close()
+        }
+
+        let data = try Data(contentsOf: fileURL, options: .alwaysMapped)
+        let (index, _, _) = Self.readIndex(from: data)
+
+        var compacted = Data(Constants.magic)
+        Self.append(Constants.formatVersion, to: &compacted)
+        Self.append(UInt32(0), to: &compacted)
+
+        var count = 0
+        // Sort records by offset to keep the original write order.
+        for (key, range) in index.sorted(by: { $0.value.lowerBound < $1.value.lowerBound }) where isAlive(key) {
+            let payload = data[range]
+            guard Self.checksum(of: payload) == Self.readInteger(UInt64.self, from: data, at: range.lowerBound - 8) else {
+                continue
+            }
+            compacted.append(Self.makeRecord(payload, for: key))
+            count += 1
+        }
+
+        try compacted.write(to: fileURL, options: .atomic)
+        return count
+    }
+
+    // MARK: - Private
+
+    /// Open the file for writing and take an exclusive lock on it, the lock is released when the handle is closed.
+    ///
+    /// Compaction may replace the file while we wait for the lock,
+    /// in that case the lock is taken again on the file the path points to.
+    private static func openLocked(_ fileURL: URL) throws -> FileHandle {
+        while true {
+            let descriptor = open(fileURL.path, O_RDWR | O_CREAT, 0o644)
+            guard descriptor >= 0 else {
+                throw POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+            }
+
+            let handle = FileHandle(fileDescriptor: descriptor, closeOnDealloc: true)
+            #if !WASM
+            guard flock(descriptor, LOCK_EX) == 0 else {
+                let error = POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+                try? handle.close()
+                throw error
+            }
+
+            guard let fileID = Self.fileID(of: descriptor), fileID == Self.fileID(at: fileURL) else {
+                try? handle.close()
+                continue
+            }
+            #endif
+
+            return handle
+        }
+    }
+
+    /// Identity of a file, which changes when the file is replaced.
+    private struct FileID: Equatable {
+        let device: UInt64
+        let inode: UInt64
+
+        init(_ info: stat) {
+            self.device = UInt64(truncatingIfNeeded: info.st_dev)
+            self.inode = UInt64(truncatingIfNeeded: info.st_ino)
+        }
+    }
+
+    private static func fileID(of descriptor: Int32) -> FileID? {
+        var info = stat()
+        guard unsafe fstat(descriptor, &info) == 0 else {
+            return nil
+        }
+        return FileID(info)
+    }
+
+    private static func fileID(at fileURL: URL) -> FileID? {
+        var info = stat()
+        guard unsafe stat(fileURL.path, &info) == 0 else {
+            return nil
+        }
+        return FileID(info)
+    }
+
+    /// Map the file again to see records written by other processes. Caller holds the lock.
+    private func remap() {
+        let fileID = Self.fileID(at: self.fileURL)
+        let data = (try? Data(contentsOf: self.fileURL, options: .alwaysMapped)) ?? Data()
+        let (index, validLength, recordsCount) = Self.readIndex(from: data)
+        self.mappedData = data
+        self.mappedFileID = fileID
+        self.index = index
+        self.validLength = validLength
+        self.recordsCount = recordsCount
+        self.writtenEntries = [:]
+        self.verifiedKeys = []
+    }
+
+    private static func readIndex(from data: Data) -> (index: [Key: Range<Int>], validLength: Int, recordsCount: Int) {
+        guard
+            data.count >= Constants.headerSize,
+            data.prefix(Constants.magic.count).elementsEqual(Constants.magic),
+            Self.readInteger(UInt32.self, from: data, at: Constants.magic.count) == Constants.formatVersion
+        else {
+            return ([:], 0, 0)
+        }
+
+        var index: [Key: Range<Int>] = [:]
+        var offset = Constants.headerSize
+        var recordsCount = 0
+
+        while offset + Constants.recordHeaderSize <= data.count {
+            guard
+                Self.readInteger(UInt32.self, from: data, at: offset) == Constants.recordMagic,
+                let kind = EntryKind(rawValue: data[offset + 4])
+            else {
+                break
+            }
+
+            let payloadLength = Int(Self.readInteger(UInt32.self, from: data, at: offset + 8))
+            let payloadStart = offset + Constants.recordHeaderSize
+            let recordEnd = Self.aligned(payloadStart + payloadLength)
+            guard recordEnd <= data.count else {
+                break
+            }
+
+            let digest = SHA256Digest(
+                word0: Self.readInteger(UInt64.self, from: data, at: offset + 16),
+                word1: Self.readInteger(UInt64.self, from: data, at: offset + 24),
+                word2: Self.readInteger(UInt64.self, from: data, at: offset + 32),
+                word3: Self.readInteger(UInt64.self, from: data, at: offset + 40)
+            )
+
+            index[Key(digest: digest, kind: kind)] = payloadStart..<(payloadStart + payloadLength)
+            offset = recordEnd
+            recordsCount += 1
+        }
+
+        return (index, offset, recordsCount)
+    }
+
+    private static func makeRecord(_ payload: Data, for key: Key) -> Data {
+        var record = Data()
+        record.reserveCapacity(Self.aligned(Constants.recordHeaderSize + payload.count))
+
+        Self.append(Constants.recordMagic, to: &record)
+        record.append(contentsOf: [key.kind.rawValue, 0, 0, 0])
+        Self.append(UInt32(payload.count), to: &record)
+        Self.append(UInt32(0), to: &record)
+        Self.append(key.digest.word0, to: &record)
+        Self.append(key.digest.word1, to: &record)
+        Self.append(key.digest.word2, to: &record)
+        Self.append(key.digest.word3, to: &record)
+        Self.append(Self.checksum(of: payload), to: &record)
+        record.append(payload)
+        record.append(contentsOf: repeatElement(0, count: Self.aligned(record.count) - record.count))
+
+        return record
+    }
+
+    private static func checksum(of payload: Data) -> UInt64 {
+        return ShaderCache.contentHash(of: payload)
+    }
+
+    private static func aligned(_ value: Int) -> Int {
+        return (value + Constants.alignment - 1) & ~(Constants.alignment - 1)
+    }
+
+    private static func append<T: FixedWidthInteger>(_ value: T, to data: inout Data) {
+        var value = value.littleEndian
+        unsafe withUnsafeBytes(of: &value) { bytes in
+            unsafe data.append(contentsOf: bytes)
+        }
+    }
+
+    /// Read little-endian integer at the offset.
+    private static func readInteger<T: FixedWidthInteger>(_ type: T.Type, from data: Data, at offset: Int) -> T {
+        return unsafe data.withUnsafeBytes { bytes in
+            unsafe T(littleEndian: bytes.loadUnaligned(fromByteOffset: offset, as: T.self))
+        }
+    }
+}
@@ -7,7 +7,7 @@ struct GLSLangShaderCompiler: ShaderDeviceCompilerEngine {
         stage: ShaderStage, 
         defines: [ShaderDefine]
     ) async throws -> DeviceCompiledShader {
-        let spirvCompiler = try SpirvCompiler(spriv: spirvData, stage: stage, deviceLang: .deviceLang)
+        let spirvCompiler = SpirvCompiler(spriv: spirvData, stage: stage, deviceLang: .deviceLang)
         spirvCompiler.renameEntryPoint(entryPoint)
         return try spirvCompiler.compile()
     }
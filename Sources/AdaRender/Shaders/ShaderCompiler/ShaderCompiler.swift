@@ -36,7 +36,14 @@ protocol ShaderDeviceCompilerEngine: Sendable {
 }
 
 // TODO: Should we invert y-axis for vertex shader?
-// TODO: We should remove cached shaders if their included content will change.
+
+/// File included by a shader during compilation.
+struct ShaderIncludeDependency: Equatable, Codable, Sendable {
+    /// Resolved path to the included file.
+    let path: String
+    /// FNV-1a hash of the file content at the compile time.
+    let contentHash: UInt64
+}
 
 struct SpirvBinary {
     let stage: ShaderStage
@@ -44,6 +51,64 @@ struct SpirvBinary {
     let language: ShaderLanguage
     let entryPoint: String
     let version: Int
+    /// Transitive closure of files included by the shader.
+    var includes: [ShaderIncludeDependency] = []
+}
+
+extension SpirvBinary {
+    /// Returns module without debug instructions and a side table with names stripped from it.
+    ///
+    /// Compact module is used for storage only, restore names with ``restoringNames(_:in:)`` before reflection.
+    func compacted() throws -> (module: Data, names: Data) {
+        var error: UnsafePointer<CChar>?
+        let binary = unsafe self.data.withUnsafeBytes { bytes in
+            unsafe spirv_remap(bytes.baseAddress, UInt(bytes.count), SPIRV_REMAP_STRIP.rawValue, &error)
+        }
+        defer {
+            unsafe spirv_bin_free(binary)
+        }
+
+        if let error = unsafe error {
+            throw unsafe ShaderCompiler.CompileError.failed(String(cString: error))
+        }
+
+        return unsafe (
+            Data(bytes: binary.bytes!, count: Int(binary.length)),
+            binary.names_length > 0 ? Data(bytes: binary.names!, count: Int(binary.names_length)) : Data()
+        )
+    }
+
+    /// Insert names stripped by ``compacted()`` back to the module.
+    static func restoringNames(_ names: Data, in module: Data) throws -> Data {
+        if names.isEmpty {
+            return module
+        }
+
+        var error: UnsafePointer<CChar>?
+        let binary = unsafe module.withUnsafeBytes { moduleBytes in
+            unsafe names.withUnsafeBytes { namesBytes in
+                unsafe spirv_restore_names(
+                    moduleBytes.baseAddress,
+                    UInt(moduleBytes.count),
+                    namesBytes.baseAddress,
+                    UInt(namesBytes.count),
+                    &error
+                )
+            }
+        }
+
+        if let error = unsafe error {
+            throw unsafe ShaderCompiler.CompileError.failed(String(cString: error))
+        }
+
+        return unsafe Data(
+            bytesNoCopy: UnsafeMutableRawPointer(mutating: binary.bytes!),
+            count: Int(binary.length),
+            deallocator: .custom { _, _ in
+                unsafe spirv_bin_free(binary)
+            }
+        )
+    }
 }
 
 public struct ShaderDefine: Hashable, Sendable {
@@ -60,6 +125,19 @@ public struct ShaderDefine: Hashable, Sendable {
     }
 }
 
+/// Stage of a shader source compiled with specific defines, for example one permutation of a material.
+public struct ShaderVariant {
+    public let source: ShaderSource
+    public let stage: ShaderStage
+    public let defines: [ShaderDefine]
+
+    public init(source: ShaderSource, stage: ShaderStage, defines: [ShaderDefine] = []) {
+        self.source = source
+        self.stage = stage
+        self.defines = defines
+    }
+}
+
 /// ShaderCompiler compile engine shader code to Shader objects (with SPIR-V binary).
 public final class ShaderCompiler {
     
@@ -118,38 +196,143 @@ public final class ShaderCompiler {
     
     /// Compile all shader sources to shader module.
     public func compileShaderModule() throws -> ShaderModule {
-        var shaders: [ShaderStage: Shader] = [:]
+        let stages = self.shaderSource.stages
+        let shaders = try Self.compileShaders(stages.map { (compiler: self, stage: $0) })
+        return Self.makeShaderModule(stages: stages, shaders: shaders)
+    }
+    
+    /// Compile shader by specific shader stage.
+    /// - Returns: Compiled Shader object.
+    /// - Throws: Error if something went wrong on compilation to SPIR-V.
+    public func compileShader(for stage: ShaderStage) throws -> Shader {
+        return try Self.compileShaders([(compiler: self, stage: stage)])[0]
+    }
+    
+    /// Compile many shader variants at once.
+    ///
+    /// Variants which can't be restored from cache are compiled to SPIR-V in a single batch,
+    /// so permutations of different sources share the glslang worker threads.
+    /// - Returns: Compiled shaders in the same order as variants.
+    /// - Throws: Error if something went wrong on compilation to SPIR-V.
+    public static func compileVariants(_ variants: [ShaderVariant]) throws -> [Shader] {
+        return try Self.compileShaders(variants.map { (compiler: ShaderCompiler(variant: $0), stage: $0.stage) })
+    }
+    
+    /// Drop shader cache records overwritten by later compilations.
+    ///
+    /// Run it offline, for example from a build step or a maintenance tool, while no other process compiles shaders.
+    /// - Returns: Number of records left in the cache.
+    /// - Throws: Error if the cache can't be read or written.
+    @discardableResult
+    public static func compactShaderCache() throws -> Int {
+        return try ShaderCache.compact()
+    }
+    
+    /// Compile all stages of each source with its defines in a single batch.
+    /// - Returns: Shader modules in the same order as sources.
+    /// - Throws: Error if something went wrong on compilation to SPIR-V.
+    public static func compileShaderModules(
+        _ sources: [(source: ShaderSource, defines: [ShaderDefine])]
+    ) throws -> [ShaderModule] {
+        let variants = sources.map { source in
+            source.source.stages.map { ShaderVariant(source: source.source, stage: $0, defines: source.defines) }
+        }
+        let shaders = try Self.compileVariants(variants.flatMap { $0 })
         
+        var shaderModules: [ShaderModule] = []
+        shaderModules.reserveCapacity(variants.count)
+        var offset = 0
+        for stageVariants in variants {
+            let range = offset..<offset + stageVariants.count
+            shaderModules.append(
+                Self.makeShaderModule(stages: stageVariants.map(\.stage), shaders: Array(shaders[range]))
+            )
+            offset = range.upperBound
+        }
+        
+        return shaderModules
+    }
+    
+    /// Create a compiler for a single variant.
+    convenience init(variant: ShaderVariant) {
+        self.init(shaderSource: variant.source)
+        for define in variant.defines {
+            self.setMacro(define.name, value: define.value, for: variant.stage)
+        }
+    }
+    
+    typealias StageRequest = (compiler: ShaderCompiler, stage: ShaderStage)
+    
+    /// Restore shaders from cache and compile the rest to SPIR-V at once.
+    /// - Returns: Shaders in the same order as requests.
+    private static func compileShaders(_ requests: [StageRequest]) throws -> [Shader] {
+        var shaders = [Shader?](repeating: nil, count: requests.count)
+        var pendingIndices: [Int] = []
+        
+        for (index, request) in requests.enumerated() {
+            if let shader = try request.compiler.getCachedShader(for: request.stage) {
+                shaders[index] = shader
+            } else {
+                pendingIndices.append(index)
+            }
+        }
+        
+        // All stages which can't be restored from cache compiles to SPIR-V at once.
+        let binaries = try Self.compileSpirvBins(pendingIndices.map { requests[$0] })
+        for (index, binary) in zip(pendingIndices, binaries) {
+            let request = requests[index]
+            let span = AdaTrace.startSpan("ShaderCompiler.compileShader.\(request.stage.rawValue)")
+            defer {
+                span.end()
+            }
+            shaders[index] = try request.compiler.makeShader(for: request.stage, binary: binary)
+        }
+        
+        return shaders.map { $0.unwrap(message: "Shader wasn't compiled") }
+    }
+    
+    private static func makeShaderModule(stages: [ShaderStage], shaders: [Shader]) -> ShaderModule {
         var reflectionData = ShaderReflectionData()
         
-        for stage in self.shaderSource.stages {
-            let shader = try self.compileShader(for: stage)
-            shaders[stage] = shader
+        for shader in shaders {
             // Merge
             reflectionData.merge(shader.reflectionData)
         }
         
-        return ShaderModule(shaders: shaders, reflectionData: reflectionData)
+        return ShaderModule(
+            shaders: Dictionary(uniqueKeysWithValues: zip(stages, shaders)),
+            reflectionData: reflectionData
+        )
     }
     
-    /// Compile shader by specific shader stage.
-    /// - Returns: Compiled Shader object.
-    /// - Throws: Error if something went wrong on compilation to SPIR-V.
-    public func compileShader(for stage: ShaderStage) throws -> Shader {
-        let span = AdaTrace.startSpan("ShaderCompiler.compileShader.\(stage.rawValue)")
-        defer {
-            span.end()
-        }
+    // MARK: - Private
+    
+    /// Returns device compiled shader from cache if shader source wasn't changed.
+    private func getCachedShader(for stage: ShaderStage) throws -> Shader? {
         let version = self.getShaderVersion(for: stage)
-        if !ShaderCache.hasChanges(for: self.shaderSource, version: version).contains(stage) {
-            if let deviceCompiledShader = ShaderCache.getCachedDeviceCompiledShader(for: self.shaderSource, stage: stage) {
-                return try Shader.make(from: deviceCompiledShader, entryPoint: deviceCompiledShader.entryPoints.first?.name ?? "", stage: stage)
-            }
+        guard
+            !ShaderCache.hasChanges(
+                for: self.shaderSource,
+                version: version,
+                includeSearchPaths: self.includeSearchPaths
+            ).contains(stage),
+            let deviceCompiledShader = ShaderCache.getCachedDeviceCompiledShader(
+                for: self.shaderSource,
+                stage: stage,
+                version: version,
+                includeSearchPaths: self.includeSearchPaths
+            )
+        else {
+            return nil
         }
-
+        
+        return try Shader.make(from: deviceCompiledShader, entryPoint: deviceCompiledShader.entryPoints.first?.name ?? "", stage: stage)
+    }
+    
+    /// Create shader for current device from SPIR-V binary.
+    private func makeShader(for stage: ShaderStage, binary: SpirvBinary) throws -> Shader {
         #if WASM
         if unsafe RenderEngine.shared.type == .headless {
-            let binary = try self.compileSpirvBin(for: stage, ignoreCache: false)
             let shader = try Shader(spirv: binary, compiler: self)
             try shader.compile()
             return shader
@@ -162,13 +345,11 @@ public final class ShaderCompiler {
                 throw CompileError.failed("WGSL sidecar for `\(stage.rawValue)` shader not found next to \(sourcePath)")
             }
 
-            let binary = try self.compileSpirvBin(for: stage, ignoreCache: false)
-            let spirvCompiler = try SpirvCompiler(spriv: binary.data, stage: stage, deviceLang: .glsl)
             let shader = Shader(
                 source: wgslSource,
                 entryPoint: self.shaderSource.getEntryPoint(for: stage),
                 stage: stage,
-                reflectionData: spirvCompiler.reflection()
+                reflectionData: try self.makeReflection(for: stage, binary: binary)
             )
             try shader.compile()
             return shader
@@ -176,19 +357,11 @@ public final class ShaderCompiler {
         #endif
         #endif
 
-        let binary = try self.compileSpirvBin(for: stage, ignoreCache: false)
-
         #if canImport(WebGPU)
         if unsafe RenderEngine.shared.type.deviceLang == .wgsl {
             let shader = try Shader(spirv: binary, compiler: self)
-            let spirvCompiler = try SpirvCompiler(spriv: binary.data, stage: stage, deviceLang: .glsl)
-            shader.reflectionData = spirvCompiler.reflection()
+            shader.reflectionData = try self.makeReflection(for: stage, binary: binary)
             try shader.compile()
-            do {
-                try ShaderCache.saveReflection(shader.reflectionData, for: self.shaderSource, stage: stage)
-            } catch {
-                self.logger.warning("Failed to save reflection: \(error)")
-            }
             return shader
         }
         #endif
@@ -206,61 +379,144 @@ public final class ShaderCompiler {
             )
         }.get()
         do {
-            try ShaderCache.saveDeviceCompiledShader(compiledShaderData, for: self.shaderSource, stage: stage)
+            try ShaderCache.saveDeviceCompiledShader(
+                compiledShaderData,
+                for: self.shaderSource,
+                stage: stage,
+                version: binary.version,
+                includeSearchPaths: self.includeSearchPaths
+            )
         } catch {
             self.logger.warning("Failed to save device compiled shader to cache: \(error)")
         }
-        let shader = try Shader.make(
+        // Device compiled shader already contains reflection, it's cached together with the source.
+        return try Shader.make(
             from: compiledShaderData,
             entryPoint: binary.entryPoint,
             stage: stage
         )
-        if let reflection = ShaderCache.getReflection(for: self.shaderSource, stage: stage) {
-            shader.reflectionData = reflection
-        } else {
-            try ShaderCache.saveReflection(shader.reflectionData, for: self.shaderSource, stage: stage)
-        }
-        
-        return shader
         #endif
     }
     
-    // MARK: - Private
+    /// Returns reflection from cache or reflects SPIR-V binary and stores the reflection blob in cache.
+    private func makeReflection(for stage: ShaderStage, binary: SpirvBinary) throws -> ShaderReflectionData {
+        if let reflection = ShaderCache.getReflection(
+            for: self.shaderSource,
+            stage: stage,
+            version: binary.version,
+            includeSearchPaths: self.includeSearchPaths
+        ) {
+            return reflection
+        }
+        
+        let reflectionBlob = try SpirvCompiler(spriv: binary.data, stage: stage, deviceLang: .glsl).reflectionBlob()
+        do {
+            try ShaderCache.saveReflection(
+                reflectionBlob,
+                for: self.shaderSource,
+                stage: stage,
+                version: binary.version,
+                includeSearchPaths: self.includeSearchPaths
+            )
+        } catch {
+            self.logger.warning("Failed to save reflection: \(error)")
+        }
+        return try ShaderReflectionData(reflectionBlob: reflectionBlob, stage: stage)
+    }
     
     // Get SPIRV from cache or compile new if something change in file.
     internal func compileSpirvBin(for stage: ShaderStage, ignoreCache: Bool = false) throws -> SpirvBinary {
-        let version = self.getShaderVersion(for: stage)
+        return try Self.compileSpirvBins([(compiler: self, stage: stage)], ignoreCache: ignoreCache)[0]
+    }
+    
+    /// Get SPIRV for each variant from cache or compile all changed variants concurrently.
+    /// - Returns: Binaries in the same order as variants.
+    internal static func compileSpirvVariants(_ variants: [ShaderVariant], ignoreCache: Bool = false) throws -> [SpirvBinary] {
+        return try Self.compileSpirvBins(
+            variants.map { (compiler: ShaderCompiler(variant: $0), stage: $0.stage) },
+            ignoreCache: ignoreCache
+        )
+    }
+    
+    /// Get SPIRV for each request from cache or compile all changed stages concurrently.
+    /// - Returns: Binaries in the same order as requests.
+    private static func compileSpirvBins(_ requests: [StageRequest], ignoreCache: Bool = false) throws -> [SpirvBinary] {
+        var binaries = [SpirvBinary?](repeating: nil, count: requests.count)
+        var jobs: [CompileJob] = []
+        var jobIndices: [Int] = []
         
-        if !ShaderCache.hasChanges(for: self.shaderSource, version: version).contains(stage), !ignoreCache {
-            let entryPoint = self.shaderSource.getEntryPoint(for: stage)
-            if let binary = ShaderCache.getCachedShader(
-                for: self.shaderSource,
-                stage: stage,
-                version: version,
-                entryPoint: entryPoint
-            ) {
-                return binary
+        for (index, request) in requests.enumerated() {
+            if !ignoreCache, let binary = request.compiler.getCachedSpirvBin(for: request.stage) {
+                binaries[index] = binary
+                continue
             }
+            
+            jobs.append(try request.compiler.makeCompileJob(for: request.stage))
+            jobIndices.append(index)
         }
         
-        guard let code = self.shaderSource.getSource(for: stage) else {
-            throw CompileError.failed("Sources for stage `\(stage.rawValue)` not found")
+        for (index, (job, spirv)) in zip(jobIndices, zip(jobs, try Self.compileCodes(jobs))) {
+            do {
+                try ShaderCache.save(
+                    spirv,
+                    source: job.compiler.shaderSource,
+                    stage: spirv.stage,
+                    version: spirv.version,
+                    includeSearchPaths: job.compiler.includeSearchPaths
+                )
+            } catch {
+                job.compiler.logger.warning("Failed to save spirv to cache: \(error)")
+            }
+            
+            binaries[index] = spirv
         }
         
-        let processedCode = try ShaderIncluder.processIncludes(in: code, includeSearchPath: self.includeSearchPaths)
-        let (entryPoint, ppCode) = try ShaderUtils.dropEntryPoint(from: processedCode)
-        let spirv = try self.compileCode(ppCode, entryPoint: entryPoint, stage: stage)
-        do {
-            try ShaderCache.save(spirv, source: self.shaderSource, stage: stage, version: version)
-        } catch {
-            self.logger.warning("Failed to save spirv to cache: \(error)")
+        return binaries.map { $0.unwrap(message: "SPIR-V wasn't compiled") }
+    }
+    
+    private func getCachedSpirvBin(for stage: ShaderStage) -> SpirvBinary? {
+        let version = self.getShaderVersion(for: stage)
+        guard !ShaderCache.hasChanges(
+            for: self.shaderSource,
+            version: version,
+            includeSearchPaths: self.includeSearchPaths
+        ).contains(stage) else {
+            return nil
         }
         
-        return spirv
+        return ShaderCache.getCachedShader(
+            for: self.shaderSource,
+            stage: stage,
+            version: version,
+            entryPoint: self.shaderSource.getEntryPoint(for: stage),
+            includeSearchPaths: self.includeSearchPaths
+        )
+    }
+    
+    private func makeCompileJob(for stage: ShaderStage) throws -> CompileJob {
+        guard let code = self.shaderSource.getSource(for: stage) else {
+            throw CompileError.failed("Sources for stage `\(stage.rawValue)` not found")
+        }
+        
+        let (entryPoint, ppCode) = try ShaderUtils.dropEntryPoint(from: code)
+        return CompileJob(compiler: self, code: ppCode, entryPoint: entryPoint, stage: stage)
+    }
+    
+    struct CompileJob {
+        let compiler: ShaderCompiler
+        let code: String
+        let entryPoint: String
+        let stage: ShaderStage
     }
     
-    internal func compileCode(_ code: String, entryPoint: String, stage: ShaderStage) throws -> SpirvBinary {
-        let span = AdaTrace.startSpan("ShaderCompiler.compileCode.\(stage.rawValue)")
+    /// Compile GLSL sources to SPIR-V. Jobs are compiled in parallel on glslang worker threads.
+    /// - Returns: Binaries in the same order as jobs.
+    internal static func compileCodes(_ jobs: [CompileJob]) throws -> [SpirvBinary] {
+        if jobs.isEmpty {
+            return []
+        }
+        
+        let span = AdaTrace.startSpan("ShaderCompiler.compileCodes")
         defer {
             span.end()
         }
@@ -272,39 +528,104 @@ public final class ShaderCompiler {
             glslang_finalize()
         }
         
-        var error: UnsafePointer<CChar>?
-        let defines = self.getDefines(for: stage)
-        let binary = unsafe defines.withCString { definesPtr in
-            let options = unsafe spirv_options(preamble: definesPtr)
+        // Includes are resolved by glslang itself, search paths must outlive the compilation.
+        // Search paths of each job are stored one after another.
+        var searchPaths: [spirv_include_search_path] = []
+        var searchPathRanges: [Range<Int>] = []
+        for job in jobs {
+            let start = searchPaths.count
+            for searchPath in job.compiler.includeSearchPaths {
+                switch searchPath {
+                case ._local(let url):
+                    unsafe searchPaths.append(spirv_include_search_path(path: strdup(url.path), module_name: nil))
+                case ._module(let moduleName, let url):
+                    unsafe searchPaths.append(spirv_include_search_path(path: strdup(url.path), module_name: strdup(moduleName)))
+                }
+            }
+            searchPathRanges.append(start..<searchPaths.count)
+        }
+        let sources = unsafe jobs.map { unsafe strdup($0.code) }
+        let preambles = unsafe jobs.map { unsafe strdup($0.compiler.getDefines(for: $0.stage)) }
+        
+        defer {
+            for searchPath in unsafe searchPaths {
+                unsafe free(UnsafeMutablePointer(mutating: searchPath.path))
+                unsafe free(UnsafeMutablePointer(mutating: searchPath.module_name))
+            }
+            for pointer in unsafe sources + preambles {
+                unsafe free(pointer)
+            }
+        }
+        
+        var results = unsafe [spirv_compile_result](
+            repeating: spirv_compile_result(binary: spirv_bin(), error: nil),
+            count: jobs.count
+        )
+        
+        unsafe searchPaths.withUnsafeBufferPointer { searchPathsPtr in
+            let compileJobs = unsafe jobs.indices.map { index in
+                unsafe spirv_compile_job(
+                    source: sources[index],
+                    stage: jobs[index].stage.toShaderCompiler,
+                    options: spirv_options(
+                        preamble: preambles[index],
+                        include_search_paths: searchPathsPtr.baseAddress.map { unsafe $0 + searchPathRanges[index].lowerBound },
+                        include_search_paths_count: UInt(searchPathRanges[index].count),
+                        remap_flags: SPIRV_REMAP_CANONICALIZE.rawValue
+                    )
+                )
+            }
+            
+            unsafe compile_shader_glsl_batch(compileJobs, &results, UInt(jobs.count), 0)
+        }
+        
+        var binaries: [SpirvBinary] = []
+        binaries.reserveCapacity(jobs.count)
+        var compileError: Error?
+        
+        for (job, result) in unsafe zip(jobs, results) {
+            let binary = unsafe result.binary
+            
+            if let error = unsafe result.error {
+                let message = unsafe String(cString: error, encoding: .utf8) ?? "Failed to compile"
+                compileError = compileError ?? CompileError.glslError(message)
+                unsafe spirv_bin_free(binary)
+                continue
+            }
             
-            return unsafe code.withCString { sourcePtr in
-                unsafe compile_shader_glsl(
-                    sourcePtr, /* source */
-                    stage.toShaderCompiler, /* stage */
-                    options, /* options */
-                    &error /* output error */
+            let includes = unsafe (0..<Int(binary.includes_count)).map { index in
+                let dependency = unsafe binary.includes[index]
+                return unsafe ShaderIncludeDependency(
+                    path: String(cString: dependency.path),
+                    contentHash: dependency.content_hash
                 )
             }
+            
+            let data = unsafe Data(
+                bytesNoCopy: UnsafeMutableRawPointer(mutating: binary.bytes!), 
+                count: Int(binary.length), 
+                deallocator: .custom { _, _ in
+                    unsafe spirv_bin_free(binary)
+                }
+            )
+            
+            binaries.append(
+                SpirvBinary(
+                    stage: job.stage,
+                    data: data,
+                    language: job.compiler.shaderSource.language,
+                    entryPoint: job.entryPoint,
+                    version: job.compiler.getShaderVersion(for: job.stage),
+                    includes: includes
+                )
+            )
         }
         
-        if let error = unsafe error {
-            let message = unsafe String(cString: error, encoding: .utf8) ?? "Failed to compile"
-            throw CompileError.glslError(message)
+        if let compileError {
+            throw compileError
         }
         
-        let data = unsafe Data(
-            bytesNoCopy: UnsafeMutableRawPointer(mutating: binary.bytes!), 
-            count: Int(binary.length), 
-            deallocator: .free
-        )
-
-        return SpirvBinary(
-            stage: stage,
-            data: data,
-            language: self.shaderSource.language,
-            entryPoint: entryPoint,
-            version: self.getShaderVersion(for: stage)
-        )
+        return binaries
     }
     
     private func getShaderVersion(for stage: ShaderStage) -> Int {
@@ -0,0 +1,216 @@
+//
+//  ShaderReflectionData+Blob.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import Foundation
+import SPIRVCompiler
+import SPIRV_Cross
+
+extension ShaderReflectionData {
+
+    enum BlobError: LocalizedError {
+        case invalidBlob
+
+        var errorDescription: String? {
+            return "[ShaderReflectionData] Invalid reflection blob."
+        }
+    }
+
+    /// Decode reflection blob produced by `spirv_reflect_and_translate`.
+    // swiftlint:disable:next function_body_length cyclomatic_complexity
+    init(reflectionBlob blob: Data, stage: ShaderStage) throws {
+        let reader = try BlobReader(blob)
+        self.init()
+
+        for resource in reader.resources {
+            let resourceType = ShaderResource.ResourceType(from: spirv_resource_kind(resource.kind))
+            let resourceName = reader.string(at: resource.name)
+            let binding = Int(resource.binding)
+            let descriptorSetIndex = Int(resource.descriptor_set)
+            let isInternalResource = resourceName.hasPrefix("AE_")
+
+            if descriptorSetIndex >= self.descriptorSets.count {
+                self.descriptorSets.append(
+                    contentsOf: Array(
+                        repeating: ShaderResource.DescriptorSet(),
+                        count: descriptorSetIndex - self.descriptorSets.count + 1
+                    )
+                )
+            }
+
+            var descriptorSet = self.descriptorSets[descriptorSetIndex]
+
+            switch resourceType {
+            case .uniformBuffer, .pushConstantBuffer:
+                var members = [String: ShaderResource.ShaderBufferMember]()
+
+                for member in reader.members(of: resource) {
+                    let memberName = reader.string(at: member.name)
+                    members[memberName] = ShaderResource.ShaderBufferMember(
+                        name: memberName,
+                        size: Int(member.size),
+                        binding: binding,
+                        type: ShaderValueType(member.type) ?? .none,
+                        offset: Int(member.offset)
+                    )
+                }
+
+                let buffer = ShaderResource.ShaderBuffer(
+                    name: resourceName,
+                    size: Int(resource.size),
+                    shaderStage: ShaderStageFlags(shaderStage: stage),
+                    binding: binding,
+                    resourceAccess: .readWrite,
+                    members: members
+                )
+
+                descriptorSet.uniformsBuffers[binding] = buffer
+                if !isInternalResource {
+                    self.shaderBuffers[resourceName] = buffer
+                }
+            case .sampler:
+                let sampler = ShaderResource.Sampler(
+                    name: resourceName,
+                    binding: binding,
+                    shaderStage: ShaderStageFlags(shaderStage: stage)
+                )
+
+                if !isInternalResource {
+                    self.samplers[resourceName] = sampler
+                }
+                descriptorSet.samplers[binding] = sampler
+            case .image, .inputAttachment, .storageImage, .sampledImage:
+                let access = SpvAccessQualifier(resource.image_access)
+                let isArray = resource.image_arrayed == 1
+                let isMultisampled = resource.image_multisampled == 1
+
+                let resourceAccess: ShaderResource.ResourceAccess
+
+                if resourceType == .storageImage || access == SpvAccessQualifierReadOnly {
+                    resourceAccess = .read
+                } else if access == SpvAccessQualifierWriteOnly {
+                    resourceAccess = .write
+                } else {
+                    resourceAccess = .readWrite
+                }
+
+                var textureType: Texture.TextureType = .texture2D
+
+                switch SpvDim(resource.image_dimension) {
+                case SpvDim1D:
+                    textureType = isArray ? .texture1DArray : .texture1D
+                case SpvDim2D:
+                    if isMultisampled {
+                        textureType = isArray ? .texture2DMultisampleArray : .texture2DMultisample
+                    } else {
+                        textureType = isArray ? .texture2DArray : .texture2D
+                    }
+                case SpvDim3D:
+                    textureType = .texture3D
+                case SpvDimCube:
+                    textureType = .textureCube
+                case SpvDimBuffer:
+                    textureType = .textureBuffer
+                default:
+                    break
+                }
+
+                let image = ShaderResource.ImageSampler(
+                    name: resourceName,
+                    binding: binding,
+                    textureType: textureType,
+                    descriptorSet: descriptorSetIndex,
+                    arraySize: Int(resource.array_size),
+                    shaderStage: ShaderStageFlags(shaderStage: stage),
+                    resourceAccess: resourceAccess
+                )
+
+                if !isInternalResource {
+                    self.resources[resourceName] = image
+                }
+                descriptorSet.sampledImages[binding] = image
+            default:
+                continue
+            }
+
+            self.descriptorSets[descriptorSetIndex] = descriptorSet
+        }
+
+        self.vertexInputs = reader.vertexInputs
+            .map { input in
+                ShaderResource.VertexInput(
+                    name: reader.string(at: input.name),
+                    location: Int(input.location),
+                    type: ShaderValueType(input.type) ?? .none
+                )
+            }
+            .sorted { $0.location < $1.location }
+    }
+}
+
+/// Validates reflection blob and gives access to its arrays.
+private struct BlobReader {
+    let resources: [spirv_reflection_resource]
+    let vertexInputs: [spirv_reflection_vertex_input]
+    private let allMembers: [spirv_reflection_member]
+    private let strings: Data
+
+    init(_ blob: Data) throws {
+        let headerSize = MemoryLayout<spirv_reflection_header>.size
+        guard blob.count >= headerSize else {
+            throw ShaderReflectionData.BlobError.invalidBlob
+        }
+
+        let header = unsafe blob.withUnsafeBytes { unsafe $0.loadUnaligned(as: spirv_reflection_header.self) }
+        guard header.magic == SPIRV_REFLECTION_MAGIC, header.version == SPIRV_REFLECTION_VERSION else {
+            throw ShaderReflectionData.BlobError.invalidBlob
+        }
+
+        var offset = headerSize
+        let resourcesEnd = offset + Int(header.resources_count) * MemoryLayout<spirv_reflection_resource>.stride
+        let membersEnd = resourcesEnd + Int(header.members_count) * MemoryLayout<spirv_reflection_member>.stride
+        let inputsEnd = membersEnd + Int(header.vertex_inputs_count) * MemoryLayout<spirv_reflection_vertex_input>.stride
+        guard inputsEnd + Int(header.strings_length) == blob.count else {
+            throw ShaderReflectionData.BlobError.invalidBlob
+        }
+
+        self.resources = Self.readArray(from: blob, at: &offset, count: Int(header.resources_count))
+        self.allMembers = Self.readArray(from: blob, at: &offset, count: Int(header.members_count))
+        self.vertexInputs = Self.readArray(from: blob, at: &offset, count: Int(header.vertex_inputs_count))
+        self.strings = blob.subdata(in: (blob.startIndex + offset)..<blob.endIndex)
+
+        for resource in self.resources {
+            guard Int(resource.first_member) + Int(resource.members_count) <= self.allMembers.count else {
+                throw ShaderReflectionData.BlobError.invalidBlob
+            }
+        }
+    }
+
+    func members(of resource: spirv_reflection_resource) -> ArraySlice<spirv_reflection_member> {
+        let start = Int(resource.first_member)
+        return self.allMembers[start..<(start + Int(resource.members_count))]
+    }
+
+    /// Returns NUL-terminated string at the offset of the string table.
+    func string(at offset: UInt32) -> String {
+        guard Int(offset) < self.strings.count else {
+            return ""
+        }
+
+        let bytes = self.strings[(self.strings.startIndex + Int(offset))...]
+        return String(decoding: bytes.prefix { $0 != 0 }, as: UTF8.self)
+    }
+
+    private static func readArray<T>(from blob: Data, at offset: inout Int, count: Int) -> [T] {
+        let start = offset
+        offset += count * MemoryLayout<T>.stride
+        return unsafe blob.withUnsafeBytes { bytes in
+            unsafe (0..<count).map { index in
+                unsafe bytes.loadUnaligned(fromByteOffset: start + index * MemoryLayout<T>.stride, as: T.self)
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
 //  Created by v.prusakov on 3/19/23.
 //
 
+import SPIRVCompiler
 import SPIRV_Cross
 
 extension ShaderStage {
@@ -98,37 +99,42 @@ public enum ShaderResource {
         let type: ShaderValueType
         let offset: Int
     }
+    
+    /// Describe reflected vertex shader input.
+    public struct VertexInput: Codable, Sendable {
+        public let name: String
+        public let location: Int
+        public let type: ShaderValueType
+    }
 }
 
 extension ShaderResource.ResourceType {
-    var spvcResourceType: spvc_resource_type {
-        switch self {
-        case .uniformBuffer:
-            return SPVC_RESOURCE_TYPE_UNIFORM_BUFFER
-        case .storageBuffer:
-            return SPVC_RESOURCE_TYPE_STORAGE_BUFFER
-        case .sampler:
-            return SPVC_RESOURCE_TYPE_SEPARATE_SAMPLERS
-        case .storageImage:
-            return SPVC_RESOURCE_TYPE_STORAGE_IMAGE
-        case .image:
-            return SPVC_RESOURCE_TYPE_SEPARATE_IMAGE
-        case .sampledImage:
-            return SPVC_RESOURCE_TYPE_SAMPLED_IMAGE
-        case .pushConstantBuffer:
-            return SPVC_RESOURCE_TYPE_PUSH_CONSTANT
-        case .inputAttachment:
-            return SPVC_RESOURCE_TYPE_SUBPASS_INPUT
+    init(from kind: spirv_resource_kind) {
+        switch kind {
+        case SPIRV_RESOURCE_UNIFORM_BUFFER:
+            self = .uniformBuffer
+        case SPIRV_RESOURCE_STORAGE_BUFFER:
+            self = .storageBuffer
+        case SPIRV_RESOURCE_PUSH_CONSTANT_BUFFER:
+            self = .pushConstantBuffer
+        case SPIRV_RESOURCE_SEPARATE_IMAGE:
+            self = .image
+        case SPIRV_RESOURCE_SAMPLED_IMAGE:
+            self = .sampledImage
+        case SPIRV_RESOURCE_STORAGE_IMAGE:
+            self = .storageImage
+        case SPIRV_RESOURCE_SUBPASS_INPUT:
+            self = .inputAttachment
+        default:
+            self = .sampler
         }
     }
 }
 
 extension ShaderValueType {
     // swiftlint:disable:next cyclomatic_complexity
-    init?(typeId: spvc_type_id, compiler: spvc_compiler) {
-        let type = unsafe spvc_compiler_get_type_handle(compiler, typeId)
-        let baseType = unsafe spvc_type_get_basetype(type)
-        switch baseType {
+    init?(_ valueType: spirv_reflection_value_type) {
+        switch spvc_basetype(valueType.base_type) {
         case SPVC_BASETYPE_BOOLEAN:
             self = .bool
         case SPVC_BASETYPE_FP16:
@@ -136,20 +142,17 @@ extension ShaderValueType {
         case SPVC_BASETYPE_UINT8:
             self = .char
         case SPVC_BASETYPE_FP32:
-            let vectorCount = unsafe spvc_type_get_vector_size(type)
-            let columnCount = unsafe spvc_type_get_columns(type)
-            
-            if columnCount == 3 {
+            if valueType.columns == 3 {
                 self = .mat3
                 return
             }
             
-            if columnCount == 4 {
+            if valueType.columns == 4 {
                 self = .mat4
                 return
             }
             
-            switch vectorCount {
+            switch valueType.vector_size {
             case 1:
                 self = .float
             case 2:
@@ -225,9 +228,13 @@ public struct ShaderReflectionData: Codable, Sendable {
     public var resources: [String: ShaderResource.ImageSampler] = [:]
     public var samplers: [String: ShaderResource.Sampler] = [:]
     
+    /// Inputs of the vertex stage sorted by location.
+    public var vertexInputs: [ShaderResource.VertexInput] = []
+    
     /// Check if reflection data is empty.
     public var isEmpty: Bool {
         return self.shaderBuffers.isEmpty && self.resources.isEmpty && self.samplers.isEmpty && self.descriptorSets.isEmpty
+            && self.vertexInputs.isEmpty
     }
 
     public init() {}
@@ -267,6 +274,10 @@ public extension ShaderReflectionData {
             )
         }
 
+        if !data.vertexInputs.isEmpty {
+            self.vertexInputs = data.vertexInputs
+        }
+
         if !data.descriptorSets.isEmpty {
             if self.descriptorSets.count < data.descriptorSets.count {
                 let missingCount = data.descriptorSets.count - self.descriptorSets.count
@@ -67,6 +67,15 @@ open class Scene: @unsafe Asset, @unchecked Sendable {
             throw SceneSerializationError.invalidExtensionType
         }
         
+        if assetDecoder.decoder == nil, let binary = try SceneBinarySerialization(data: assetDecoder.assetData) {
+            let world = World()
+            try world.restoreSnapshot(binary.snapshot)
+
+            self.init(name: binary.scene)
+            self.world = world
+            return
+        }
+
         let scene = try assetDecoder.decode(SceneSerialization.self)
         
         if unsafe Self.currentVersion < scene.version {
@@ -81,6 +90,13 @@ open class Scene: @unsafe Asset, @unchecked Sendable {
         guard Self.extensions().contains(where: { assetEncoder.assetMeta.filePath.pathExtension == $0 }) else {
             throw SceneSerializationError.invalidExtensionType
         }
+
+        // Like in text scenes, components that are neither plain old data nor Codable are skipped.
+        if assetEncoder.encoder == nil, assetEncoder.assetMeta.filePath.pathExtension == Self.binaryExtension {
+            let snapshot = try world.makeSnapshot()
+            try assetEncoder.encode(SceneBinarySerialization(scene: name, snapshot: snapshot).data)
+            return
+        }
         
         unsafe try assetEncoder.encode(
             SceneSerialization(
@@ -91,8 +107,15 @@ open class Scene: @unsafe Asset, @unchecked Sendable {
         )
     }
     
+    /// Extension of scenes saved as a binary ``WorldSnapshot``.
+    ///
+    /// Binary scenes load faster, but they should be loaded by the same build of the app
+    /// and resources of the world are not stored.
+    /// Scenes of any extension are loaded from both binary and text files.
+    public static let binaryExtension = "ascnb"
+
     public static func extensions() -> [String] {
-        ["ascn", "scene", "scn"]
+        ["ascn", "scene", "scn", binaryExtension]
     }
 }
 
@@ -149,4 +172,54 @@ private extension Scene {
         let scene: String
         let world: AdaECS.World
     }
+
+    /// A scene header followed by a world snapshot.
+    struct SceneBinarySerialization {
+        static let magic: UInt32 = 0x42_4E_43_53 // "SCNB"
+        static let version: UInt32 = 1
+
+        let scene: String
+        let snapshot: WorldSnapshot
+
+        init(scene: String, snapshot: WorldSnapshot) {
+            self.scene = scene
+            self.snapshot = snapshot
+        }
+
+        /// Returns nil if data is not a binary scene.
+        init?(data: Data) throws {
+            let headerSize = 3 * MemoryLayout<UInt32>.size
+            guard data.count >= headerSize, Self.readUInt32(data, at: 0) == Self.magic else {
+                return nil
+            }
+            guard Self.readUInt32(data, at: 4) == Self.version else {
+                throw SceneSerializationError.unsupportedVersion
+            }
+
+            let nameCount = Int(Self.readUInt32(data, at: 8))
+            guard data.count - headerSize >= nameCount else {
+                throw WorldSnapshotError.invalidData
+            }
+            let nameStart = data.startIndex + headerSize
+            self.scene = String(decoding: data[nameStart..<nameStart + nameCount], as: UTF8.self)
+            self.snapshot = WorldSnapshot(data: Data(data[(nameStart + nameCount)...]))
+        }
+
+        var data: Data {
+            let name = Data(scene.utf8)
+            var data = Data()
+            data.reserveCapacity(3 * MemoryLayout<UInt32>.size + name.count + snapshot.data.count)
+            for value in [Self.magic, Self.version, UInt32(name.count)] {
+                unsafe withUnsafeBytes(of: value.littleEndian) { unsafe data.append(contentsOf: $0) }
+            }
+            data.append(name)
+            data.append(snapshot.data)
+            return data
+        }
+
+        private static func readUInt32(_ data: Data, at offset: Int) -> UInt32 {
+            let start = data.startIndex + offset
+            return data[start..<start + 4].reversed().reduce(0) { $0 << 8 | UInt32($1) }
+        }
+    }
 }
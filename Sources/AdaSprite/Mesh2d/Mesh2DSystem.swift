@@ -144,10 +144,21 @@ public struct Mesh2DRenderSystem: Sendable {
         visibleEntities: VisibleEntities,
         keys: Set<String>
     ) {
-        for mesh in extractedMeshes.meshes {
-            guard visibleEntities.entityIds.contains(mesh.entityId) else {
-                continue
-            }
+        let visibleMeshes = extractedMeshes.meshes.filter {
+            visibleEntities.entityIds.contains($0.entityId)
+        }
+        // Compile shaders of all new material variants at once instead of one by one in the loop below.
+        Material.prepareMesh2dPipelines(
+            for: visibleMeshes.flatMap { mesh in
+                mesh.mesh.mesh.models.flatMap { model in
+                    model.parts.map { (material: mesh.mesh.materials[$0.materialIndex], vertexDescriptor: $0.vertexDescriptor) }
+                }
+            },
+            keys: keys,
+            device: renderDevice.renderDevice
+        )
+
+        for mesh in visibleMeshes {
 
             let modelUniform = Mesh2DUniform(
                 model: mesh.worldTransform,
@@ -221,59 +232,83 @@ extension Material {
     ) -> RenderPipeline? {
         let materialKey = self.getMesh2dMaterialKey(for: vertexDescriptor, keys: keys)
 
-        if let data = unsafe MaterialStorage.shared.getMaterialData(for: self) as? Mesh2dMaterialStorageData {
-            if let pipeline = data.pipelines[materialKey] {
-                return pipeline
-            }
+        if
+            let data = unsafe MaterialStorage.shared.getMaterialData(for: self) as? Mesh2dMaterialStorageData,
+            let pipeline = data.pipelines[materialKey]
+        {
+            return pipeline
+        }
 
-            guard let (pipeline, shaderModule) = self.createPipeline(for: materialKey, device: device) else {
-                return nil
-            }
+        do {
+            let shaderModule = try ShaderCompiler.compileShaderModules([(self.shaderSource, materialKey.defines)])[0]
+            return self.storePipeline(for: materialKey, shaderModule: shaderModule, device: device)
+        } catch {
+            assertionFailure("[Mesh2DRenderSystem] \(error)")
+            return nil
+        }
+    }
 
-            data.updateUniformBuffers(from: shaderModule)
-            data.pipelines[materialKey] = pipeline
+    /// Create missing Mesh2D render pipelines of materials, shaders of all variants are compiled in a single batch.
+    static func prepareMesh2dPipelines(
+        for parts: [(material: Material, vertexDescriptor: VertexDescriptor)],
+        keys: Set<String>,
+        device: RenderDevice
+    ) {
+        var missingPipelines: [(material: Material, key: MaterialMesh2dKey)] = []
 
-            self.update()
+        for part in parts {
+            let materialKey = part.material.getMesh2dMaterialKey(for: part.vertexDescriptor, keys: keys)
+            let data = unsafe MaterialStorage.shared.getMaterialData(for: part.material) as? Mesh2dMaterialStorageData
 
-            return pipeline
-        } else {
-            guard let (pipeline, shaderModule) = self.createPipeline(for: materialKey, device: device) else {
-                return nil
+            if data?.pipelines[materialKey] != nil
+                || missingPipelines.contains(where: { $0.material === part.material && $0.key == materialKey }) {
+                continue
             }
 
-            let data = Mesh2dMaterialStorageData()
-            data.updateUniformBuffers(from: shaderModule)
-            data.pipelines[materialKey] = pipeline
-            unsafe MaterialStorage.shared.setMaterialData(data, for: self)
+            missingPipelines.append((part.material, materialKey))
+        }
 
-            self.update()
+        if missingPipelines.isEmpty {
+            return
+        }
 
-            return pipeline
+        do {
+            let shaderModules = try ShaderCompiler.compileShaderModules(
+                missingPipelines.map { ($0.material.shaderSource, $0.key.defines) }
+            )
+
+            for (missingPipeline, shaderModule) in zip(missingPipelines, shaderModules) {
+                missingPipeline.material.storePipeline(for: missingPipeline.key, shaderModule: shaderModule, device: device)
+            }
+        } catch {
+            assertionFailure("[Mesh2DRenderSystem] \(error)")
         }
     }
 
-    private func createPipeline(
+    @discardableResult
+    private func storePipeline(
         for materialKey: MaterialMesh2dKey,
+        shaderModule: ShaderModule,
         device: RenderDevice
-    ) -> (RenderPipeline, ShaderModule)? {
-        let compiler = ShaderCompiler(shaderSource: self.shaderSource)
+    ) -> RenderPipeline? {
+        guard let pipelineDesc = self.configureRenderPipeline(for: materialKey.vertexDescritor, keys: materialKey.keys, shaderModule: shaderModule) else {
+            return nil
+        }
 
-        for define in materialKey.defines {
-            compiler.setMacro(define.name, value: define.value, for: .vertex)
-            compiler.setMacro(define.name, value: define.value, for: .fragment)
+        let pipeline = device.createRenderPipeline(from: pipelineDesc)
+        let data: Mesh2dMaterialStorageData
+        if let storedData = unsafe MaterialStorage.shared.getMaterialData(for: self) as? Mesh2dMaterialStorageData {
+            data = storedData
+        } else {
+            data = Mesh2dMaterialStorageData()
+            unsafe MaterialStorage.shared.setMaterialData(data, for: self)
         }
 
-        do {
-            let shaderModule = try compiler.compileShaderModule()
+        data.updateUniformBuffers(from: shaderModule)
+        data.pipelines[materialKey] = pipeline
 
-            guard let pipelineDesc = self.configureRenderPipeline(for: materialKey.vertexDescritor, keys: materialKey.keys, shaderModule: shaderModule) else {
-                return nil
-            }
+        self.update()
 
-            return (device.createRenderPipeline(from: pipelineDesc), shaderModule)
-        } catch {
-            assertionFailure("[Mesh2DRenderSystem] \(error)")
-            return nil
-        }
+        return pipeline
     }
 }
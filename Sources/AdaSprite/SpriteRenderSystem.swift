@@ -91,13 +91,14 @@ public func ExtractSprite(
         Query<Entity, Sprite, GlobalTransform, Transform, Visibility>
     >,
     _ extractedSprites: ResMut<ExtractedSprites>
-) {
+) async {
     extractedSprites.sprites.removeAll(keepingCapacity: true)
-    sprites.wrappedValue.forEach { entity, sprite, globalTransform, transform, visible in
+    // Sprites are extracted in parallel and inserted in the query order.
+    let extracted: [ExtractedSprite] = await sprites.wrappedValue.parallel().compactMap { entity, sprite, globalTransform, transform, visible in
         if visible == .hidden {
-            return
+            return nil
         }
-        extractedSprites.sprites[entity.id] = ExtractedSprite(
+        return ExtractedSprite(
             entityId: entity.id,
             texture: sprite.texture?.asset,
             size: sprite.size,
@@ -108,6 +109,9 @@ public func ExtractSprite(
             worldTransform: globalTransform.matrix
         )
     }
+    for sprite in extracted {
+        extractedSprites.sprites[sprite.entityId] = sprite
+    }
 }
 
 @System
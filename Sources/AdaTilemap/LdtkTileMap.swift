@@ -205,16 +205,16 @@ extension LDtk {
                     tileSet.addTileSource(source)
                 }
 
-                for tileSource in project.defs.tilesets {
-                    let atlasPath = filePath
+                // Tileset images are decoded together.
+                let atlasPaths = project.defs.tilesets.map { tileSource in
+                    filePath
                         .deletingLastPathComponent()
                         .appending(path: tileSource.relPath ?? "")
+                        .absoluteString
+                }
+                let images = try await AssetsManager.load(Image.self, at: atlasPaths)
 
-                    let image = try await AssetsManager.load(
-                        Image.self,
-                        at: atlasPath.absoluteString
-                    )
-
+                for (tileSource, image) in zip(project.defs.tilesets, images) {
                     let source = TextureAtlasTileSource(
                         from: image.asset,
                         size: SizeInt(width: tileSource.tileGridSize, height: tileSource.tileGridSize),
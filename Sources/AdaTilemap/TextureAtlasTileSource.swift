@@ -226,5 +226,15 @@ extension TextureAtlasTileSource {
             self.animationColumnsAlignment = alignment
             return self
         }
+
+        /// Set the collision of the tile.
+        ///
+        /// - Parameter collision: The collision of the tile, or nil if the tile doesn't collide.
+        /// - Returns: The atlas tile data.
+        @discardableResult
+        public func setCollision(_ collision: TileCollision?) -> Self {
+            self.tileData.collision = collision
+            return self
+        }
     }
 }
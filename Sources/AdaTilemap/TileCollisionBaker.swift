@@ -0,0 +1,214 @@
+//
+//  TileCollisionBaker.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import AdaPhysics
+import Math
+
+/// Describes how solid tiles of a layer are turned into collision shapes.
+public enum TileCollisionBakeMode: Codable, Sendable {
+    /// Outline of solid tiles as one-sided chain loops. Bodies slide along the chain without catching on tile seams.
+    case chainLoops
+    /// Solid tiles merged into the largest rectangles. Use it when solid areas must stay solid inside, e.g. for queries.
+    case mergedPolygons
+}
+
+/// Collision of a tile.
+public enum TileCollision: Codable, Hashable, Sendable {
+    /// Tile fully covers its cell. Neighbouring solid tiles are baked together.
+    case solid
+    /// Custom shapes in tile **local** space, centered on the tile.
+    case shapes([Shape2DResource])
+}
+
+/// Bakes a solid bitmap of a tile chunk into a few collision shapes.
+///
+/// Cells are addressed from the bottom left corner, and shapes are built in chunk local space,
+/// where the bottom left corner of cell `(0, 0)` is the origin.
+struct TileCollisionBaker {
+
+    let width: Int
+    let height: Int
+
+    private var solid: [Bool]
+
+    init(width: Int, height: Int) {
+        self.width = width
+        self.height = height
+        self.solid = Array(repeating: false, count: width * height)
+    }
+
+    /// Cells outside of the bitmap are empty.
+    subscript(x: Int, y: Int) -> Bool {
+        get {
+            guard x >= 0, y >= 0, x < width, y < height else {
+                return false
+            }
+
+            return solid[y * width + x]
+        }
+        set {
+            solid[y * width + x] = newValue
+        }
+    }
+
+    var isEmpty: Bool {
+        return !solid.contains(true)
+    }
+
+    /// Returns collision shapes of solid cells.
+    func makeShapes(mode: TileCollisionBakeMode, tileSize: Size) -> [Shape2DResource] {
+        switch mode {
+        case .chainLoops:
+            return self.contours().map { contour in
+                Shape2DResource.generateChain(
+                    points: contour.map { Vector2(Float($0.x) * tileSize.width, Float($0.y) * tileSize.height) },
+                    isLoop: true
+                )
+            }
+        case .mergedPolygons:
+            return self.rectangles().map { rect in
+                let width = Float(rect.size.width) * tileSize.width
+                let height = Float(rect.size.height) * tileSize.height
+
+                return Shape2DResource
+                    .generateBox(width: width, height: height)
+                    .offsetBy(
+                        x: Float(rect.origin.x) * tileSize.width + width / 2,
+                        y: Float(rect.origin.y) * tileSize.height + height / 2
+                    )
+            }
+        }
+    }
+
+    // MARK: - Contours
+
+    private enum Direction {
+        static let east: UInt8 = 0
+        static let north: UInt8 = 1
+        static let west: UInt8 = 2
+        static let south: UInt8 = 3
+    }
+
+    /// Marching squares over the cell corners.
+    ///
+    /// Each boundary edge is directed so that solid cells are on its left, so outer contours are counter-clockwise
+    /// and holes are clockwise. Collinear edges are merged, so each contour contains only its corners.
+    /// Cells touching only by a corner are traced as separate contours.
+    func contours() -> [[PointInt]] {
+        let stride = width + 1
+        // Outgoing boundary edges of each corner, one bit per direction.
+        var edges = [UInt8](repeating: 0, count: stride * (height + 1))
+
+        for y in 0..<height {
+            for x in 0..<width where self[x, y] {
+                if !self[x, y - 1] {
+                    edges[y * stride + x] |= 1 << Direction.east
+                }
+                if !self[x + 1, y] {
+                    edges[y * stride + x + 1] |= 1 << Direction.north
+                }
+                if !self[x, y + 1] {
+                    edges[(y + 1) * stride + x + 1] |= 1 << Direction.west
+                }
+                if !self[x - 1, y] {
+                    edges[(y + 1) * stride + x] |= 1 << Direction.south
+                }
+            }
+        }
+
+        var used = [UInt8](repeating: 0, count: edges.count)
+        var contours: [[PointInt]] = []
+
+        for start in edges.indices where edges[start] != 0 {
+            for startDirection in Direction.east...Direction.south
+            where edges[start] & (1 << startDirection) != 0 && used[start] & (1 << startDirection) == 0 {
+                var corner = start
+                var direction = startDirection
+                var steps: [(corner: Int, direction: UInt8)] = []
+
+                while used[corner] & (1 << direction) == 0 {
+                    used[corner] |= 1 << direction
+                    steps.append((corner, direction))
+
+                    switch direction {
+                    case Direction.east: corner += 1
+                    case Direction.north: corner += stride
+                    case Direction.west: corner -= 1
+                    default: corner -= stride
+                    }
+
+                    // Only a saddle corner has two outgoing edges, turning left keeps diagonal cells apart.
+                    let outgoing = edges[corner]
+                    let left = (direction + 1) & 3
+                    let right = (direction + 3) & 3
+                    if outgoing & (1 << left) != 0 {
+                        direction = left
+                    } else if outgoing & (1 << direction) == 0 {
+                        direction = right
+                    }
+                }
+
+                var contour: [PointInt] = []
+                for index in steps.indices {
+                    let previous = steps[index == 0 ? steps.count - 1 : index - 1]
+                    if previous.direction != steps[index].direction {
+                        let corner = steps[index].corner
+                        contour.append(PointInt(x: corner % stride, y: corner / stride))
+                    }
+                }
+                contours.append(contour)
+            }
+        }
+
+        return contours
+    }
+
+    // MARK: - Rectangles
+
+    /// Greedy merge of solid cells, first along rows and then upwards while the whole row span is solid.
+    func rectangles() -> [RectInt] {
+        var covered = [Bool](repeating: false, count: solid.count)
+        var rectangles: [RectInt] = []
+
+        for y in 0..<height {
+            var x = 0
+            while x < width {
+                guard self[x, y] && !covered[y * width + x] else {
+                    x += 1
+                    continue
+                }
+
+                var rectWidth = 1
+                while x + rectWidth < width && self[x + rectWidth, y] && !covered[y * width + x + rectWidth] {
+                    rectWidth += 1
+                }
+
+                var rectHeight = 1
+                rowLoop: while y + rectHeight < height {
+                    for column in x..<(x + rectWidth) {
+                        let index = (y + rectHeight) * width + column
+                        if !solid[index] || covered[index] {
+                            break rowLoop
+                        }
+                    }
+                    rectHeight += 1
+                }
+
+                for row in y..<(y + rectHeight) {
+                    for column in x..<(x + rectWidth) {
+                        covered[row * width + column] = true
+                    }
+                }
+
+                rectangles.append(RectInt(x: x, y: y, width: rectWidth, height: rectHeight))
+                x += rectWidth
+            }
+        }
+
+        return rectangles
+    }
+}
@@ -23,6 +23,12 @@ public struct TileMapComponent {
     /// Each tile layer contains root entity that holds tile sprite entitis with physic bodies.
     internal var tileLayers: [TileMapLayer.ID: Entity.ID] = [:]
 
+    /// Entities with baked collision of each tile layer, keyed by collision chunk.
+    internal var collisionChunks: [TileMapLayer.ID: [PointInt: Entity.ID]] = [:]
+
+    /// Tile map position the collision chunks are placed at.
+    internal var collisionPosition: Vector3?
+
     public init(tileMap: TileMap, tileDisplaySize: Size) {
         self.tileMap = tileMap
         self.tileDisplaySize = tileDisplaySize
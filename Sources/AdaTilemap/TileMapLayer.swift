@@ -5,6 +5,7 @@
 //  Created by v.prusakov on 5/5/24.
 //
 
+import AdaPhysics
 import AdaUtils
 import OrderedCollections
 import Math
@@ -49,6 +50,23 @@ public class TileMapLayer: Identifiable, @unchecked Sendable {
         }
     }
 
+    /// The collision filter of tiles with collision.
+    public var collisionFilter: CollisionFilter = CollisionFilter() {
+        didSet {
+            self.setNeedsCollisionUpdate()
+        }
+    }
+
+    /// Describes how solid tiles are baked into collision shapes.
+    public var collisionBakeMode: TileCollisionBakeMode = .chainLoops {
+        didSet {
+            self.setNeedsCollisionUpdate()
+        }
+    }
+
+    /// Size of a collision chunk in tiles. Each chunk is baked into one static body.
+    static let collisionChunkSize = 16
+
     /// A Boolean value indicating whether the tile map layer needs to be updated.
     internal private(set) var needUpdates = false {
         didSet {
@@ -56,6 +74,13 @@ public class TileMapLayer: Identifiable, @unchecked Sendable {
         }
     }
 
+    /// Collision chunks which tiles were changed since the last bake.
+    internal private(set) var dirtyCollisionChunks: Set<PointInt> = [] {
+        didSet {
+            self.tileMap?.setNeedsUpdate()
+        }
+    }
+
     /// Set a cell for the tile map layer.
     ///
     /// - Parameters:
@@ -67,6 +92,7 @@ public class TileMapLayer: Identifiable, @unchecked Sendable {
             atlasCoordinates: atlasCoordinates,
             sourceId: sourceId
         )
+        self.dirtyCollisionChunks.insert(Self.collisionChunk(for: position))
     }
 
     /// Remove a cell from the tile map layer.
@@ -74,10 +100,12 @@ public class TileMapLayer: Identifiable, @unchecked Sendable {
     /// - Parameter position: The position of the cell.
     public func removeCell(at position: PointInt) {
         self.tileCells[position] = nil
+        self.dirtyCollisionChunks.insert(Self.collisionChunk(for: position))
     }
 
     /// Remove all cells from the tile map layer.
     public func removeAllCells() {
+        self.setNeedsCollisionUpdate()
         self.tileCells = [:]
     }
 
@@ -102,10 +130,31 @@ public class TileMapLayer: Identifiable, @unchecked Sendable {
     /// Set the tile map layer needs update.
     func setNeedsUpdate() {
         self.needUpdates = true
+        self.setNeedsCollisionUpdate()
     }
 
     /// Update the tile map layer did finish.
     func updateDidFinish() {
         self.needUpdates = false
     }
+
+    /// Returns collision chunks to bake and clears them.
+    func takeDirtyCollisionChunks() -> Set<PointInt> {
+        defer { self.dirtyCollisionChunks = [] }
+        return self.dirtyCollisionChunks
+    }
+
+    /// Returns the collision chunk containing the cell.
+    static func collisionChunk(for position: PointInt) -> PointInt {
+        let size = Self.collisionChunkSize
+        return PointInt(
+            x: position.x >= 0 ? position.x / size : (position.x + 1) / size - 1,
+            y: position.y >= 0 ? position.y / size : (position.y + 1) / size - 1
+        )
+    }
+
+    /// Mark all chunks with tiles to be baked again.
+    private func setNeedsCollisionUpdate() {
+        self.dirtyCollisionChunks.formUnion(self.tileCells.keys.map(Self.collisionChunk(for:)))
+    }
 }
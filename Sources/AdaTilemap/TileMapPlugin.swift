@@ -49,6 +49,10 @@ public struct TileMapSystem: Sendable {
         tileMap.forEach { entity, tileMapComponent, transform in
             let tileMap = tileMapComponent.tileMap
 
+            if let collisionPosition = tileMapComponent.collisionPosition, collisionPosition != transform.position {
+                self.moveCollision(tileMapComponent: tileMapComponent, transform: transform)
+            }
+
             if !tileMap.needsUpdate {
                 return
             }
@@ -61,6 +65,10 @@ public struct TileMapSystem: Sendable {
                     self.setEntityActive(entity, isActive: layer.isEnabled)
                 }
 
+                for entityId in tileMapComponent.collisionChunks[layer.id, default: [:]].values {
+                    context.world.getEntityByID(entityId)?.isActive = layer.isEnabled
+                }
+
                 self.addTiles(
                     for: layer,
                     tileMapComponent: tileMapComponent,
@@ -69,6 +77,7 @@ public struct TileMapSystem: Sendable {
                     world: context.world
                 )
             }
+            tileMapComponent.collisionPosition = transform.position
             tileMap.updateDidFinish()
         }
     }
@@ -106,6 +115,11 @@ public struct TileMapSystem: Sendable {
                 Transform()
             }
 
+            // Atlas tiles share the same components, so they are spawned with one batch.
+            var atlasTiles: [(sprite: Sprite, transform: Transform, occluder: LightOccluder2D?)] = []
+            var entityTiles: [Entity] = []
+            atlasTiles.reserveCapacity(layer.tileCells.count)
+
             for (position, tile) in layer.tileCells {
                 guard let source = tileSet.sources[tile.sourceId] else {
                     logger.critical("TileSource not found for id: \(tile.sourceId)", metadata: [
@@ -122,48 +136,167 @@ public struct TileMapSystem: Sendable {
                     z: transform.position.z + Float(layer.zIndex)
                 )
 
-                let tileEntity: Entity
                 switch source {
                 case let atlasSource as TextureAtlasTileSource:
                     let texture = atlasSource.getTexture(at: tile.atlasCoordinates)
+                    var occluder: LightOccluder2D?
+                    if let ring = tileData.occluderPolygon, ring.count >= 3 {
+                        occluder = LightOccluder2D(points: ring)
+                    }
 
-                    tileEntity = Entity {
-                        Sprite(
+                    atlasTiles.append((
+                        sprite: Sprite(
                             texture: AssetHandle(texture),
                             tintColor: tileData.modulateColor,
                             size: tileSize
-                        )
-                        Transform(position: position)
-                    }
-                    if let ring = tileData.occluderPolygon, ring.count >= 3 {
-                        tileEntity.components += LightOccluder2D(points: ring)
-                    }
+                        ),
+                        transform: Transform(position: position),
+                        occluder: occluder
+                    ))
                 case let entitySource as TileEntityAtlasSource:
-                    tileEntity = entitySource.getEntity(at: tile.atlasCoordinates)
+                    let tileEntity = entitySource.getEntity(at: tile.atlasCoordinates)
                     tileEntity.components += Transform(position: position)
                     tileEntity.components[Sprite.self]?.size = tileSize
                     if let ring = tileData.occluderPolygon, ring.count >= 3 {
                         tileEntity.components += LightOccluder2D(points: ring)
                     }
+                    entityTiles.append(tileEntity)
                 default:
                     logger.warning("TileSource isn't supported for id: \(tile.sourceId)")
                     continue
                 }
+            }
 
-//                if tileData.useCollisition {
-//                    tileEntity.components += Collision2DComponent(
-//                        shapes: [.generateBox()],
-//                        filter: CollisionFilter(
-//                            categoryBitMask: tileData.physicLayer.collisionLayer,
-//                            collisionBitMask: tileData.physicLayer.collisionMask
-//                        )
-//                    )
-//                }
+            let tileParentId = tileParent.entityId
+            let tiles = atlasTiles
+            let atlasTileIds = commands.spawnBatch(count: tiles.count) { index in
+                let tile = tiles[index]
+                tile.sprite
+                tile.transform
+                RelationshipComponent(parent: tileParentId)
+                if let occluder = tile.occluder {
+                    occluder
+                }
+            }
+            tileParent.insert(RelationshipComponent(children: OrderedSet(atlasTileIds)))
 
+            for tileEntity in entityTiles {
                 tileParent.addChild(tileEntity)
             }
             tileMapComponent.tileLayers[layer.id] = tileParent.entityId
             layer.updateDidFinish()
         }
+
+        let dirtyChunks = layer.takeDirtyCollisionChunks()
+        if !dirtyChunks.isEmpty {
+            self.bakeCollision(
+                for: layer,
+                chunks: dirtyChunks,
+                tileSet: tileSet,
+                tileMapComponent: tileMapComponent,
+                transform: transform,
+                entity: entity
+            )
+        }
+    }
+
+    // MARK: - Collision
+
+    /// Replace static bodies of the changed chunks, tiles of other chunks keep their bodies.
+    ///
+    /// Chunk bodies are children of the tile map entity, so they are removed together with it.
+    /// Like tile sprites, they are laid out at unit scale and ignore the rotation of the tile map.
+    private func bakeCollision(
+        for layer: TileMapLayer,
+        chunks: Set<PointInt>,
+        tileSet: TileSet,
+        tileMapComponent: Ref<TileMapComponent>,
+        transform: Transform,
+        entity: Entity
+    ) {
+        let tileSize = tileMapComponent.wrappedValue.tileDisplaySize
+        let chunkSize = TileMapLayer.collisionChunkSize
+        let filter = layer.collisionFilter
+        var chunkEntities = tileMapComponent.collisionChunks[layer.id, default: [:]]
+
+        for chunk in chunks {
+            if let entityId = chunkEntities.removeValue(forKey: chunk) {
+                commands.entity(entity.id).removeChild(entityId)
+                commands.entity(entityId).removeFromWorld()
+            }
+
+            var baker = TileCollisionBaker(width: chunkSize, height: chunkSize)
+            var shapes: [Shape2DResource] = []
+
+            for y in 0..<chunkSize {
+                for x in 0..<chunkSize {
+                    let position = PointInt(x: chunk.x * chunkSize + x, y: chunk.y * chunkSize + y)
+                    guard
+                        let tile = layer.tileCells[position],
+                        let source = tileSet.sources[tile.sourceId]
+                    else {
+                        continue
+                    }
+
+                    switch source.getTileData(at: tile.atlasCoordinates).collision {
+                    case .solid:
+                        baker[x, y] = true
+                    case .shapes(let tileShapes):
+                        let center = Vector2(
+                            (Float(x) + 0.5) * tileSize.width,
+                            (Float(y) + 0.5) * tileSize.height
+                        )
+                        shapes.append(contentsOf: tileShapes.map { $0.translated(by: center) })
+                    case nil:
+                        continue
+                    }
+                }
+            }
+
+            if !baker.isEmpty {
+                shapes.append(contentsOf: baker.makeShapes(mode: layer.collisionBakeMode, tileSize: tileSize))
+            }
+
+            guard !shapes.isEmpty else {
+                continue
+            }
+
+            let origin = Self.collisionOrigin(of: chunk, tileSize: tileSize, position: transform.position)
+            let chunkEntity = commands.spawn("TileCollision<\((layer.id, chunk.x, chunk.y))>") {
+                Collision2DComponent(shapes: shapes, filter: filter)
+                Transform(position: origin)
+            }
+            commands.entity(entity.id).addChild(chunkEntity.entityId)
+            chunkEntities[chunk] = chunkEntity.entityId
+        }
+
+        tileMapComponent.collisionChunks[layer.id] = chunkEntities
+    }
+
+    /// Move chunk bodies after the tile map.
+    ///
+    /// Physics reads body positions from `Transform` of the entity itself, not from its parents,
+    /// so chunk transforms are kept in world space.
+    private func moveCollision(tileMapComponent: Ref<TileMapComponent>, transform: Transform) {
+        let tileSize = tileMapComponent.wrappedValue.tileDisplaySize
+
+        for chunkEntities in tileMapComponent.collisionChunks.values {
+            for (chunk, entityId) in chunkEntities {
+                let origin = Self.collisionOrigin(of: chunk, tileSize: tileSize, position: transform.position)
+                commands.entity(entityId).insert(Transform(position: origin))
+            }
+        }
+
+        tileMapComponent.collisionPosition = transform.position
+    }
+
+    /// Tiles are centered on their position, chunk origin is the bottom left corner of the first tile.
+    private static func collisionOrigin(of chunk: PointInt, tileSize: Size, position: Vector3) -> Vector3 {
+        let chunkSize = TileMapLayer.collisionChunkSize
+        return Vector3(
+            x: position.x + (Float(chunk.x * chunkSize) - 0.5) * tileSize.width,
+            y: position.y + (Float(chunk.y * chunkSize) - 0.5) * tileSize.height,
+            z: position.z
+        )
     }
 }
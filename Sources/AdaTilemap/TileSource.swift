@@ -80,6 +80,7 @@ struct TileData: Codable {
         case flipH = "f_h"
         case flipV = "f_v"
         case occluderPolygon = "occ"
+        case collision = "col"
     }
     
     var modulateColor = Color(1.0, 1.0, 1.0, 1.0)
@@ -87,4 +88,6 @@ struct TileData: Codable {
     var flipV: Bool = false
     /// Optional CCW polygon in tile **local** space for ``LightOccluder2D`` when the tile is spawned.
     var occluderPolygon: [Vector2]?
+    /// Collision baked into the layer chunk bodies by ``TileMapSystem``.
+    var collision: TileCollision?
 }
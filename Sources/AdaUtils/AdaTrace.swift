@@ -51,4 +51,53 @@ public enum AdaTrace {
             try await body()
         }
     }
+
+    /// Records a span that was measured outside of the tracer, for example timings reported by a native library.
+    /// - Parameters:
+    ///   - name: The span name.
+    ///   - start: Start time in nanoseconds since epoch.
+    ///   - duration: Duration in nanoseconds.
+    ///   - parent: The parent span. Uses the current context if nil.
+    ///   - attributes: Counters attached to the span.
+    /// - Returns: The ended span, pass it as a parent of nested spans.
+    @discardableResult
+    public static func recordSpan(
+        _ name: String,
+        start: UInt64,
+        duration: UInt64,
+        parent: (any Span)? = nil,
+        attributes: [String: Int] = [:],
+        function: String = #function,
+        file fileID: String = #fileID,
+        line: UInt = #line
+    ) -> any Span {
+        let span = InstrumentationSystem.tracer.startSpan(
+            name,
+            context: parent?.context ?? ServiceContext.current ?? .topLevel,
+            ofKind: .internal,
+            at: Instant(nanosecondsSinceEpoch: start),
+            function: function,
+            file: fileID,
+            line: line
+        )
+        for (key, value) in attributes {
+            span.attributes[key] = value
+        }
+        span.end(at: Instant(nanosecondsSinceEpoch: start + duration))
+        return span
+    }
+
+    /// Current time in nanoseconds since epoch, in the clock used by ``recordSpan(_:start:duration:parent:attributes:function:file:line:)``.
+    public static var nowNanoseconds: UInt64 {
+        DefaultTracerClock.now.nanosecondsSinceEpoch
+    }
+
+    /// Point of time of a recorded span.
+    public struct Instant: TracerInstant {
+        public let nanosecondsSinceEpoch: UInt64
+
+        public static func < (lhs: Instant, rhs: Instant) -> Bool {
+            lhs.nanosecondsSinceEpoch < rhs.nanosecondsSinceEpoch
+        }
+    }
 }
@@ -67,4 +67,16 @@ public class FileSystem: @unchecked Sendable {
     public func readFile(at url: URL) -> Data? {
         fatalErrorMethodNotImplemented()
     }
+
+    /// Reads the file at the specified path in chunks of the buffer size, without holding the whole file in memory.
+    /// - Parameter buffer: A buffer reused for each chunk.
+    /// - Parameter body: Called with each chunk, returns false to stop reading.
+    /// - Returns: False if the file can't be opened or read.
+    public func readFile(
+        at url: URL,
+        into buffer: UnsafeMutableRawBufferPointer,
+        body: (UnsafeRawBufferPointer) throws -> Bool
+    ) rethrows -> Bool {
+        fatalErrorMethodNotImplemented()
+    }
 }
@@ -66,4 +66,31 @@ final class FoundationFileSystem: FileSystem, @unchecked Sendable {
     override func readFile(at url: URL) -> Data? {
         return self.fileManager.contents(atPath: url.path)
     }
+
+    override func readFile(
+        at url: URL,
+        into buffer: UnsafeMutableRawBufferPointer,
+        body: (UnsafeRawBufferPointer) throws -> Bool
+    ) rethrows -> Bool {
+        let file = unsafe url.withUnsafeFileSystemRepresentation { path -> UnsafeMutablePointer<FILE>? in
+            guard let path = unsafe path else {
+                return nil
+            }
+            return unsafe fopen(path, "rb")
+        }
+        guard let file = unsafe file else {
+            return false
+        }
+        defer { unsafe fclose(file) }
+
+        while true {
+            let count = unsafe fread(buffer.baseAddress, 1, buffer.count, file)
+            if count == 0 {
+                return unsafe ferror(file) == 0
+            }
+            guard unsafe try body(UnsafeRawBufferPointer(rebasing: buffer[..<count])) else {
+                return true
+            }
+        }
+    }
 }
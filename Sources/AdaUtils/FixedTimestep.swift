@@ -20,6 +20,12 @@ public struct FixedTimestep: Sendable {
     public var step: TimeInterval
     
     var accumulator: TimeInterval = 0
+
+    /// Part of the step accumulated since the last fixed tick, in range `0..<1`.
+    /// Use it to blend states of the two last fixed ticks.
+    public var overstepFraction: Float {
+        return self.step > 0 ? self.accumulator / self.step : 0
+    }
     
     /// Creates a FixedTimestep that ticks once every step seconds.
     public init(step: TimeInterval = 0) {
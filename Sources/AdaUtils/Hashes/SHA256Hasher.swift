@@ -0,0 +1,182 @@
+//
+//  SHA256Hasher.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+/// 256-bit digest produced by ``SHA256Hasher``.
+public struct SHA256Digest: Hashable, Sendable {
+    public let word0: UInt64
+    public let word1: UInt64
+    public let word2: UInt64
+    public let word3: UInt64
+
+    public init(word0: UInt64, word1: UInt64, word2: UInt64, word3: UInt64) {
+        self.word0 = word0
+        self.word1 = word1
+        self.word2 = word2
+        self.word3 = word3
+    }
+
+    /// Digest bytes in big-endian order, as defined by the SHA-256 standard.
+    public var bytes: [UInt8] {
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(32)
+        for word in [word0, word1, word2, word3] {
+            for shift in stride(from: 56, through: 0, by: -8) {
+                bytes.append(UInt8(truncatingIfNeeded: word >> UInt64(shift)))
+            }
+        }
+        return bytes
+    }
+
+    /// Lowercase hexadecimal representation of the digest.
+    public var hexString: String {
+        let digits = Array("0123456789abcdef")
+        var string = ""
+        string.reserveCapacity(64)
+        for byte in self.bytes {
+            string.append(digits[Int(byte >> 4)])
+            string.append(digits[Int(byte & 0x0F)])
+        }
+        return string
+    }
+}
+
+/// Calculate SHA-256 digest.
+///
+/// Unlike ``FNVHasher`` it is collision resistant, so it can be used as a key for content addressed storages.
+/// - SeeAlso: FIPS 180-4 - https://csrc.nist.gov/publications/detail/fips/180/4/final
+public struct SHA256Hasher {
+
+    private static let roundConstants: [UInt32] = [
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    ]
+
+    private var state: [UInt32] = [
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    ]
+    private var block: [UInt8] = []
+    private var schedule = [UInt32](repeating: 0, count: 64)
+    private var length: UInt64 = 0
+
+    public init() {
+        self.block.reserveCapacity(64)
+    }
+
+    /// Adds the given bytes to the digest.
+    public mutating func combine<Bytes: Sequence>(contentsOf bytes: Bytes) where Bytes.Element == UInt8 {
+        for byte in bytes {
+            self.block.append(byte)
+            if self.block.count == 64 {
+                self.processBlock()
+            }
+        }
+    }
+
+    /// Adds UTF-8 representation of the string followed by a terminator,
+    /// so sequential strings can't be confused with each other.
+    public mutating func combine(_ string: String) {
+        self.combine(contentsOf: string.utf8)
+        self.combine(contentsOf: CollectionOfOne(0xFF))
+    }
+
+    /// Adds little-endian bytes of the integer to the digest.
+    public mutating func combine<T: FixedWidthInteger>(_ value: T) {
+        var value = value.littleEndian
+        for _ in 0..<MemoryLayout<T>.size {
+            self.combine(contentsOf: CollectionOfOne(UInt8(truncatingIfNeeded: value)))
+            value >>= 8
+        }
+    }
+
+    /// Finalizes the hasher state and returns the digest.
+    public consuming func finalize() -> SHA256Digest {
+        let bitLength = (self.length + UInt64(self.block.count)) &* 8
+
+        self.block.append(0x80)
+        if self.block.count > 56 {
+            self.block.append(contentsOf: repeatElement(0, count: 64 - self.block.count))
+            self.processBlock()
+        }
+        self.block.append(contentsOf: repeatElement(0, count: 56 - self.block.count))
+        for shift in stride(from: 56, through: 0, by: -8) {
+            self.block.append(UInt8(truncatingIfNeeded: bitLength >> UInt64(shift)))
+        }
+        self.processBlock()
+
+        return SHA256Digest(
+            word0: UInt64(state[0]) << 32 | UInt64(state[1]),
+            word1: UInt64(state[2]) << 32 | UInt64(state[3]),
+            word2: UInt64(state[4]) << 32 | UInt64(state[5]),
+            word3: UInt64(state[6]) << 32 | UInt64(state[7])
+        )
+    }
+
+    // MARK: - Private
+
+    private mutating func processBlock() {
+        for index in 0..<16 {
+            self.schedule[index] = UInt32(block[index * 4]) << 24
+                | UInt32(block[index * 4 + 1]) << 16
+                | UInt32(block[index * 4 + 2]) << 8
+                | UInt32(block[index * 4 + 3])
+        }
+
+        for index in 16..<64 {
+            let w15 = schedule[index - 15]
+            let w2 = schedule[index - 2]
+            let s0 = w15.rotatedRight(7) ^ w15.rotatedRight(18) ^ (w15 >> 3)
+            let s1 = w2.rotatedRight(17) ^ w2.rotatedRight(19) ^ (w2 >> 10)
+            self.schedule[index] = schedule[index - 16] &+ s0 &+ schedule[index - 7] &+ s1
+        }
+
+        var a = state[0], b = state[1], c = state[2], d = state[3]
+        var e = state[4], f = state[5], g = state[6], h = state[7]
+
+        for index in 0..<64 {
+            let s1 = e.rotatedRight(6) ^ e.rotatedRight(11) ^ e.rotatedRight(25)
+            let choice = (e & f) ^ (~e & g)
+            let temp1 = h &+ s1 &+ choice &+ Self.roundConstants[index] &+ schedule[index]
+            let s0 = a.rotatedRight(2) ^ a.rotatedRight(13) ^ a.rotatedRight(22)
+            let majority = (a & b) ^ (a & c) ^ (b & c)
+            let temp2 = s0 &+ majority
+
+            h = g
+            g = f
+            f = e
+            e = d &+ temp1
+            d = c
+            c = b
+            b = a
+            a = temp1 &+ temp2
+        }
+
+        self.state[0] &+= a
+        self.state[1] &+= b
+        self.state[2] &+= c
+        self.state[3] &+= d
+        self.state[4] &+= e
+        self.state[5] &+= f
+        self.state[6] &+= g
+        self.state[7] &+= h
+
+        self.length &+= 64
+        self.block.removeAll(keepingCapacity: true)
+    }
+}
+
+private extension UInt32 {
+    @inline(__always)
+    func rotatedRight(_ count: UInt32) -> UInt32 {
+        return (self >> count) | (self << (32 - count))
+    }
+}
@@ -11,6 +11,18 @@
 #include <glslang/Include/Types.h>
 #include <glslang/Public/ShaderLang.h>
 #include <SPIRV/GlslangToSpv.h>
+#include <SPIRV/SPVRemapper.h>
+#include <SPIRV/spirv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if !defined(__wasi__)
+#include <thread>
+#endif
 
 const TBuiltInResource DefaultTBuiltInResource = {
     /* .MaxLights = */ 32,
@@ -129,6 +141,298 @@ const TBuiltInResource DefaultTBuiltInResource = {
     }
 };
 
+namespace {
+
+struct spirv_bin_storage {
+    std::vector<uint32_t> words;
+    std::vector<std::string> include_paths;
+    std::vector<spirv_include_dependency> includes;
+    std::vector<uint32_t> names;
+};
+
+spirv_bin make_result(spirv_bin_storage *storage) {
+    spirv_bin result;
+    result.bytes = storage->words.data();
+    result.length = (storage->words.size() * sizeof(uint32_t));
+    result.includes = storage->includes.data();
+    result.includes_count = storage->includes.size();
+    result.names = storage->names.data();
+    result.names_length = (storage->names.size() * sizeof(uint32_t));
+    result.storage = storage;
+    return result;
+}
+
+// MARK: - Remap
+
+const size_t SpirvHeaderWordCount = 5;
+
+thread_local bool remap_failed = false;
+
+/// Default remapper error handler terminates the process, so errors are reported to the calling thread instead.
+void install_remap_error_handler() {
+    static const bool installed = []() {
+        spv::spirvbin_t::registerErrorHandler([](const std::string &message) {
+            printf("SPIR-V remap error: %s\n", message.c_str());
+            remap_failed = true;
+        });
+        return true;
+    }();
+    (void)installed;
+}
+
+/// Returns false if instructions don't fit the module.
+bool is_valid_module(const std::vector<uint32_t> &words) {
+    if (words.size() < SpirvHeaderWordCount || words[0] != spv::MagicNumber) {
+        return false;
+    }
+    
+    for (size_t offset = SpirvHeaderWordCount; offset < words.size();) {
+        uint32_t word_count = words[offset] >> spv::WordCountShift;
+        if (word_count == 0 || offset + word_count > words.size()) {
+            return false;
+        }
+        offset += word_count;
+    }
+    
+    return true;
+}
+
+/// Instructions which are placed before debug names in the logical layout of a module.
+bool precedes_names(spv::Op opcode) {
+    switch (opcode) {
+    case spv::OpCapability:
+    case spv::OpExtension:
+    case spv::OpExtInstImport:
+    case spv::OpMemoryModel:
+    case spv::OpEntryPoint:
+    case spv::OpExecutionMode:
+    case spv::OpExecutionModeId:
+    case spv::OpString:
+    case spv::OpSource:
+    case spv::OpSourceExtension:
+    case spv::OpSourceContinued:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Remove debug instructions from the valid module. Names are moved to `names`, so reflection can restore them.
+void strip_debug_info(std::vector<uint32_t> &words, std::vector<uint32_t> &names) {
+    size_t write_offset = SpirvHeaderWordCount;
+    
+    for (size_t offset = SpirvHeaderWordCount; offset < words.size();) {
+        uint32_t word_count = words[offset] >> spv::WordCountShift;
+        spv::Op opcode = spv::Op(words[offset] & spv::OpCodeMask);
+        
+        switch (opcode) {
+        case spv::OpName:
+        case spv::OpMemberName:
+            names.insert(names.end(), words.begin() + offset, words.begin() + offset + word_count);
+            break;
+        case spv::OpString:
+        case spv::OpSource:
+        case spv::OpSourceExtension:
+        case spv::OpSourceContinued:
+        case spv::OpLine:
+        case spv::OpNoLine:
+        case spv::OpModuleProcessed:
+            break;
+        default:
+            // Instructions are moved in place, the module only shrinks.
+            std::copy(words.begin() + offset, words.begin() + offset + word_count, words.begin() + write_offset);
+            write_offset += word_count;
+            break;
+        }
+        
+        offset += word_count;
+    }
+    
+    words.resize(write_offset);
+}
+
+bool remap_module(std::vector<uint32_t> &words, unsigned int flags, std::vector<uint32_t> &names, const char **error) {
+    if (!is_valid_module(words)) {
+        *error = "invalid SPIR-V module";
+        return false;
+    }
+    
+    if (flags & SPIRV_REMAP_CANONICALIZE) {
+        install_remap_error_handler();
+        
+        // Remapper leaves the module in an undefined state on error, so it works on a copy.
+        // Canonical IDs only make identical modules dedupe and compress better, they don't reliably
+        // shrink the word count, so on failure the original module is kept as is.
+        std::vector<uint32_t> remapped = words;
+        remap_failed = false;
+        spv::spirvbin_t remapper;
+        remapper.remap(remapped, spv::spirvbin_t::MAP_ALL);
+        if (!remap_failed) {
+            words = std::move(remapped);
+        }
+    }
+    
+    if (flags & SPIRV_REMAP_STRIP) {
+        strip_debug_info(words, names);
+    }
+    
+    return true;
+}
+
+uint64_t fnv1a_hash(const std::string &content) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char byte : content) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool read_file(const std::string &path, std::string &content) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    
+    char buffer[4096];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, count);
+    }
+    
+    fclose(file);
+    return true;
+}
+
+std::string directory_of(const std::string &path) {
+    size_t separator = path.find_last_of("/\\");
+    return separator == std::string::npos ? std::string() : path.substr(0, separator);
+}
+
+std::string join_path(const std::string &directory, const std::string &file) {
+    if (directory.empty()) {
+        return file;
+    }
+    char last = directory.back();
+    return (last == '/' || last == '\\') ? directory + file : directory + "/" + file;
+}
+
+/// Resolves `#include` directives against engine search paths and records every included file.
+///
+/// `#include "PATH"` is resolved relative to the including file first, then against local search paths.
+/// `#include <MODULE_NAME/PATH>` is resolved against search paths of the module with the same name.
+class SearchPathIncluder : public glslang::TShader::Includer {
+public:
+    static const size_t MaxIncludeDepth = 64;
+    
+    SearchPathIncluder(const spirv_include_search_path *search_paths, unsigned long count)
+        : search_paths(search_paths), search_paths_count(count) {}
+    
+    IncludeResult* includeLocal(const char *header_name, const char *includer_name, size_t depth) override {
+        if (depth > MaxIncludeDepth) {
+            return make_error("include depth limit exceeded, possibly a recursive include");
+        }
+        
+        if (includer_name && includer_name[0] != '\0') {
+            if (IncludeResult *result = try_open(join_path(directory_of(includer_name), header_name))) {
+                return result;
+            }
+        }
+        
+        for (unsigned long i = 0; i < search_paths_count; i++) {
+            const spirv_include_search_path &search_path = search_paths[i];
+            if (search_path.module_name || !search_path.path) {
+                continue;
+            }
+            
+            if (IncludeResult *result = try_open(join_path(search_path.path, header_name))) {
+                return result;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    IncludeResult* includeSystem(const char *header_name, const char *, size_t depth) override {
+        if (depth > MaxIncludeDepth) {
+            return make_error("include depth limit exceeded, possibly a recursive include");
+        }
+        
+        std::string name(header_name);
+        size_t separator = name.find('/');
+        if (separator == std::string::npos) {
+            return nullptr;
+        }
+        
+        std::string module_name = name.substr(0, separator);
+        std::string file_path = name.substr(separator + 1);
+        
+        for (unsigned long i = 0; i < search_paths_count; i++) {
+            const spirv_include_search_path &search_path = search_paths[i];
+            if (!search_path.module_name || !search_path.path || module_name != search_path.module_name) {
+                continue;
+            }
+            
+            if (IncludeResult *result = try_open(join_path(search_path.path, file_path))) {
+                return result;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    void releaseInclude(IncludeResult *result) override {
+        if (result) {
+            delete static_cast<std::string *>(result->userData);
+            delete result;
+        }
+    }
+    
+    /// Move collected dependencies to the compilation result.
+    void collect_dependencies(spirv_bin_storage &storage) {
+        storage.include_paths = std::move(dependency_paths);
+        storage.includes.reserve(storage.include_paths.size());
+        for (size_t i = 0; i < storage.include_paths.size(); i++) {
+            storage.includes.push_back({ storage.include_paths[i].c_str(), dependency_hashes[i] });
+        }
+    }
+    
+private:
+    IncludeResult* try_open(const std::string &path) {
+        std::string *content = new std::string();
+        if (!read_file(path, *content)) {
+            delete content;
+            return nullptr;
+        }
+        
+        record_dependency(path, *content);
+        return new IncludeResult(path, content->data(), content->size(), content);
+    }
+    
+    IncludeResult* make_error(const char *message) {
+        std::string *content = new std::string(message);
+        return new IncludeResult("", content->data(), content->size(), content);
+    }
+    
+    void record_dependency(const std::string &path, const std::string &content) {
+        for (const std::string &dependency_path : dependency_paths) {
+            if (dependency_path == path) {
+                return;
+            }
+        }
+        
+        dependency_paths.push_back(path);
+        dependency_hashes.push_back(fnv1a_hash(content));
+    }
+    
+    const spirv_include_search_path *search_paths;
+    unsigned long search_paths_count;
+    std::vector<std::string> dependency_paths;
+    std::vector<uint64_t> dependency_hashes;
+};
+
+}
+
 int glslang_initialize() {
     return glslang::InitializeProcess();
 }
@@ -158,41 +462,31 @@ spirv_bin compile_shader_glsl(
     glslang::EShTargetClientVersion ClientVersion = glslang::EShTargetVulkan_1_1;
     glslang::EShTargetLanguageVersion TargetVersion = glslang::EShTargetSpv_1_3;
     
-    glslang::TShader::ForbidIncluder includer;
+    SearchPathIncluder includer(options.include_search_paths, options.include_search_paths_count);
     glslang::TShader shader(stages[stage]);
     shader.setStrings(&cs_strings, 1);
     shader.setEnvInput(glslang::EShSourceGlsl, stages[stage], glslang::EShClientVulkan, ClientInputSemanticsVersion);
     shader.setEnvClient(glslang::EShClientVulkan, ClientVersion);
     shader.setEnvTarget(glslang::EShTargetSpv, TargetVersion);
     
+    // Includes are resolved by `SearchPathIncluder`, so shaders don't need to enable the extension by themselves.
+    std::string preamble = "#extension GL_GOOGLE_include_directive : enable\n";
     if (options.preamble) {
-        shader.setPreamble(options.preamble);
+        preamble += options.preamble;
     }
+    shader.setPreamble(preamble.c_str());
     
-    std::string pre_processed_code;
     EShMessages message = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
     
-    if (!shader.preprocess(&DefaultTBuiltInResource, DefaultVersion, ENoProfile, false, false, message, &pre_processed_code, includer)) {
-        printf("===== GLSL PREPROCESSING ERROR =====\n");
-        printf("Shader source:\n%s\n", source);
-        printf("Preprocessor error:\n%s\n", shader.getInfoDebugLog());
-        printf("===================================\n");
-        *error = "failed to preprocess a shader";
-        return {};
-    }
-    
-    cs_strings = pre_processed_code.c_str();
-    
-    shader.setStrings(&cs_strings, 1);
-    
-    if (!shader.parse(&DefaultTBuiltInResource, DefaultVersion, false, message)) {
+    // Parse runs the preprocessor itself, so we don't need a separate preprocess pass
+    // and a second copy of the expanded source.
+    if (!shader.parse(&DefaultTBuiltInResource, DefaultVersion, ENoProfile, false, false, message, includer)) {
         printf("===== GLSL PARSE ERROR =====\n");
         printf("Shader source:\n%s\n", source);
-        printf("Preprocessor error:\n%s\n", shader.getInfoDebugLog());
+        printf("Parse error:\n%s\n", shader.getInfoLog());
+        printf("%s\n", shader.getInfoDebugLog());
         printf("===================================\n");
         *error = "failed to parse a shader";
-        printf("%s", shader.getInfoLog());
-        
         return {};
     }
     
@@ -205,19 +499,127 @@ spirv_bin compile_shader_glsl(
         return {};
     }
     
-    std::vector<uint32_t> SpirV;
+    // The storage is handed over to the caller as is, so SPIR-V words are never copied.
+    // Memory must be released with `spirv_bin_free`.
+    spirv_bin_storage *storage = new spirv_bin_storage();
     spv::SpvBuildLogger logger;
     glslang::SpvOptions spvOptions;
-    glslang::GlslangToSpv(*program.getIntermediate(stages[stage]), SpirV, &logger, &spvOptions);
+    glslang::GlslangToSpv(*program.getIntermediate(stages[stage]), storage->words, &logger, &spvOptions);
+    includer.collect_dependencies(*storage);
     
-    spirv_bin result;
-    uint32_t *buffer = new uint32_t[SpirV.size()];
-    result.bytes = buffer;
-    result.length = (SpirV.size() * sizeof(uint32_t));
+    if (options.remap_flags != SPIRV_REMAP_NONE && !remap_module(storage->words, options.remap_flags, storage->names, error)) {
+        delete storage;
+        return {};
+    }
     
-    {
-        memcpy(buffer, SpirV.data(), SpirV.size() * sizeof(uint32_t));
+    return make_result(storage);
+}
+
+void spirv_bin_free(spirv_bin bin) {
+    delete static_cast<spirv_bin_storage *>(bin.storage);
+}
+
+spirv_bin spirv_remap(
+                      const void *bytes,
+                      unsigned long length,
+                      unsigned int remap_flags,
+                      const char **error
+                      ) {
+    const uint32_t *words = static_cast<const uint32_t *>(bytes);
+    spirv_bin_storage *storage = new spirv_bin_storage();
+    storage->words.assign(words, words + length / sizeof(uint32_t));
+    
+    if (!remap_module(storage->words, remap_flags, storage->names, error)) {
+        delete storage;
+        return {};
     }
     
-    return result;
+    return make_result(storage);
+}
+
+spirv_bin spirv_restore_names(
+                              const void *bytes,
+                              unsigned long length,
+                              const void *names,
+                              unsigned long names_length,
+                              const char **error
+                              ) {
+    const uint32_t *words = static_cast<const uint32_t *>(bytes);
+    const uint32_t *name_words = static_cast<const uint32_t *>(names);
+    size_t words_count = length / sizeof(uint32_t);
+    size_t names_count = names_length / sizeof(uint32_t);
+    
+    spirv_bin_storage *storage = new spirv_bin_storage();
+    storage->words.assign(words, words + words_count);
+    
+    if (!is_valid_module(storage->words)) {
+        delete storage;
+        *error = "invalid SPIR-V module";
+        return {};
+    }
+    
+    for (size_t offset = 0; offset < names_count;) {
+        uint32_t word_count = name_words[offset] >> spv::WordCountShift;
+        spv::Op opcode = spv::Op(name_words[offset] & spv::OpCodeMask);
+        if (word_count == 0 || offset + word_count > names_count || (opcode != spv::OpName && opcode != spv::OpMemberName)) {
+            delete storage;
+            *error = "invalid SPIR-V names table";
+            return {};
+        }
+        offset += word_count;
+    }
+    
+    // Names go right after the preamble instructions, as required by the logical layout of a module.
+    size_t offset = SpirvHeaderWordCount;
+    while (offset < storage->words.size() && precedes_names(spv::Op(storage->words[offset] & spv::OpCodeMask))) {
+        offset += storage->words[offset] >> spv::WordCountShift;
+    }
+    
+    storage->words.insert(storage->words.begin() + offset, name_words, name_words + names_count);
+    return make_result(storage);
+}
+
+void compile_shader_glsl_batch(
+                               const spirv_compile_job *jobs,
+                               spirv_compile_result *results,
+                               unsigned long count,
+                               unsigned int max_threads
+                               ) {
+    std::atomic<unsigned long> next_job(0);
+    
+    // Workers pull jobs one by one, so a long shader doesn't hold back the rest of the batch.
+    auto worker = [&]() {
+        for (unsigned long index = next_job++; index < count; index = next_job++) {
+            const spirv_compile_job &job = jobs[index];
+            results[index].error = nullptr;
+            results[index].binary = compile_shader_glsl(job.source, job.stage, job.options, &results[index].error);
+        }
+    };
+    
+#if defined(__wasi__)
+    worker();
+#else
+    unsigned long thread_count = max_threads > 0 ? max_threads : std::thread::hardware_concurrency();
+    if (thread_count > count) {
+        thread_count = count;
+    }
+    
+    if (thread_count <= 1) {
+        worker();
+        return;
+    }
+    
+    // The calling thread is one of the workers.
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned long i = 0; i < thread_count - 1; i++) {
+        threads.emplace_back(worker);
+    }
+    
+    worker();
+    
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+#endif
 }
@@ -23,13 +23,50 @@ typedef enum {
     SHADER_STAGE_MAX,
 } shaderc_stage;
 
+typedef struct {
+    /// Directory used to resolve includes.
+    const char *path;
+    /// Module name for `#include <MODULE_NAME/PATH>` includes. NULL for `#include "PATH"` includes.
+    const char *module_name;
+} spirv_include_search_path;
+
+/// Post-processing of compiled SPIR-V.
+typedef enum {
+    SPIRV_REMAP_NONE = 0,
+    /// Renumber IDs in a canonical order, so modules compiled from similar sources share more bytes and compress well.
+    SPIRV_REMAP_CANONICALIZE = 1 << 0,
+    /// Remove debug instructions. `OpName` and `OpMemberName` are moved to `spirv_bin.names`,
+    /// so they can be restored for reflection with `spirv_restore_names`.
+    SPIRV_REMAP_STRIP = 1 << 1,
+} spirv_remap_flags;
+
 typedef struct {
     const char* preamble;
+    const spirv_include_search_path *include_search_paths;
+    unsigned long include_search_paths_count;
+    /// Combination of `spirv_remap_flags`.
+    unsigned int remap_flags;
 } spirv_options;
 
+/// File included while compiling a shader.
+typedef struct {
+    /// Resolved path to the included file.
+    const char *path;
+    /// FNV-1a 64-bit hash of the file content.
+    uint64_t content_hash;
+} spirv_include_dependency;
+
 typedef struct {
     const void *bytes;
     unsigned long length;
+    /// Transitive list of included files, each file reported once.
+    const spirv_include_dependency *includes;
+    unsigned long includes_count;
+    /// `OpName` and `OpMemberName` instructions removed by `SPIRV_REMAP_STRIP`, in the original order.
+    const void *names;
+    unsigned long names_length;
+    /// Opaque storage owning `bytes`, `includes` and `names`. Released by `spirv_bin_free`.
+    void *storage;
 } spirv_bin;
 
 int glslang_initialize(void);
@@ -42,6 +79,54 @@ spirv_bin compile_shader_glsl(
                               const char **error
                               );
 
+/// Release memory returned by `compile_shader_glsl`. Safe to call on an empty result.
+void spirv_bin_free(spirv_bin bin);
+
+/// Apply `spirv_remap_flags` to already compiled SPIR-V module.
+/// - Note: Result must be released with `spirv_bin_free`.
+spirv_bin spirv_remap(
+                      const void *bytes,
+                      unsigned long length,
+                      unsigned int remap_flags,
+                      const char **error
+                      );
+
+/// Insert names stripped by `SPIRV_REMAP_STRIP` back to the module, so reflection sees the original names.
+/// - Note: Result must be released with `spirv_bin_free`.
+spirv_bin spirv_restore_names(
+                              const void *bytes,
+                              unsigned long length,
+                              const void *names,
+                              unsigned long names_length,
+                              const char **error
+                              );
+
+/// Single shader compilation in a batch.
+typedef struct {
+    const char *source;
+    shaderc_stage stage;
+    spirv_options options;
+} spirv_compile_job;
+
+typedef struct {
+    /// Compiled SPIR-V. Must be released with `spirv_bin_free`.
+    spirv_bin binary;
+    /// Error message or NULL if compilation succeeded.
+    const char *error;
+} spirv_compile_result;
+
+/// Compile shaders concurrently on a pool of worker threads.
+/// Each job writes to the result with the same index, order of results doesn't depend on scheduling.
+/// - Parameter results: Array with `count` elements.
+/// - Parameter max_threads: Upper bound of worker threads. Pass 0 to use all hardware threads.
+/// - Note: `glslang_initialize` must be called before.
+void compile_shader_glsl_batch(
+                               const spirv_compile_job *jobs,
+                               spirv_compile_result *results,
+                               unsigned long count,
+                               unsigned int max_threads
+                               );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,335 @@
+//
+//  spirv_reflection.cpp
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+#include "spirv_reflection.h"
+
+#include <spriv_swift.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct spirv_translation_storage {
+    std::string reflection;
+    std::string source;
+    std::vector<std::string> entry_point_names;
+    std::vector<spirv_entry_point> entry_points;
+};
+
+thread_local std::string last_error;
+
+const char *set_error(spvc_context context) {
+    last_error = spvc_context_get_last_error_string(context);
+    return last_error.c_str();
+}
+
+template<typename T>
+void append(std::string &blob, const T &value) {
+    blob.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/// Builds reflection blob. Strings are deduplicated, so repeated member names are stored once.
+class ReflectionBuilder {
+public:
+    explicit ReflectionBuilder(spvc_compiler compiler) : compiler(compiler) {}
+
+    uint32_t add_string(const char *string) {
+        std::string value = string ? string : "";
+        for (size_t i = 0; i < string_offsets.size(); i++) {
+            if (strings.compare(string_offsets[i], value.size() + 1, value.c_str(), value.size() + 1) == 0) {
+                return string_offsets[i];
+            }
+        }
+
+        uint32_t offset = uint32_t(strings.size());
+        string_offsets.push_back(offset);
+        strings.append(value.c_str(), value.size() + 1);
+        return offset;
+    }
+
+    spirv_reflection_value_type value_type(spvc_type_id type_id) {
+        spvc_type type = spvc_compiler_get_type_handle(compiler, type_id);
+        return { uint32_t(spvc_type_get_basetype(type)), spvc_type_get_vector_size(type), spvc_type_get_columns(type) };
+    }
+
+    void add_resources(spvc_resources resources, spvc_resource_type type, spirv_resource_kind kind) {
+        const spvc_reflected_resource *list = nullptr;
+        size_t count = 0;
+        spvc_resources_get_resource_list_for_type(resources, type, &list, &count);
+
+        for (size_t i = 0; i < count; i++) {
+            const spvc_reflected_resource &resource = list[i];
+            spvc_type base_type = spvc_compiler_get_type_handle(compiler, resource.base_type_id);
+
+            spirv_reflection_resource record = {};
+            record.kind = kind;
+            record.name = add_string(resource.name);
+            record.descriptor_set = spvc_compiler_get_decoration(compiler, resource.id, SpvDecorationDescriptorSet);
+            record.binding = spvc_compiler_get_decoration(compiler, resource.id, SpvDecorationBinding);
+            record.first_member = uint32_t(members.size());
+
+            if (spvc_type_get_basetype(base_type) == SPVC_BASETYPE_STRUCT) {
+                size_t size = 0;
+                spvc_compiler_get_declared_struct_size(compiler, base_type, &size);
+                record.size = uint32_t(size);
+
+                unsigned members_count = spvc_type_get_num_member_types(base_type);
+                for (unsigned index = 0; index < members_count; index++) {
+                    spirv_reflection_member member = {};
+                    member.name = add_string(spvc_compiler_get_member_name(compiler, resource.base_type_id, index));
+
+                    size_t member_size = 0;
+                    spvc_compiler_get_declared_struct_member_size(compiler, base_type, index, &member_size);
+                    member.size = uint32_t(member_size);
+                    spvc_compiler_type_struct_member_offset(compiler, base_type, index, &member.offset);
+                    member.type = value_type(spvc_type_get_member_type(base_type, index));
+                    members.push_back(member);
+                }
+                record.members_count = members_count;
+            }
+
+            if (spvc_type_get_basetype(base_type) == SPVC_BASETYPE_IMAGE || spvc_type_get_basetype(base_type) == SPVC_BASETYPE_SAMPLED_IMAGE) {
+                record.image_dimension = spvc_type_get_image_dimension(base_type);
+                record.image_arrayed = spvc_type_get_image_arrayed(base_type);
+                record.image_multisampled = spvc_type_get_image_multisampled(base_type);
+                record.image_access = spvc_type_get_image_access_qualifier(base_type);
+            }
+
+            if (spvc_type_get_num_array_dimensions(base_type) > 0) {
+                record.array_size = spvc_type_get_array_dimension(base_type, 0);
+            }
+
+            this->resources.push_back(record);
+        }
+    }
+
+    void add_vertex_inputs(spvc_resources resources) {
+        const spvc_reflected_resource *list = nullptr;
+        size_t count = 0;
+        spvc_resources_get_resource_list_for_type(resources, SPVC_RESOURCE_TYPE_STAGE_INPUT, &list, &count);
+
+        for (size_t i = 0; i < count; i++) {
+            spirv_reflection_vertex_input input = {};
+            input.name = add_string(list[i].name);
+            input.location = spvc_compiler_get_decoration(compiler, list[i].id, SpvDecorationLocation);
+            input.type = value_type(list[i].type_id);
+            vertex_inputs.push_back(input);
+        }
+    }
+
+    std::string make_blob() {
+        // Keep the following arrays aligned.
+        strings.resize((strings.size() + 3) & ~size_t(3), '\0');
+
+        spirv_reflection_header header = {};
+        header.magic = SPIRV_REFLECTION_MAGIC;
+        header.version = SPIRV_REFLECTION_VERSION;
+        header.resources_count = uint32_t(resources.size());
+        header.members_count = uint32_t(members.size());
+        header.vertex_inputs_count = uint32_t(vertex_inputs.size());
+        header.strings_length = uint32_t(strings.size());
+
+        std::string blob;
+        blob.reserve(sizeof(header)
+                     + resources.size() * sizeof(spirv_reflection_resource)
+                     + members.size() * sizeof(spirv_reflection_member)
+                     + vertex_inputs.size() * sizeof(spirv_reflection_vertex_input)
+                     + strings.size());
+        append(blob, header);
+        for (const spirv_reflection_resource &resource : resources) {
+            append(blob, resource);
+        }
+        for (const spirv_reflection_member &member : members) {
+            append(blob, member);
+        }
+        for (const spirv_reflection_vertex_input &input : vertex_inputs) {
+            append(blob, input);
+        }
+        blob += strings;
+        return blob;
+    }
+
+private:
+    spvc_compiler compiler;
+    std::vector<spirv_reflection_resource> resources;
+    std::vector<spirv_reflection_member> members;
+    std::vector<spirv_reflection_vertex_input> vertex_inputs;
+    std::string strings;
+    std::vector<uint32_t> string_offsets;
+};
+
+spvc_backend backend_for(spirv_target_language language) {
+    switch (language) {
+    case SPIRV_TARGET_GLSL:
+        return SPVC_BACKEND_GLSL;
+    case SPIRV_TARGET_MSL:
+        return SPVC_BACKEND_MSL;
+    case SPIRV_TARGET_HLSL:
+        return SPVC_BACKEND_HLSL;
+    default:
+        return SPVC_BACKEND_NONE;
+    }
+}
+
+void set_compile_options(spvc_compiler_options compiler_options, const spirv_translate_options &options) {
+    switch (options.language) {
+    case SPIRV_TARGET_MSL:
+        if (options.version) {
+            spvc_compiler_options_set_uint(compiler_options, SPVC_COMPILER_OPTION_MSL_VERSION, options.version);
+        }
+        spvc_compiler_options_set_bool(compiler_options, SPVC_COMPILER_OPTION_MSL_ENABLE_POINT_SIZE_BUILTIN, SPVC_TRUE);
+        spvc_compiler_options_set_uint(
+                                       compiler_options,
+                                       SPVC_COMPILER_OPTION_MSL_PLATFORM,
+                                       options.msl_ios ? SPVC_MSL_PLATFORM_IOS : SPVC_MSL_PLATFORM_MACOS
+                                       );
+        spvc_compiler_options_set_bool(compiler_options, SPVC_COMPILER_OPTION_MSL_ENABLE_DECORATION_BINDING, SPVC_TRUE);
+        break;
+    case SPIRV_TARGET_GLSL:
+        if (options.version) {
+            spvc_compiler_options_set_uint(compiler_options, SPVC_COMPILER_OPTION_GLSL_VERSION, options.version);
+        }
+        spvc_compiler_options_set_bool(compiler_options, SPVC_COMPILER_OPTION_GLSL_SEPARATE_SHADER_OBJECTS, SPVC_TRUE);
+        spvc_compiler_options_set_bool(compiler_options, SPVC_COMPILER_OPTION_GLSL_ENABLE_420PACK_EXTENSION, SPVC_TRUE);
+        // Use desktop GLSL, not GLSL ES
+        spvc_compiler_options_set_bool(compiler_options, SPVC_COMPILER_OPTION_GLSL_ES, SPVC_FALSE);
+        break;
+    default:
+        break;
+    }
+}
+
+}
+
+spirv_translation spirv_reflect_and_translate(
+                                              const void *bytes,
+                                              unsigned long length,
+                                              spirv_translate_options options,
+                                              const char **error
+                                              ) {
+    spvc_context context = nullptr;
+    if (spvc_context_create(&context) != SPVC_SUCCESS) {
+        *error = "failed to create SPIRV-Cross context";
+        return {};
+    }
+
+    // IR is parsed once and shared by reflection and translation.
+    spvc_parsed_ir ir = nullptr;
+    spvc_compiler compiler = nullptr;
+    if (spvc_context_parse_spirv(context, static_cast<const SpvId *>(bytes), length / sizeof(SpvId), &ir) != SPVC_SUCCESS
+        || spvc_context_create_compiler(context, backend_for(options.language), ir, SPVC_CAPTURE_MODE_TAKE_OWNERSHIP, &compiler) != SPVC_SUCCESS) {
+        *error = set_error(context);
+        spvc_context_destroy(context);
+        return {};
+    }
+
+    const spvc_entry_point *entry_points = nullptr;
+    size_t entry_points_count = 0;
+    spvc_compiler_get_entry_points(compiler, &entry_points, &entry_points_count);
+
+    if (options.entry_point) {
+        // Renaming invalidates the entry points list.
+        std::vector<std::pair<std::string, SpvExecutionModel>> original;
+        for (size_t i = 0; i < entry_points_count; i++) {
+            original.emplace_back(entry_points[i].name, entry_points[i].execution_model);
+        }
+
+        for (const auto &entry_point : original) {
+            if (spvc_compiler_rename_entry_point(compiler, entry_point.first.c_str(), options.entry_point, entry_point.second) != SPVC_SUCCESS) {
+                *error = set_error(context);
+                spvc_context_destroy(context);
+                return {};
+            }
+        }
+
+        spvc_compiler_get_entry_points(compiler, &entry_points, &entry_points_count);
+    }
+
+    spirv_translation_storage *storage = new spirv_translation_storage();
+
+    if (options.language != SPIRV_TARGET_NONE) {
+        spvc_compiler_options compiler_options = nullptr;
+        const char *source = nullptr;
+        if (spvc_compiler_create_compiler_options(compiler, &compiler_options) != SPVC_SUCCESS) {
+            *error = set_error(context);
+            delete storage;
+            spvc_context_destroy(context);
+            return {};
+        }
+
+        set_compile_options(compiler_options, options);
+        spvc_compiler_install_compiler_options(compiler, compiler_options);
+
+        if (spvc_compiler_compile(compiler, &source) != SPVC_SUCCESS) {
+            printf("===== SPIRV-Cross COMPILE ERROR =====\n");
+            printf("Error: %s\n", spvc_context_get_last_error_string(context));
+            printf("Entry points:\n");
+            for (size_t i = 0; i < entry_points_count; i++) {
+                printf("  - %s (execution model: %d)\n", entry_points[i].name, entry_points[i].execution_model);
+            }
+            printf("===================================\n");
+            *error = set_error(context);
+            delete storage;
+            spvc_context_destroy(context);
+            return {};
+        }
+
+        storage->source = source;
+    }
+
+    storage->entry_point_names.reserve(entry_points_count);
+    for (size_t i = 0; i < entry_points_count; i++) {
+        const char *name = spvc_compiler_get_cleansed_entry_point_name(compiler, entry_points[i].name, entry_points[i].execution_model);
+        storage->entry_point_names.push_back(name ? name : entry_points[i].name);
+    }
+    for (size_t i = 0; i < entry_points_count; i++) {
+        storage->entry_points.push_back({ storage->entry_point_names[i].c_str(), uint32_t(entry_points[i].execution_model) });
+    }
+
+    spvc_resources resources = nullptr;
+    if (spvc_compiler_create_shader_resources(compiler, &resources) != SPVC_SUCCESS) {
+        *error = set_error(context);
+        delete storage;
+        spvc_context_destroy(context);
+        return {};
+    }
+
+    ReflectionBuilder builder(compiler);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_UNIFORM_BUFFER, SPIRV_RESOURCE_UNIFORM_BUFFER);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_STORAGE_BUFFER, SPIRV_RESOURCE_STORAGE_BUFFER);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_PUSH_CONSTANT, SPIRV_RESOURCE_PUSH_CONSTANT_BUFFER);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_SEPARATE_IMAGE, SPIRV_RESOURCE_SEPARATE_IMAGE);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_SAMPLED_IMAGE, SPIRV_RESOURCE_SAMPLED_IMAGE);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_STORAGE_IMAGE, SPIRV_RESOURCE_STORAGE_IMAGE);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_SUBPASS_INPUT, SPIRV_RESOURCE_SUBPASS_INPUT);
+    builder.add_resources(resources, SPVC_RESOURCE_TYPE_SEPARATE_SAMPLERS, SPIRV_RESOURCE_SEPARATE_SAMPLER);
+
+    for (size_t i = 0; i < entry_points_count; i++) {
+        if (entry_points[i].execution_model == SpvExecutionModelVertex) {
+            builder.add_vertex_inputs(resources);
+            break;
+        }
+    }
+
+    storage->reflection = builder.make_blob();
+    spvc_context_destroy(context);
+
+    spirv_translation result;
+    result.reflection = storage->reflection.data();
+    result.reflection_length = storage->reflection.size();
+    result.source = options.language != SPIRV_TARGET_NONE ? storage->source.c_str() : nullptr;
+    result.entry_points = storage->entry_points.data();
+    result.entry_points_count = storage->entry_points.size();
+    result.storage = storage;
+    return result;
+}
+
+void spirv_translation_free(spirv_translation translation) {
+    delete static_cast<spirv_translation_storage *>(translation.storage);
+}
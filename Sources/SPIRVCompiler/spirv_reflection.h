@@ -0,0 +1,142 @@
+//
+//  spirv_reflection.h
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+#ifndef spirv_reflection_h
+#define spirv_reflection_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef enum {
+    /// Reflect the module without translation.
+    SPIRV_TARGET_NONE,
+    SPIRV_TARGET_GLSL,
+    SPIRV_TARGET_MSL,
+    SPIRV_TARGET_HLSL,
+} spirv_target_language;
+
+typedef struct {
+    spirv_target_language language;
+    /// Language version, for example `410` for GLSL or `20100` for MSL 2.1. Pass 0 to use SPIRV-Cross default.
+    unsigned int version;
+    /// Translate MSL for iOS instead of macOS.
+    int msl_ios;
+    /// New name for entry points of the module. NULL keeps original names.
+    const char *entry_point;
+} spirv_translate_options;
+
+// MARK: - Reflection blob
+
+/// Reflection blob is a `spirv_reflection_header` followed by arrays of resources, members and vertex inputs,
+/// and by a table of NUL-terminated strings. Names are byte offsets in the string table.
+/// All fields are 32-bit integers in native byte order.
+
+#define SPIRV_REFLECTION_MAGIC 0x46524441 /* "ADRF" */
+#define SPIRV_REFLECTION_VERSION 1
+
+typedef enum {
+    SPIRV_RESOURCE_UNIFORM_BUFFER,
+    SPIRV_RESOURCE_STORAGE_BUFFER,
+    SPIRV_RESOURCE_PUSH_CONSTANT_BUFFER,
+    SPIRV_RESOURCE_SEPARATE_IMAGE,
+    SPIRV_RESOURCE_SAMPLED_IMAGE,
+    SPIRV_RESOURCE_STORAGE_IMAGE,
+    SPIRV_RESOURCE_SUBPASS_INPUT,
+    SPIRV_RESOURCE_SEPARATE_SAMPLER,
+} spirv_resource_kind;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t resources_count;
+    uint32_t members_count;
+    uint32_t vertex_inputs_count;
+    uint32_t strings_length;
+} spirv_reflection_header;
+
+/// Scalar, vector or matrix type of a value.
+typedef struct {
+    /// `spvc_basetype` value.
+    uint32_t base_type;
+    uint32_t vector_size;
+    uint32_t columns;
+} spirv_reflection_value_type;
+
+typedef struct {
+    /// `spirv_resource_kind` value.
+    uint32_t kind;
+    uint32_t name;
+    uint32_t descriptor_set;
+    uint32_t binding;
+    /// Declared size of the buffer struct. Zero for other resources.
+    uint32_t size;
+    /// Range of buffer members in the members array.
+    uint32_t first_member;
+    uint32_t members_count;
+    /// `SpvDim` of the image.
+    uint32_t image_dimension;
+    uint32_t image_arrayed;
+    uint32_t image_multisampled;
+    /// `SpvAccessQualifier` of the image.
+    uint32_t image_access;
+    uint32_t array_size;
+} spirv_reflection_resource;
+
+typedef struct {
+    uint32_t name;
+    uint32_t offset;
+    uint32_t size;
+    spirv_reflection_value_type type;
+} spirv_reflection_member;
+
+typedef struct {
+    uint32_t name;
+    uint32_t location;
+    spirv_reflection_value_type type;
+} spirv_reflection_vertex_input;
+
+// MARK: - Translation
+
+typedef struct {
+    /// Entry point name as it's written in the translated source.
+    const char *name;
+    /// `SpvExecutionModel` value.
+    uint32_t execution_model;
+} spirv_entry_point;
+
+typedef struct {
+    /// Reflection blob, see `spirv_reflection_header`.
+    const void *reflection;
+    unsigned long reflection_length;
+    /// Translated source. NULL for `SPIRV_TARGET_NONE`.
+    const char *source;
+    const spirv_entry_point *entry_points;
+    unsigned long entry_points_count;
+    /// Opaque storage owning the result. Released by `spirv_translation_free`.
+    void *storage;
+} spirv_translation;
+
+/// Parse SPIR-V module once, reflect it and translate to the target language.
+/// - Parameter error: Error message, valid until the next call on the same thread.
+spirv_translation spirv_reflect_and_translate(
+                                              const void *bytes,
+                                              unsigned long length,
+                                              spirv_translate_options options,
+                                              const char **error
+                                              );
+
+/// Release memory returned by `spirv_reflect_and_translate`. Safe to call on an empty result.
+void spirv_translation_free(spirv_translation translation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* spirv_reflection_h */
@@ -35,6 +35,7 @@ typedef struct Benchmark
 	CreateFcn* createFcn;
 	StepFcn* stepFcn;
 	int totalStepCount;
+	b2BroadPhaseType broadPhaseType;
 } Benchmark;
 
 #define MAX_TASKS 128
@@ -143,6 +144,8 @@ int main( int argc, char** argv )
 		{ "smash", CreateSmash, NULL, 300 },
 		{ "spinner", CreateSpinner, StepSpinner, 1400 },
 		{ "tumbler", CreateTumbler, NULL, 750 },
+		{ "particles", CreateParticles, NULL, 500 },
+		{ "particles_grid", CreateParticles, NULL, 500, b2_gridBroadPhase },
 	};
 
 	int benchmarkCount = ARRAY_COUNT( benchmarks );
@@ -293,6 +296,7 @@ int main( int argc, char** argv )
 				worldDef.enqueueTask = EnqueueTask;
 				worldDef.finishTask = FinishTask;
 				worldDef.workerCount = threadCount;
+				worldDef.dynamicBroadPhase = benchmark->broadPhaseType;
 				b2WorldId worldId = b2CreateWorld( &worldDef );
 
 				benchmark->createFcn( worldId );
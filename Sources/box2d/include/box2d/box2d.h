@@ -29,6 +29,11 @@ B2_API b2WorldId b2CreateWorld( const b2WorldDef* def );
 /// Destroy a world
 B2_API void b2DestroyWorld( b2WorldId worldId );
 
+/// Destroy all bodies, shapes, joints, and chains of a world, keeping its memory for new ones. The world id stays valid
+/// and the world settings and callbacks are kept. This is much cheaper than destroying and creating a world when a
+/// level is reloaded. Ids of the destroyed objects become invalid.
+B2_API void b2World_Reset( b2WorldId worldId );
+
 /// World id validation. Provides validation for up to 64K allocations.
 B2_API bool b2World_IsValid( b2WorldId id );
 
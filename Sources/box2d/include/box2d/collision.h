@@ -648,8 +648,29 @@ typedef struct b2DynamicTree
 	/// Bins for sorting during rebuild
 	int* binIndices;
 
+	/// Internal nodes allocated for rebuild
+	int* internalIndices;
+
 	/// Allocated space for rebuilding
 	int rebuildCapacity;
+
+	/// Wide nodes for SIMD queries, built from the binary nodes
+	struct b2WideNode* wideNodes;
+
+	/// The number of wide nodes
+	int wideNodeCount;
+
+	/// The allocated wide node space
+	int wideNodeCapacity;
+
+	/// Wide node lane of each proxy, used to refit the wide nodes
+	int* wideLeafSlots;
+
+	/// The allocated wide leaf slot space
+	int wideLeafSlotCapacity;
+
+	/// True if the wide nodes match the binary nodes
+	bool wideValid;
 } b2DynamicTree;
 
 /// These are performance results returned by dynamic tree queries.
@@ -668,6 +689,9 @@ B2_API b2DynamicTree b2DynamicTree_Create( void );
 /// Destroy the tree, freeing the node pool.
 B2_API void b2DynamicTree_Destroy( b2DynamicTree* tree );
 
+/// Remove all proxies from the tree, keeping the node pool for new proxies.
+B2_API void b2DynamicTree_Clear( b2DynamicTree* tree );
+
 /// Create a proxy. Provide an AABB and a userData value.
 B2_API int b2DynamicTree_CreateProxy( b2DynamicTree* tree, b2AABB aabb, uint64_t categoryBits, int userData );
 
@@ -743,8 +767,13 @@ B2_API float b2DynamicTree_GetAreaRatio( const b2DynamicTree* tree );
 B2_API int b2DynamicTree_GetProxyCount( const b2DynamicTree* tree );
 
 /// Rebuild the tree while retaining subtrees that haven't changed. Returns the number of boxes sorted.
+/// A full build uses the surface area heuristic and is slower but gives better query performance.
 B2_API int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild );
 
+/// Build the wide tree used to accelerate queries if the tree was modified since it was last built.
+/// This is done by b2DynamicTree_Rebuild. Not safe to query the tree during this operation.
+B2_API void b2DynamicTree_BuildWideTree( b2DynamicTree* tree );
+
 /// Get the number of bytes used by this tree
 B2_API int b2DynamicTree_GetByteCount( const b2DynamicTree* tree );
 
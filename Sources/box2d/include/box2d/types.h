@@ -72,6 +72,18 @@ typedef struct b2RayResult
 	bool hit;
 } b2RayResult;
 
+/// Structure used by the broad-phase to find new contact pairs of moving shapes.
+/// @ingroup world
+typedef enum b2BroadPhaseType
+{
+	/// Bounding volume tree, works well for shapes of any size. This is the default.
+	b2_treeBroadPhase = 0,
+
+	/// Hashed uniform grid. Faster when many shapes of similar size are moving, such as particles or projectiles.
+	/// Shapes much larger than the grid cells are tested against every moving shape.
+	b2_gridBroadPhase,
+} b2BroadPhaseType;
+
 /// World definition used to create a simulation world.
 /// Must be initialized using b2DefaultWorldDef().
 /// @ingroup world
@@ -120,6 +132,16 @@ typedef struct b2WorldDef
 	/// Enable continuous collision
 	bool enableContinuous;
 
+	/// Broad-phase used to find new pairs of dynamic shapes. World queries and ray casts always use the tree.
+	b2BroadPhaseType dynamicBroadPhase;
+
+	/// Broad-phase used to find new pairs of dynamic shapes with kinematic shapes.
+	b2BroadPhaseType kinematicBroadPhase;
+
+	/// Cell size of the grid broad-phase, usually in meters. Zero computes the cell size from the shape
+	/// bounds on each step.
+	float broadPhaseCellSize;
+
 	/// Number of workers to use with the provided task system. Box2D performs best when using only
 	/// performance cores and accessing a single L2 cache. Efficiency cores and hyper-threading provide
 	/// little benefit and may even harm performance.
@@ -508,6 +530,7 @@ typedef struct b2Counters
 	int contactCount;
 	int jointCount;
 	int islandCount;
+	int awakeIslandCount;
 	int stackUsed;
 	int staticTreeHeight;
 	int treeHeight;
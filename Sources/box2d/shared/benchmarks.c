@@ -4,6 +4,7 @@
 #include "benchmarks.h"
 
 #include "human.h"
+#include "random.h"
 
 #include "box2d/box2d.h"
 
@@ -555,3 +556,50 @@ void CreateTumbler( b2WorldId worldId )
 		y += 0.4f;
 	}
 }
+
+// Many same sized circles bouncing in a box without gravity, like projectiles of a bullet hell game.
+// Suits the grid broad-phase, see b2WorldDef::dynamicBroadPhase.
+void CreateParticles( b2WorldId worldId )
+{
+	b2World_SetGravity( worldId, b2Vec2_zero );
+
+	float extent = BENCHMARK_DEBUG ? 20.0f : 80.0f;
+
+	{
+		b2BodyDef bodyDef = b2DefaultBodyDef();
+		b2BodyId groundId = b2CreateBody( worldId, &bodyDef );
+
+		b2ShapeDef shapeDef = b2DefaultShapeDef();
+		b2Polygon box = b2MakeOffsetBox( extent, 1.0f, ( b2Vec2 ){ 0.0f, -extent - 1.0f }, b2Rot_identity );
+		b2CreatePolygonShape( groundId, &shapeDef, &box );
+		box = b2MakeOffsetBox( extent, 1.0f, ( b2Vec2 ){ 0.0f, extent + 1.0f }, b2Rot_identity );
+		b2CreatePolygonShape( groundId, &shapeDef, &box );
+		box = b2MakeOffsetBox( 1.0f, extent, ( b2Vec2 ){ -extent - 1.0f, 0.0f }, b2Rot_identity );
+		b2CreatePolygonShape( groundId, &shapeDef, &box );
+		box = b2MakeOffsetBox( 1.0f, extent, ( b2Vec2 ){ extent + 1.0f, 0.0f }, b2Rot_identity );
+		b2CreatePolygonShape( groundId, &shapeDef, &box );
+	}
+
+	g_seed = RAND_SEED;
+
+	int count = BENCHMARK_DEBUG ? 500 : 8000;
+	float radius = 0.25f;
+
+	b2Circle circle = { { 0.0f, 0.0f }, radius };
+
+	b2BodyDef bodyDef = b2DefaultBodyDef();
+	bodyDef.type = b2_dynamicBody;
+	bodyDef.enableSleep = false;
+
+	b2ShapeDef shapeDef = b2DefaultShapeDef();
+	shapeDef.friction = 0.0f;
+	shapeDef.restitution = 1.0f;
+
+	for ( int i = 0; i < count; ++i )
+	{
+		bodyDef.position = RandomVec2( -extent + 1.0f, extent - 1.0f );
+		bodyDef.linearVelocity = RandomVec2( -10.0f, 10.0f );
+		b2BodyId bodyId = b2CreateBody( worldId, &bodyDef );
+		b2CreateCircleShape( bodyId, &shapeDef, &circle );
+	}
+}
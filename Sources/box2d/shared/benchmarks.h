@@ -20,6 +20,7 @@ void CreateSpinner( b2WorldId worldId );
 float StepSpinner( b2WorldId worldId, int stepCount );
 void CreateSmash( b2WorldId worldId );
 void CreateTumbler( b2WorldId worldId );
+void CreateParticles( b2WorldId worldId );
 
 #ifdef __cplusplus
 }
@@ -24,7 +24,7 @@
 
 // static FILE* s_file = NULL;
 
-void b2CreateBroadPhase( b2BroadPhase* bp )
+void b2CreateBroadPhase( b2BroadPhase* bp, const b2WorldDef* def )
 {
 	_Static_assert( b2_bodyTypeCount == 3, "must be three body types" );
 
@@ -42,11 +42,24 @@ void b2CreateBroadPhase( b2BroadPhase* bp )
 	bp->movePairCapacity = 0;
 	b2AtomicStoreInt(&bp->movePairIndex, 0);
 	bp->pairSet = b2CreateSet( 32 );
+	bp->version = 0;
 
 	for ( int i = 0; i < b2_bodyTypeCount; ++i )
 	{
 		bp->trees[i] = b2DynamicTree_Create();
 	}
+
+	bp->types[b2_staticBody] = b2_treeBroadPhase;
+	bp->types[b2_kinematicBody] = def->kinematicBroadPhase;
+	bp->types[b2_dynamicBody] = def->dynamicBroadPhase;
+
+	for ( int i = 0; i < b2_bodyTypeCount; ++i )
+	{
+		if ( bp->types[i] == b2_gridBroadPhase )
+		{
+			bp->grids[i] = b2CreateHashGrid( def->broadPhaseCellSize );
+		}
+	}
 }
 
 void b2DestroyBroadPhase( b2BroadPhase* bp )
@@ -54,6 +67,11 @@ void b2DestroyBroadPhase( b2BroadPhase* bp )
 	for ( int i = 0; i < b2_bodyTypeCount; ++i )
 	{
 		b2DynamicTree_Destroy( bp->trees + i );
+
+		if ( bp->types[i] == b2_gridBroadPhase )
+		{
+			b2DestroyHashGrid( bp->grids + i );
+		}
 	}
 
 	b2DestroySet( &bp->moveSet );
@@ -69,6 +87,28 @@ void b2DestroyBroadPhase( b2BroadPhase* bp )
 	// }
 }
 
+// Remove all proxies, keeping the memory
+void b2ResetBroadPhase( b2BroadPhase* bp )
+{
+	B2_ASSERT( bp->movePairs == NULL && bp->moveResults == NULL );
+
+	for ( int i = 0; i < b2_bodyTypeCount; ++i )
+	{
+		b2DynamicTree_Clear( bp->trees + i );
+
+		if ( bp->types[i] == b2_gridBroadPhase )
+		{
+			b2HashGrid_Clear( bp->grids + i );
+		}
+	}
+
+	bp->proxyCount = 0;
+	b2ClearSet( &bp->moveSet );
+	b2IntArray_Clear( &bp->moveArray );
+	b2ClearSet( &bp->pairSet );
+	bp->version += 1;
+}
+
 static inline void b2UnBufferMove( b2BroadPhase* bp, int proxyKey )
 {
 	bool found = b2RemoveKey( &bp->moveSet, proxyKey + 1 );
@@ -95,10 +135,18 @@ int b2BroadPhase_CreateProxy( b2BroadPhase* bp, b2BodyType proxyType, b2AABB aab
 	B2_ASSERT( 0 <= proxyType && proxyType < b2_bodyTypeCount );
 	int proxyId = b2DynamicTree_CreateProxy( bp->trees + proxyType, aabb, categoryBits, shapeIndex );
 	int proxyKey = B2_PROXY_KEY( proxyId, proxyType );
+
+	// Like the tree queries, the grid never reports proxies without category bits
+	if ( bp->types[proxyType] == b2_gridBroadPhase && categoryBits != 0 )
+	{
+		b2HashGrid_AddProxy( bp->grids + proxyType, proxyId );
+	}
+
 	if ( proxyType != b2_staticBody || forcePairCreation )
 	{
 		b2BufferMove( bp, proxyKey );
 	}
+	bp->version += 1;
 	return proxyKey;
 }
 
@@ -108,12 +156,18 @@ void b2BroadPhase_DestroyProxy( b2BroadPhase* bp, int proxyKey )
 	b2UnBufferMove( bp, proxyKey );
 
 	--bp->proxyCount;
+	bp->version += 1;
 
 	b2BodyType proxyType = B2_PROXY_TYPE( proxyKey );
 	int proxyId = B2_PROXY_ID( proxyKey );
 
 	B2_ASSERT( 0 <= proxyType && proxyType <= b2_bodyTypeCount );
 	b2DynamicTree_DestroyProxy( bp->trees + proxyType, proxyId );
+
+	if ( bp->types[proxyType] == b2_gridBroadPhase )
+	{
+		b2HashGrid_RemoveProxy( bp->grids + proxyType, proxyId );
+	}
 }
 
 void b2BroadPhase_MoveProxy( b2BroadPhase* bp, int proxyKey, b2AABB aabb )
@@ -123,6 +177,7 @@ void b2BroadPhase_MoveProxy( b2BroadPhase* bp, int proxyKey, b2AABB aabb )
 
 	b2DynamicTree_MoveProxy( bp->trees + proxyType, proxyId, aabb );
 	b2BufferMove( bp, proxyKey );
+	bp->version += 1;
 }
 
 void b2BroadPhase_EnlargeProxy( b2BroadPhase* bp, int proxyKey, b2AABB aabb )
@@ -309,6 +364,20 @@ b2TreeStats b2_kinematicStats;
 b2TreeStats b2_staticStats;
 #endif
 
+// Query the trees or grids of a proxy type for new pairs
+static b2TreeStats b2QueryPairs( const b2BroadPhase* bp, b2BodyType treeType, b2AABB aabb, b2QueryPairContext* queryContext )
+{
+	queryContext->queryTreeType = treeType;
+
+	// Using B2_DEFAULT_MASK_BITS so that b2Filter::groupIndex works.
+	if ( bp->types[treeType] == b2_gridBroadPhase )
+	{
+		return b2HashGrid_Query( bp->grids + treeType, aabb, b2PairQueryCallback, queryContext );
+	}
+
+	return b2DynamicTree_Query( bp->trees + treeType, aabb, B2_DEFAULT_MASK_BITS, b2PairQueryCallback, queryContext );
+}
+
 static void b2FindPairsTask( int startIndex, int endIndex, uint32_t threadIndex, void* context )
 {
 	b2TracyCZoneNC( pair_task, "Pair", b2_colorMediumSlateBlue, true );
@@ -347,26 +416,21 @@ static void b2FindPairsTask( int startIndex, int endIndex, uint32_t threadIndex,
 		queryContext.queryShapeIndex = b2DynamicTree_GetUserData( baseTree, proxyId );
 
 		// Query trees. Only dynamic proxies collide with kinematic and static proxies.
-		// Using B2_DEFAULT_MASK_BITS so that b2Filter::groupIndex works.
 		b2TreeStats stats = { 0 };
 		if ( proxyType == b2_dynamicBody )
 		{
 			// consider using bits = groupIndex > 0 ? B2_DEFAULT_MASK_BITS : maskBits
-			queryContext.queryTreeType = b2_kinematicBody;
-			b2TreeStats statsKinematic = b2DynamicTree_Query( bp->trees + b2_kinematicBody, fatAABB, B2_DEFAULT_MASK_BITS, b2PairQueryCallback, &queryContext );
+			b2TreeStats statsKinematic = b2QueryPairs( bp, b2_kinematicBody, fatAABB, &queryContext );
 			stats.nodeVisits += statsKinematic.nodeVisits;
 			stats.leafVisits += statsKinematic.leafVisits;
 
-			queryContext.queryTreeType = b2_staticBody;
-			b2TreeStats statsStatic = b2DynamicTree_Query( bp->trees + b2_staticBody, fatAABB, B2_DEFAULT_MASK_BITS, b2PairQueryCallback, &queryContext );
+			b2TreeStats statsStatic = b2QueryPairs( bp, b2_staticBody, fatAABB, &queryContext );
 			stats.nodeVisits += statsStatic.nodeVisits;
 			stats.leafVisits += statsStatic.leafVisits;
 		}
 
 		// All proxies collide with dynamic proxies
-		// Using B2_DEFAULT_MASK_BITS so that b2Filter::groupIndex works.
-		queryContext.queryTreeType = b2_dynamicBody;
-		b2TreeStats statsDynamic = b2DynamicTree_Query( bp->trees + b2_dynamicBody, fatAABB, B2_DEFAULT_MASK_BITS, b2PairQueryCallback, &queryContext );
+		b2TreeStats statsDynamic = b2QueryPairs( bp, b2_dynamicBody, fatAABB, &queryContext );
 		stats.nodeVisits += statsDynamic.nodeVisits;
 		stats.leafVisits += statsDynamic.leafVisits;
 	}
@@ -388,6 +452,10 @@ void b2UpdateBroadPhasePairs( b2World* world )
 
 	b2TracyCZoneNC( update_pairs, "Find Pairs", b2_colorMediumSlateBlue, true );
 
+	// The static tree is not rebuilt with the other trees, so refresh its wide tree after static proxies changed.
+	// The dynamic and kinematic wide trees are kept valid by the tree rebuild and proxy enlargement.
+	b2DynamicTree_BuildWideTree( bp->trees + b2_staticBody );
+
 	b2ArenaAllocator* alloc = &world->stackAllocator;
 
 	// todo these could be in the step context
@@ -396,6 +464,15 @@ void b2UpdateBroadPhasePairs( b2World* world )
 	bp->movePairs = b2AllocateArenaItem( alloc, bp->movePairCapacity * sizeof( b2MovePair ), "move pairs" );
 	b2AtomicStoreInt(&bp->movePairIndex, 0);
 
+	// Grids are rebuilt from the tree bounds, after all proxies moved in the previous step
+	for ( int i = 0; i < b2_bodyTypeCount; ++i )
+	{
+		if ( bp->types[i] == b2_gridBroadPhase )
+		{
+			b2HashGrid_Build( bp->grids + i, bp->trees + i, alloc );
+		}
+	}
+
 #if B2_SNOOP_TABLE_COUNTERS
 	extern b2AtomicInt b2_probeCount;
 	b2AtomicStoreInt(&b2_probeCount, 0);
@@ -462,6 +539,14 @@ void b2UpdateBroadPhasePairs( b2World* world )
 	b2IntArray_Clear( &bp->moveArray );
 	b2ClearSet( &bp->moveSet );
 
+	for ( int i = b2_bodyTypeCount - 1; i >= 0; --i )
+	{
+		if ( bp->types[i] == b2_gridBroadPhase )
+		{
+			b2HashGrid_Free( bp->grids + i, alloc );
+		}
+	}
+
 	b2FreeArenaItem( alloc, bp->movePairs );
 	bp->movePairs = NULL;
 	b2FreeArenaItem( alloc, bp->moveResults );
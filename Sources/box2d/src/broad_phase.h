@@ -4,6 +4,7 @@
 #pragma once
 
 #include "array.h"
+#include "hash_grid.h"
 #include "table.h"
 
 #include "box2d/collision.h"
@@ -28,6 +29,11 @@ typedef struct b2BroadPhase
 	b2DynamicTree trees[b2_bodyTypeCount];
 	int proxyCount;
 
+	// Structure used to find pairs with the proxies of each body type. Static proxies always use the tree.
+	// A grid only replaces the tree for pair queries, the tree still holds the proxies for world queries.
+	b2BroadPhaseType types[b2_bodyTypeCount];
+	b2HashGrid grids[b2_bodyTypeCount];
+
 	// The move set and array are used to track shapes that have moved significantly
 	// and need a pair query for new contacts. The array has a deterministic order.
 	// todo perhaps just a move set?
@@ -48,10 +54,15 @@ typedef struct b2BroadPhase
 	// todo pairSet can grow quite large on the first time step and remain large
 	b2HashSet pairSet;
 
+	// Incremented when proxies are created, destroyed or moved outside of the step, and when bodies fall asleep.
+	// Sensors use it to know that shapes which are not awake could have changed.
+	uint32_t version;
+
 } b2BroadPhase;
 
-void b2CreateBroadPhase( b2BroadPhase* bp );
+void b2CreateBroadPhase( b2BroadPhase* bp, const b2WorldDef* def );
 void b2DestroyBroadPhase( b2BroadPhase* bp );
+void b2ResetBroadPhase( b2BroadPhase* bp );
 
 int b2BroadPhase_CreateProxy( b2BroadPhase* bp, b2BodyType proxyType, b2AABB aabb, uint64_t categoryBits, int shapeIndex,
 							  bool forcePairCreation );
@@ -62,6 +62,23 @@ void b2DestroyGraph( b2ConstraintGraph* graph )
 	}
 }
 
+// Remove all constraints, keeping the memory
+void b2ResetGraph( b2ConstraintGraph* graph )
+{
+	for ( int i = 0; i < B2_GRAPH_COLOR_COUNT; ++i )
+	{
+		b2GraphColor* color = graph->colors + i;
+
+		if ( i != B2_OVERFLOW_INDEX )
+		{
+			b2SetBitCountAndClear( &color->bodySet, 64 * color->bodySet.blockCount );
+		}
+
+		b2ContactSimArray_Clear( &color->contactSims );
+		b2JointSimArray_Clear( &color->jointSims );
+	}
+}
+
 // Contacts are always created as non-touching. They get cloned into the constraint
 // graph once they are found to be touching.
 // todo maybe kinematic bodies should not go into graph
@@ -48,6 +48,7 @@ typedef struct b2ConstraintGraph
 
 void b2CreateGraph( b2ConstraintGraph* graph, int bodyCapacity );
 void b2DestroyGraph( b2ConstraintGraph* graph );
+void b2ResetGraph( b2ConstraintGraph* graph );
 
 void b2AddContactToGraph( b2World* world, b2ContactSim* contactSim, b2Contact* contact );
 void b2RemoveContactFromGraph( b2World* world, int bodyIdA, int bodyIdB, int colorIndex, int localIndex );
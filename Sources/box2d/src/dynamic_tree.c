@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: 2023 Erin Catto
 // SPDX-License-Identifier: MIT
 
+#include "dynamic_tree.h"
+
 #include "aabb.h"
 #include "constants.h"
 #include "core.h"
@@ -57,6 +59,46 @@ static b2TreeNode b2_defaultTreeNode = {
 	.flags = b2_allocatedNode,
 };
 
+// The wide tree has one child lane per SIMD lane, so all children of a node are tested at once.
+#define B2_TREE_WIDTH B2_SIMD_WIDTH
+
+/// A node in the wide tree. After a rebuild the binary tree is collapsed into these nodes
+/// to accelerate queries. The binary tree remains the source of truth.
+typedef struct b2WideNode
+{
+	/// Child bounding boxes in SoA layout. Unused lanes have inverted bounds.
+	float lowerX[B2_TREE_WIDTH];
+	float lowerY[B2_TREE_WIDTH];
+	float upperX[B2_TREE_WIDTH];
+	float upperY[B2_TREE_WIDTH];
+
+	/// Child category bits. Zero for unused lanes.
+	uint64_t categoryBits[B2_TREE_WIDTH];
+
+	/// Child wide node index, or the complement of the proxy id for a leaf
+	int32_t children[B2_TREE_WIDTH];
+
+	/// Lane holding this node in the parent wide node: parentIndex * B2_TREE_WIDTH + lane
+	int32_t parentSlot;
+
+	/// Number of used lanes
+	int32_t childCount;
+} b2WideNode;
+
+static b2AABB b2GetLaneAABB( const b2WideNode* node, int lane )
+{
+	b2AABB aabb = { { node->lowerX[lane], node->lowerY[lane] }, { node->upperX[lane], node->upperY[lane] } };
+	return aabb;
+}
+
+static void b2SetLaneAABB( b2WideNode* node, int lane, b2AABB aabb )
+{
+	node->lowerX[lane] = aabb.lowerBound.x;
+	node->lowerY[lane] = aabb.lowerBound.y;
+	node->upperX[lane] = aabb.upperBound.x;
+	node->upperY[lane] = aabb.upperBound.y;
+}
+
 static bool b2IsLeaf( const b2TreeNode* node )
 {
 	return node->flags & b2_leafNode;
@@ -97,8 +139,16 @@ b2DynamicTree b2DynamicTree_Create( void )
 	tree.leafBoxes = NULL;
 	tree.leafCenters = NULL;
 	tree.binIndices = NULL;
+	tree.internalIndices = NULL;
 	tree.rebuildCapacity = 0;
 
+	tree.wideNodes = NULL;
+	tree.wideNodeCount = 0;
+	tree.wideNodeCapacity = 0;
+	tree.wideLeafSlots = NULL;
+	tree.wideLeafSlotCapacity = 0;
+	tree.wideValid = false;
+
 	return tree;
 }
 
@@ -109,10 +159,33 @@ void b2DynamicTree_Destroy( b2DynamicTree* tree )
 	b2Free( tree->leafBoxes, tree->rebuildCapacity * sizeof( b2AABB ) );
 	b2Free( tree->leafCenters, tree->rebuildCapacity * sizeof( b2Vec2 ) );
 	b2Free( tree->binIndices, tree->rebuildCapacity * sizeof( int32_t ) );
+	b2Free( tree->internalIndices, tree->rebuildCapacity * sizeof( int32_t ) );
+	b2Free( tree->wideNodes, tree->wideNodeCapacity * sizeof( b2WideNode ) );
+	b2Free( tree->wideLeafSlots, tree->wideLeafSlotCapacity * sizeof( int32_t ) );
 
 	memset( tree, 0, sizeof( b2DynamicTree ) );
 }
 
+void b2DynamicTree_Clear( b2DynamicTree* tree )
+{
+	tree->root = B2_NULL_INDEX;
+	tree->nodeCount = 0;
+	tree->proxyCount = 0;
+	memset( tree->nodes, 0, tree->nodeCapacity * sizeof( b2TreeNode ) );
+
+	// Same free list as a new tree, so nodes are allocated in the same order
+	for ( int i = 0; i < tree->nodeCapacity - 1; ++i )
+	{
+		tree->nodes[i].next = i + 1;
+	}
+
+	tree->nodes[tree->nodeCapacity - 1].next = B2_NULL_INDEX;
+	tree->freeList = 0;
+
+	tree->wideNodeCount = 0;
+	tree->wideValid = false;
+}
+
 // Allocate a node from the pool. Grow the pool if necessary.
 static int b2AllocateNode( b2DynamicTree* tree )
 {
@@ -785,6 +858,7 @@ int b2DynamicTree_CreateProxy( b2DynamicTree* tree, b2AABB aabb, uint64_t catego
 	b2InsertLeaf( tree, proxyId, shouldRotate );
 
 	tree->proxyCount += 1;
+	tree->wideValid = false;
 
 	return proxyId;
 }
@@ -799,6 +873,7 @@ void b2DynamicTree_DestroyProxy( b2DynamicTree* tree, int proxyId )
 
 	B2_ASSERT( tree->proxyCount > 0 );
 	tree->proxyCount -= 1;
+	tree->wideValid = false;
 }
 
 int b2DynamicTree_GetProxyCount( const b2DynamicTree* tree )
@@ -820,6 +895,8 @@ void b2DynamicTree_MoveProxy( b2DynamicTree* tree, int proxyId, b2AABB aabb )
 
 	bool shouldRotate = false;
 	b2InsertLeaf( tree, proxyId, shouldRotate );
+
+	tree->wideValid = false;
 }
 
 void b2DynamicTree_EnlargeProxy( b2DynamicTree* tree, int proxyId, b2AABB aabb )
@@ -861,6 +938,30 @@ void b2DynamicTree_EnlargeProxy( b2DynamicTree* tree, int proxyId, b2AABB aabb )
 		nodes[parentIndex].flags |= b2_enlargedNode;
 		parentIndex = nodes[parentIndex].parent;
 	}
+
+	// Enlarging keeps the structure, so the wide tree is refit instead of rebuilt
+	if ( tree->wideValid )
+	{
+		int slot = tree->wideLeafSlots[proxyId];
+		b2WideNode* wideNode = tree->wideNodes + slot / B2_TREE_WIDTH;
+		b2SetLaneAABB( wideNode, slot % B2_TREE_WIDTH, aabb );
+
+		slot = wideNode->parentSlot;
+		while ( slot != B2_NULL_INDEX )
+		{
+			wideNode = tree->wideNodes + slot / B2_TREE_WIDTH;
+			int lane = slot % B2_TREE_WIDTH;
+
+			b2AABB laneAABB = b2GetLaneAABB( wideNode, lane );
+			if ( b2EnlargeAABB( &laneAABB, aabb ) == false )
+			{
+				break;
+			}
+
+			b2SetLaneAABB( wideNode, lane, laneAABB );
+			slot = wideNode->parentSlot;
+		}
+	}
 }
 
 int b2DynamicTree_GetHeight( const b2DynamicTree* tree )
@@ -997,6 +1098,57 @@ static void b2ValidateMetrics( const b2DynamicTree* tree, int index )
 	b2ValidateMetrics( tree, child1 );
 	b2ValidateMetrics( tree, child2 );
 }
+
+static void b2ValidateWideTree( const b2DynamicTree* tree )
+{
+	int leafCount = 0;
+	for ( int wideIndex = 0; wideIndex < tree->wideNodeCount; ++wideIndex )
+	{
+		const b2WideNode* wideNode = tree->wideNodes + wideIndex;
+		B2_ASSERT( 0 < wideNode->childCount && wideNode->childCount <= B2_TREE_WIDTH );
+
+		if ( wideNode->parentSlot == B2_NULL_INDEX )
+		{
+			B2_ASSERT( wideIndex == 0 );
+		}
+		else
+		{
+			const b2WideNode* parent = tree->wideNodes + wideNode->parentSlot / B2_TREE_WIDTH;
+			int parentLane = wideNode->parentSlot % B2_TREE_WIDTH;
+			B2_ASSERT( parent->children[parentLane] == wideIndex );
+		}
+
+		for ( int i = 0; i < wideNode->childCount; ++i )
+		{
+			int childId = wideNode->children[i];
+			b2AABB laneAABB = b2GetLaneAABB( wideNode, i );
+
+			if ( childId < 0 )
+			{
+				int proxyId = ~childId;
+				B2_ASSERT( 0 <= proxyId && proxyId < tree->nodeCapacity );
+				B2_ASSERT( b2IsLeaf( tree->nodes + proxyId ) );
+				B2_ASSERT( tree->wideLeafSlots[proxyId] == wideIndex * B2_TREE_WIDTH + i );
+				B2_ASSERT( b2AABB_Contains( laneAABB, tree->nodes[proxyId].aabb ) );
+				B2_ASSERT( wideNode->categoryBits[i] == tree->nodes[proxyId].categoryBits );
+				leafCount += 1;
+			}
+			else
+			{
+				B2_ASSERT( wideIndex < childId && childId < tree->wideNodeCount );
+				const b2WideNode* child = tree->wideNodes + childId;
+				B2_ASSERT( child->parentSlot == wideIndex * B2_TREE_WIDTH + i );
+
+				for ( int j = 0; j < child->childCount; ++j )
+				{
+					B2_ASSERT( b2AABB_Contains( laneAABB, b2GetLaneAABB( child, j ) ) );
+				}
+			}
+		}
+	}
+
+	B2_ASSERT( leafCount == tree->proxyCount );
+}
 #endif
 
 void b2DynamicTree_Validate( const b2DynamicTree* tree )
@@ -1024,6 +1176,11 @@ void b2DynamicTree_Validate( const b2DynamicTree* tree )
 	B2_ASSERT( height == computedHeight );
 
 	B2_ASSERT( tree->nodeCount + freeCount == tree->nodeCapacity );
+
+	if ( tree->wideValid )
+	{
+		b2ValidateWideTree( tree );
+	}
 #else
 	B2_UNUSED( tree );
 #endif
@@ -1050,7 +1207,8 @@ void b2DynamicTree_ValidateNoEnlarged(const b2DynamicTree* tree)
 int b2DynamicTree_GetByteCount( const b2DynamicTree* tree )
 {
 	size_t size = sizeof( b2DynamicTree ) + sizeof( b2TreeNode ) * tree->nodeCapacity +
-				  tree->rebuildCapacity * ( sizeof( int ) + sizeof( b2AABB ) + sizeof( b2Vec2 ) + sizeof( int ) );
+				  tree->rebuildCapacity * ( sizeof( int ) + sizeof( b2AABB ) + sizeof( b2Vec2 ) + sizeof( int ) + sizeof( int ) ) +
+				  sizeof( b2WideNode ) * tree->wideNodeCapacity + sizeof( int ) * tree->wideLeafSlotCapacity;
 
 	return (int)size;
 }
@@ -1065,193 +1223,792 @@ b2AABB b2DynamicTree_GetAABB( const b2DynamicTree* tree, int proxyId )
 	return tree->nodes[proxyId].aabb;
 }
 
-b2TreeStats b2DynamicTree_Query( const b2DynamicTree* tree, b2AABB aabb, uint64_t maskBits, b2TreeQueryCallbackFcn* callback,
-								 void* context )
-{
-	b2TreeStats result = { 0 };
+#if defined( B2_SIMD_AVX2 )
 
-	if ( tree->nodeCount == 0 )
-	{
-		return result;
-	}
+#include <immintrin.h>
 
-	int stack[B2_TREE_STACK_SIZE];
-	int stackCount = 0;
-	stack[stackCount++] = tree->root;
+// wide float holds 8 numbers
+typedef __m256 b2FloatW;
 
-	while ( stackCount > 0 )
-	{
-		int nodeId = stack[--stackCount];
-		if ( nodeId == B2_NULL_INDEX )
-		{
-			// todo huh?
-			B2_ASSERT( false );
-			continue;
-		}
+static inline b2FloatW b2SplatW( float scalar )
+{
+	return _mm256_set1_ps( scalar );
+}
 
-		const b2TreeNode* node = tree->nodes + nodeId;
-		result.nodeVisits += 1;
+static inline b2FloatW b2LoadW( const float* values )
+{
+	return _mm256_loadu_ps( values );
+}
 
-		if ( b2AABB_Overlaps( node->aabb, aabb ) && ( node->categoryBits & maskBits ) != 0 )
-		{
-			if ( b2IsLeaf( node ) )
-			{
-				// callback to user code with proxy id
-				bool proceed = callback( nodeId, node->userData, context );
-				result.leafVisits += 1;
+static inline b2FloatW b2AddW( b2FloatW a, b2FloatW b )
+{
+	return _mm256_add_ps( a, b );
+}
 
-				if ( proceed == false )
-				{
-					return result;
-				}
-			}
-			else
-			{
-				if ( stackCount < B2_TREE_STACK_SIZE - 1 )
-				{
-					stack[stackCount++] = node->child1;
-					stack[stackCount++] = node->child2;
-				}
-				else
-				{
-					B2_ASSERT( stackCount < B2_TREE_STACK_SIZE - 1 );
-				}
-			}
-		}
-	}
+static inline b2FloatW b2SubW( b2FloatW a, b2FloatW b )
+{
+	return _mm256_sub_ps( a, b );
+}
 
-	return result;
+static inline b2FloatW b2MulW( b2FloatW a, b2FloatW b )
+{
+	return _mm256_mul_ps( a, b );
 }
 
-b2TreeStats b2DynamicTree_RayCast( const b2DynamicTree* tree, const b2RayCastInput* input, uint64_t maskBits,
-								   b2TreeRayCastCallbackFcn* callback, void* context )
+static inline b2FloatW b2AbsW( b2FloatW a )
 {
-	b2TreeStats result = { 0 };
+	return _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), a );
+}
 
-	if ( tree->nodeCount == 0 )
-	{
-		return result;
-	}
+// component-wise a <= b as a lane mask
+static inline b2FloatW b2LessEqualW( b2FloatW a, b2FloatW b )
+{
+	return _mm256_cmp_ps( a, b, _CMP_LE_OQ );
+}
 
-	b2Vec2 p1 = input->origin;
-	b2Vec2 d = input->translation;
+static inline b2FloatW b2AndW( b2FloatW a, b2FloatW b )
+{
+	return _mm256_and_ps( a, b );
+}
 
-	b2Vec2 r = b2Normalize( d );
+// one bit per lane mask
+static inline int b2GetMaskBitsW( b2FloatW mask )
+{
+	return _mm256_movemask_ps( mask );
+}
 
-	// v is perpendicular to the segment.
-	b2Vec2 v = b2CrossSV( 1.0f, r );
-	b2Vec2 abs_v = b2Abs( v );
+#elif defined( B2_SIMD_NEON )
 
-	// Separating axis for segment (Gino, p80).
-	// |dot(v, p1 - c)| > dot(|v|, h)
+#include <arm_neon.h>
 
-	float maxFraction = input->maxFraction;
+// wide float holds 4 numbers
+typedef float32x4_t b2FloatW;
 
-	b2Vec2 p2 = b2MulAdd( p1, maxFraction, d );
+static inline b2FloatW b2SplatW( float scalar )
+{
+	return vdupq_n_f32( scalar );
+}
 
-	// Build a bounding box for the segment.
-	b2AABB segmentAABB = { b2Min( p1, p2 ), b2Max( p1, p2 ) };
+static inline b2FloatW b2LoadW( const float* values )
+{
+	return vld1q_f32( values );
+}
 
-	int stack[B2_TREE_STACK_SIZE];
-	int stackCount = 0;
-	stack[stackCount++] = tree->root;
+static inline b2FloatW b2AddW( b2FloatW a, b2FloatW b )
+{
+	return vaddq_f32( a, b );
+}
 
-	const b2TreeNode* nodes = tree->nodes;
+static inline b2FloatW b2SubW( b2FloatW a, b2FloatW b )
+{
+	return vsubq_f32( a, b );
+}
 
-	b2RayCastInput subInput = *input;
+static inline b2FloatW b2MulW( b2FloatW a, b2FloatW b )
+{
+	return vmulq_f32( a, b );
+}
 
-	while ( stackCount > 0 )
-	{
-		int nodeId = stack[--stackCount];
-		if ( nodeId == B2_NULL_INDEX )
-		{
-			// todo is this possible?
-			B2_ASSERT( false );
-			continue;
-		}
+static inline b2FloatW b2AbsW( b2FloatW a )
+{
+	return vabsq_f32( a );
+}
 
-		const b2TreeNode* node = nodes + nodeId;
-		result.nodeVisits += 1;
+// component-wise a <= b as a lane mask
+static inline b2FloatW b2LessEqualW( b2FloatW a, b2FloatW b )
+{
+	return vreinterpretq_f32_u32( vcleq_f32( a, b ) );
+}
 
-		b2AABB nodeAABB = node->aabb;
+static inline b2FloatW b2AndW( b2FloatW a, b2FloatW b )
+{
+	return vreinterpretq_f32_u32( vandq_u32( vreinterpretq_u32_f32( a ), vreinterpretq_u32_f32( b ) ) );
+}
 
-		if ( ( node->categoryBits & maskBits ) == 0 || b2AABB_Overlaps( nodeAABB, segmentAABB ) == false )
-		{
-			continue;
-		}
+// one bit per lane mask
+static inline int b2GetMaskBitsW( b2FloatW mask )
+{
+	uint32x4_t bits = vreinterpretq_u32_f32( mask );
+	return (int)( ( vgetq_lane_u32( bits, 0 ) & 1 ) | ( vgetq_lane_u32( bits, 1 ) & 2 ) | ( vgetq_lane_u32( bits, 2 ) & 4 ) |
+				  ( vgetq_lane_u32( bits, 3 ) & 8 ) );
+}
 
-		// Separating axis for segment (Gino, p80).
-		// |dot(v, p1 - c)| > dot(|v|, h)
-		// radius extension is added to the node in this case
-		b2Vec2 c = b2AABB_Center( nodeAABB );
-		b2Vec2 h = b2AABB_Extents( nodeAABB );
-		float term1 = b2AbsFloat( b2Dot( v, b2Sub( p1, c ) ) );
-		float term2 = b2Dot( abs_v, h );
-		if ( term2 < term1 )
-		{
-			continue;
-		}
+#elif defined( B2_SIMD_SSE2 )
 
-		if ( b2IsLeaf( node ) )
-		{
-			subInput.maxFraction = maxFraction;
+#include <emmintrin.h>
 
-			float value = callback( &subInput, nodeId, node->userData, context );
-			result.leafVisits += 1;
+// wide float holds 4 numbers
+typedef __m128 b2FloatW;
 
-			// The user may return -1 to indicate this shape should be skipped
+static inline b2FloatW b2SplatW( float scalar )
+{
+	return _mm_set1_ps( scalar );
+}
 
-			if ( value == 0.0f )
-			{
-				// The client has terminated the ray cast.
-				return result;
-			}
+static inline b2FloatW b2LoadW( const float* values )
+{
+	return _mm_loadu_ps( values );
+}
 
-			if ( 0.0f < value && value <= maxFraction )
-			{
-				// Update segment bounding box.
-				maxFraction = value;
-				p2 = b2MulAdd( p1, maxFraction, d );
-				segmentAABB.lowerBound = b2Min( p1, p2 );
-				segmentAABB.upperBound = b2Max( p1, p2 );
-			}
-		}
-		else
-		{
-			if ( stackCount < B2_TREE_STACK_SIZE - 1 )
-			{
-				b2Vec2 c1 = b2AABB_Center( nodes[node->child1].aabb );
-				b2Vec2 c2 = b2AABB_Center( nodes[node->child2].aabb );
-				if ( b2DistanceSquared( c1, p1 ) < b2DistanceSquared( c2, p1 ) )
-				{
-					stack[stackCount++] = node->child2;
-					stack[stackCount++] = node->child1;
-				}
-				else
-				{
-					stack[stackCount++] = node->child1;
-					stack[stackCount++] = node->child2;
-				}
-			}
-			else
-			{
-				B2_ASSERT( stackCount < B2_TREE_STACK_SIZE - 1 );
-			}
-		}
-	}
+static inline b2FloatW b2AddW( b2FloatW a, b2FloatW b )
+{
+	return _mm_add_ps( a, b );
+}
 
-	return result;
+static inline b2FloatW b2SubW( b2FloatW a, b2FloatW b )
+{
+	return _mm_sub_ps( a, b );
 }
 
-b2TreeStats b2DynamicTree_ShapeCast( const b2DynamicTree* tree, const b2ShapeCastInput* input, uint64_t maskBits,
-									 b2TreeShapeCastCallbackFcn* callback, void* context )
+static inline b2FloatW b2MulW( b2FloatW a, b2FloatW b )
 {
-	b2TreeStats stats = { 0 };
+	return _mm_mul_ps( a, b );
+}
 
-	if ( tree->nodeCount == 0 || input->count == 0 )
-	{
-		return stats;
-	}
+static inline b2FloatW b2AbsW( b2FloatW a )
+{
+	return _mm_andnot_ps( _mm_set1_ps( -0.0f ), a );
+}
+
+// component-wise a <= b as a lane mask
+static inline b2FloatW b2LessEqualW( b2FloatW a, b2FloatW b )
+{
+	return _mm_cmple_ps( a, b );
+}
+
+static inline b2FloatW b2AndW( b2FloatW a, b2FloatW b )
+{
+	return _mm_and_ps( a, b );
+}
+
+// one bit per lane mask
+static inline int b2GetMaskBitsW( b2FloatW mask )
+{
+	return _mm_movemask_ps( mask );
+}
+
+#else
+
+// scalar math
+typedef struct b2FloatW
+{
+	float x, y, z, w;
+} b2FloatW;
+
+static inline b2FloatW b2SplatW( float scalar )
+{
+	return ( b2FloatW ){ scalar, scalar, scalar, scalar };
+}
+
+static inline b2FloatW b2LoadW( const float* values )
+{
+	return ( b2FloatW ){ values[0], values[1], values[2], values[3] };
+}
+
+static inline b2FloatW b2AddW( b2FloatW a, b2FloatW b )
+{
+	return ( b2FloatW ){ a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+}
+
+static inline b2FloatW b2SubW( b2FloatW a, b2FloatW b )
+{
+	return ( b2FloatW ){ a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+}
+
+static inline b2FloatW b2MulW( b2FloatW a, b2FloatW b )
+{
+	return ( b2FloatW ){ a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w };
+}
+
+static inline b2FloatW b2AbsW( b2FloatW a )
+{
+	return ( b2FloatW ){ b2AbsFloat( a.x ), b2AbsFloat( a.y ), b2AbsFloat( a.z ), b2AbsFloat( a.w ) };
+}
+
+// component-wise a <= b as a lane mask
+static inline b2FloatW b2LessEqualW( b2FloatW a, b2FloatW b )
+{
+	return ( b2FloatW ){ a.x <= b.x ? 1.0f : 0.0f, a.y <= b.y ? 1.0f : 0.0f, a.z <= b.z ? 1.0f : 0.0f,
+						 a.w <= b.w ? 1.0f : 0.0f };
+}
+
+static inline b2FloatW b2AndW( b2FloatW a, b2FloatW b )
+{
+	return b2MulW( a, b );
+}
+
+// one bit per lane mask
+static inline int b2GetMaskBitsW( b2FloatW mask )
+{
+	return ( mask.x != 0.0f ? 1 : 0 ) | ( mask.y != 0.0f ? 2 : 0 ) | ( mask.z != 0.0f ? 4 : 0 ) | ( mask.w != 0.0f ? 8 : 0 );
+}
+
+#endif
+
+// Returns a bit for each child lane that overlaps the box. Same as b2AABB_Overlaps.
+static int b2OverlapLanes( const b2WideNode* node, b2AABB aabb )
+{
+	b2FloatW mask = b2LessEqualW( b2LoadW( node->lowerX ), b2SplatW( aabb.upperBound.x ) );
+	mask = b2AndW( mask, b2LessEqualW( b2LoadW( node->lowerY ), b2SplatW( aabb.upperBound.y ) ) );
+	mask = b2AndW( mask, b2LessEqualW( b2SplatW( aabb.lowerBound.x ), b2LoadW( node->upperX ) ) );
+	mask = b2AndW( mask, b2LessEqualW( b2SplatW( aabb.lowerBound.y ), b2LoadW( node->upperY ) ) );
+	return b2GetMaskBitsW( mask );
+}
+
+// Returns a bit for each child lane with matching category bits
+static int b2CategoryLanes( const b2WideNode* node, uint64_t maskBits )
+{
+	int lanes = 0;
+	for ( int i = 0; i < B2_TREE_WIDTH; ++i )
+	{
+		lanes |= ( node->categoryBits[i] & maskBits ) != 0 ? 1 << i : 0;
+	}
+	return lanes;
+}
+
+// Returns a bit for each child lane that is not separated from the segment.
+// Separating axis for segment (Gino, p80).
+// |dot(v, p1 - c)| > dot(|v|, h)
+// The extension is added to the child box for shape casts.
+static int b2SegmentLanes( const b2WideNode* node, b2Vec2 p1, b2Vec2 v, b2Vec2 abs_v, b2Vec2 extension )
+{
+	b2FloatW half = b2SplatW( 0.5f );
+	b2FloatW lowerX = b2LoadW( node->lowerX );
+	b2FloatW lowerY = b2LoadW( node->lowerY );
+	b2FloatW upperX = b2LoadW( node->upperX );
+	b2FloatW upperY = b2LoadW( node->upperY );
+
+	b2FloatW cx = b2MulW( half, b2AddW( lowerX, upperX ) );
+	b2FloatW cy = b2MulW( half, b2AddW( lowerY, upperY ) );
+	b2FloatW hx = b2AddW( b2MulW( half, b2SubW( upperX, lowerX ) ), b2SplatW( extension.x ) );
+	b2FloatW hy = b2AddW( b2MulW( half, b2SubW( upperY, lowerY ) ), b2SplatW( extension.y ) );
+
+	b2FloatW dx = b2SubW( b2SplatW( p1.x ), cx );
+	b2FloatW dy = b2SubW( b2SplatW( p1.y ), cy );
+	b2FloatW term1 = b2AbsW( b2AddW( b2MulW( b2SplatW( v.x ), dx ), b2MulW( b2SplatW( v.y ), dy ) ) );
+	b2FloatW term2 = b2AddW( b2MulW( b2SplatW( abs_v.x ), hx ), b2MulW( b2SplatW( abs_v.y ), hy ) );
+	return b2GetMaskBitsW( b2LessEqualW( term1, term2 ) );
+}
+
+// Scalar version of the segment test for a single box
+static bool b2TestSegment( b2AABB aabb, b2AABB segmentAABB, b2Vec2 p1, b2Vec2 v, b2Vec2 abs_v, b2Vec2 extension )
+{
+	if ( b2AABB_Overlaps( aabb, segmentAABB ) == false )
+	{
+		return false;
+	}
+
+	b2Vec2 c = b2AABB_Center( aabb );
+	b2Vec2 h = b2Add( b2AABB_Extents( aabb ), extension );
+	float term1 = b2AbsFloat( b2Dot( v, b2Sub( p1, c ) ) );
+	float term2 = b2Dot( abs_v, h );
+	return term1 <= term2;
+}
+
+// Push the child lanes nearest last so they are popped first
+static int b2PushLanesByDistance( const b2WideNode* node, int lanes, b2Vec2 p1, int* stack, int stackCount )
+{
+	int laneIndices[B2_TREE_WIDTH];
+	float distances[B2_TREE_WIDTH];
+	int count = 0;
+
+	for ( int i = 0; i < B2_TREE_WIDTH; ++i )
+	{
+		if ( ( lanes & ( 1 << i ) ) == 0 )
+		{
+			continue;
+		}
+
+		b2Vec2 c = b2AABB_Center( b2GetLaneAABB( node, i ) );
+		float distance = b2DistanceSquared( c, p1 );
+
+		// insertion sort, farthest first
+		int j = count;
+		while ( j > 0 && distances[j - 1] < distance )
+		{
+			laneIndices[j] = laneIndices[j - 1];
+			distances[j] = distances[j - 1];
+			j -= 1;
+		}
+
+		laneIndices[j] = i;
+		distances[j] = distance;
+		count += 1;
+	}
+
+	if ( stackCount + count > B2_TREE_STACK_SIZE )
+	{
+		B2_ASSERT( stackCount + count <= B2_TREE_STACK_SIZE );
+		return stackCount;
+	}
+
+	for ( int i = 0; i < count; ++i )
+	{
+		stack[stackCount++] = node->children[laneIndices[i]];
+	}
+
+	return stackCount;
+}
+
+struct b2WideBuildItem
+{
+	int nodeIndex;
+	int parentSlot;
+};
+
+void b2DynamicTree_BuildWideTree( b2DynamicTree* tree )
+{
+	if ( tree->wideValid )
+	{
+		return;
+	}
+
+	// Every wide node consumes a distinct internal node, except for a leaf root
+	int internalCount = tree->nodeCount - tree->proxyCount;
+	int wideCapacity = internalCount + 1;
+	if ( wideCapacity > tree->wideNodeCapacity )
+	{
+		int newCapacity = wideCapacity + wideCapacity / 2;
+		b2Free( tree->wideNodes, tree->wideNodeCapacity * sizeof( b2WideNode ) );
+		tree->wideNodes = b2Alloc( newCapacity * sizeof( b2WideNode ) );
+		tree->wideNodeCapacity = newCapacity;
+	}
+
+	if ( tree->nodeCapacity > tree->wideLeafSlotCapacity )
+	{
+		b2Free( tree->wideLeafSlots, tree->wideLeafSlotCapacity * sizeof( int ) );
+		tree->wideLeafSlots = b2Alloc( tree->nodeCapacity * sizeof( int ) );
+		tree->wideLeafSlotCapacity = tree->nodeCapacity;
+	}
+
+	tree->wideNodeCount = 0;
+	tree->wideValid = true;
+
+	if ( tree->root == B2_NULL_INDEX )
+	{
+		return;
+	}
+
+	const b2TreeNode* nodes = tree->nodes;
+	b2WideNode* wideNodes = tree->wideNodes;
+
+	struct b2WideBuildItem stack[B2_TREE_STACK_SIZE];
+	int stackCount = 0;
+	stack[stackCount++] = ( struct b2WideBuildItem ){ tree->root, B2_NULL_INDEX };
+
+	while ( stackCount > 0 )
+	{
+		struct b2WideBuildItem item = stack[--stackCount];
+
+		int wideIndex = tree->wideNodeCount++;
+		B2_ASSERT( wideIndex < tree->wideNodeCapacity );
+		b2WideNode* wideNode = wideNodes + wideIndex;
+		wideNode->parentSlot = item.parentSlot;
+
+		if ( item.parentSlot != B2_NULL_INDEX )
+		{
+			wideNodes[item.parentSlot / B2_TREE_WIDTH].children[item.parentSlot % B2_TREE_WIDTH] = wideIndex;
+		}
+
+		// Collapse binary nodes into the lanes, opening the largest internal node first.
+		// Children keep their binary order so queries report leaves in the same order as the binary tree.
+		int childIndices[B2_TREE_WIDTH];
+		int childCount = 0;
+
+		const b2TreeNode* node = nodes + item.nodeIndex;
+		if ( b2IsLeaf( node ) )
+		{
+			// leaf root
+			childIndices[childCount++] = item.nodeIndex;
+		}
+		else
+		{
+			childIndices[childCount++] = node->child1;
+			childIndices[childCount++] = node->child2;
+		}
+
+		while ( childCount < B2_TREE_WIDTH )
+		{
+			int bestIndex = B2_NULL_INDEX;
+			float bestArea = -1.0f;
+			for ( int i = 0; i < childCount; ++i )
+			{
+				const b2TreeNode* child = nodes + childIndices[i];
+				if ( b2IsLeaf( child ) )
+				{
+					continue;
+				}
+
+				float area = b2Perimeter( child->aabb );
+				if ( area > bestArea )
+				{
+					bestIndex = i;
+					bestArea = area;
+				}
+			}
+
+			if ( bestIndex == B2_NULL_INDEX )
+			{
+				break;
+			}
+
+			const b2TreeNode* best = nodes + childIndices[bestIndex];
+			for ( int i = childCount; i > bestIndex + 1; --i )
+			{
+				childIndices[i] = childIndices[i - 1];
+			}
+
+			childIndices[bestIndex] = best->child1;
+			childIndices[bestIndex + 1] = best->child2;
+			childCount += 1;
+		}
+
+		wideNode->childCount = childCount;
+
+		for ( int i = 0; i < B2_TREE_WIDTH; ++i )
+		{
+			if ( i >= childCount )
+			{
+				// Unused lanes never overlap anything
+				wideNode->lowerX[i] = FLT_MAX;
+				wideNode->lowerY[i] = FLT_MAX;
+				wideNode->upperX[i] = -FLT_MAX;
+				wideNode->upperY[i] = -FLT_MAX;
+				wideNode->categoryBits[i] = 0;
+				wideNode->children[i] = B2_NULL_INDEX;
+				continue;
+			}
+
+			int childIndex = childIndices[i];
+			const b2TreeNode* child = nodes + childIndex;
+			b2SetLaneAABB( wideNode, i, child->aabb );
+			wideNode->categoryBits[i] = child->categoryBits;
+
+			if ( b2IsLeaf( child ) )
+			{
+				wideNode->children[i] = ~childIndex;
+				tree->wideLeafSlots[childIndex] = wideIndex * B2_TREE_WIDTH + i;
+			}
+			else
+			{
+				// assigned when the child wide node is built
+				wideNode->children[i] = B2_NULL_INDEX;
+			}
+		}
+
+		// Push in reverse so the first child is built next
+		for ( int i = childCount - 1; i >= 0; --i )
+		{
+			int childIndex = childIndices[i];
+			if ( b2IsLeaf( nodes + childIndex ) )
+			{
+				continue;
+			}
+
+			if ( stackCount < B2_TREE_STACK_SIZE )
+			{
+				stack[stackCount++] = ( struct b2WideBuildItem ){ childIndex, wideIndex * B2_TREE_WIDTH + i };
+			}
+			else
+			{
+				B2_ASSERT( stackCount < B2_TREE_STACK_SIZE );
+			}
+		}
+	}
+}
+
+b2TreeStats b2DynamicTree_Query( const b2DynamicTree* tree, b2AABB aabb, uint64_t maskBits, b2TreeQueryCallbackFcn* callback,
+								 void* context )
+{
+	b2TreeStats result = { 0 };
+
+	if ( tree->nodeCount == 0 )
+	{
+		return result;
+	}
+
+	int stack[B2_TREE_STACK_SIZE];
+	int stackCount = 0;
+
+	if ( tree->wideValid )
+	{
+		// Stack holds wide node indices and complemented proxy ids
+		stack[stackCount++] = 0;
+
+		while ( stackCount > 0 )
+		{
+			int childId = stack[--stackCount];
+			if ( childId < 0 )
+			{
+				int proxyId = ~childId;
+
+				// callback to user code with proxy id
+				bool proceed = callback( proxyId, tree->nodes[proxyId].userData, context );
+				result.leafVisits += 1;
+
+				if ( proceed == false )
+				{
+					return result;
+				}
+
+				continue;
+			}
+
+			const b2WideNode* wideNode = tree->wideNodes + childId;
+			result.nodeVisits += 1;
+
+			int lanes = b2OverlapLanes( wideNode, aabb ) & b2CategoryLanes( wideNode, maskBits );
+			if ( stackCount + B2_TREE_WIDTH > B2_TREE_STACK_SIZE )
+			{
+				B2_ASSERT( stackCount + B2_TREE_WIDTH <= B2_TREE_STACK_SIZE );
+				continue;
+			}
+
+			// The last lane is popped first, matching the binary traversal order
+			for ( int i = 0; i < B2_TREE_WIDTH; ++i )
+			{
+				if ( lanes & ( 1 << i ) )
+				{
+					stack[stackCount++] = wideNode->children[i];
+				}
+			}
+		}
+
+		return result;
+	}
+
+	stack[stackCount++] = tree->root;
+
+	while ( stackCount > 0 )
+	{
+		int nodeId = stack[--stackCount];
+		if ( nodeId == B2_NULL_INDEX )
+		{
+			// todo huh?
+			B2_ASSERT( false );
+			continue;
+		}
+
+		const b2TreeNode* node = tree->nodes + nodeId;
+		result.nodeVisits += 1;
+
+		if ( b2AABB_Overlaps( node->aabb, aabb ) && ( node->categoryBits & maskBits ) != 0 )
+		{
+			if ( b2IsLeaf( node ) )
+			{
+				// callback to user code with proxy id
+				bool proceed = callback( nodeId, node->userData, context );
+				result.leafVisits += 1;
+
+				if ( proceed == false )
+				{
+					return result;
+				}
+			}
+			else
+			{
+				if ( stackCount < B2_TREE_STACK_SIZE - 1 )
+				{
+					stack[stackCount++] = node->child1;
+					stack[stackCount++] = node->child2;
+				}
+				else
+				{
+					B2_ASSERT( stackCount < B2_TREE_STACK_SIZE - 1 );
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+b2TreeStats b2DynamicTree_RayCast( const b2DynamicTree* tree, const b2RayCastInput* input, uint64_t maskBits,
+								   b2TreeRayCastCallbackFcn* callback, void* context )
+{
+	b2TreeStats result = { 0 };
+
+	if ( tree->nodeCount == 0 )
+	{
+		return result;
+	}
+
+	b2Vec2 p1 = input->origin;
+	b2Vec2 d = input->translation;
+
+	b2Vec2 r = b2Normalize( d );
+
+	// v is perpendicular to the segment.
+	b2Vec2 v = b2CrossSV( 1.0f, r );
+	b2Vec2 abs_v = b2Abs( v );
+
+	// Separating axis for segment (Gino, p80).
+	// |dot(v, p1 - c)| > dot(|v|, h)
+
+	float maxFraction = input->maxFraction;
+
+	b2Vec2 p2 = b2MulAdd( p1, maxFraction, d );
+
+	// Build a bounding box for the segment.
+	b2AABB segmentAABB = { b2Min( p1, p2 ), b2Max( p1, p2 ) };
+
+	int stack[B2_TREE_STACK_SIZE];
+	int stackCount = 0;
+
+	const b2TreeNode* nodes = tree->nodes;
+
+	b2RayCastInput subInput = *input;
+
+	if ( tree->wideValid )
+	{
+		b2Vec2 extension = b2Vec2_zero;
+
+		// Stack holds wide node indices and complemented proxy ids
+		stack[stackCount++] = 0;
+
+		while ( stackCount > 0 )
+		{
+			int childId = stack[--stackCount];
+			if ( childId >= 0 )
+			{
+				const b2WideNode* wideNode = tree->wideNodes + childId;
+				result.nodeVisits += 1;
+
+				int lanes = b2OverlapLanes( wideNode, segmentAABB ) & b2CategoryLanes( wideNode, maskBits ) &
+							b2SegmentLanes( wideNode, p1, v, abs_v, extension );
+				stackCount = b2PushLanesByDistance( wideNode, lanes, p1, stack, stackCount );
+				continue;
+			}
+
+			int proxyId = ~childId;
+			const b2TreeNode* node = nodes + proxyId;
+
+			// The ray may have been clipped after this leaf was pushed
+			if ( b2TestSegment( node->aabb, segmentAABB, p1, v, abs_v, extension ) == false )
+			{
+				continue;
+			}
+
+			subInput.maxFraction = maxFraction;
+
+			float value = callback( &subInput, proxyId, node->userData, context );
+			result.leafVisits += 1;
+
+			// The user may return -1 to indicate this shape should be skipped
+
+			if ( value == 0.0f )
+			{
+				// The client has terminated the ray cast.
+				return result;
+			}
+
+			if ( 0.0f < value && value <= maxFraction )
+			{
+				// Update segment bounding box.
+				maxFraction = value;
+				p2 = b2MulAdd( p1, maxFraction, d );
+				segmentAABB.lowerBound = b2Min( p1, p2 );
+				segmentAABB.upperBound = b2Max( p1, p2 );
+			}
+		}
+
+		return result;
+	}
+
+	stack[stackCount++] = tree->root;
+
+	while ( stackCount > 0 )
+	{
+		int nodeId = stack[--stackCount];
+		if ( nodeId == B2_NULL_INDEX )
+		{
+			// todo is this possible?
+			B2_ASSERT( false );
+			continue;
+		}
+
+		const b2TreeNode* node = nodes + nodeId;
+		result.nodeVisits += 1;
+
+		b2AABB nodeAABB = node->aabb;
+
+		if ( ( node->categoryBits & maskBits ) == 0 || b2AABB_Overlaps( nodeAABB, segmentAABB ) == false )
+		{
+			continue;
+		}
+
+		// Separating axis for segment (Gino, p80).
+		// |dot(v, p1 - c)| > dot(|v|, h)
+		// radius extension is added to the node in this case
+		b2Vec2 c = b2AABB_Center( nodeAABB );
+		b2Vec2 h = b2AABB_Extents( nodeAABB );
+		float term1 = b2AbsFloat( b2Dot( v, b2Sub( p1, c ) ) );
+		float term2 = b2Dot( abs_v, h );
+		if ( term2 < term1 )
+		{
+			continue;
+		}
+
+		if ( b2IsLeaf( node ) )
+		{
+			subInput.maxFraction = maxFraction;
+
+			float value = callback( &subInput, nodeId, node->userData, context );
+			result.leafVisits += 1;
+
+			// The user may return -1 to indicate this shape should be skipped
+
+			if ( value == 0.0f )
+			{
+				// The client has terminated the ray cast.
+				return result;
+			}
+
+			if ( 0.0f < value && value <= maxFraction )
+			{
+				// Update segment bounding box.
+				maxFraction = value;
+				p2 = b2MulAdd( p1, maxFraction, d );
+				segmentAABB.lowerBound = b2Min( p1, p2 );
+				segmentAABB.upperBound = b2Max( p1, p2 );
+			}
+		}
+		else
+		{
+			if ( stackCount < B2_TREE_STACK_SIZE - 1 )
+			{
+				b2Vec2 c1 = b2AABB_Center( nodes[node->child1].aabb );
+				b2Vec2 c2 = b2AABB_Center( nodes[node->child2].aabb );
+				if ( b2DistanceSquared( c1, p1 ) < b2DistanceSquared( c2, p1 ) )
+				{
+					stack[stackCount++] = node->child2;
+					stack[stackCount++] = node->child1;
+				}
+				else
+				{
+					stack[stackCount++] = node->child1;
+					stack[stackCount++] = node->child2;
+				}
+			}
+			else
+			{
+				B2_ASSERT( stackCount < B2_TREE_STACK_SIZE - 1 );
+			}
+		}
+	}
+
+	return result;
+}
+
+b2TreeStats b2DynamicTree_ShapeCast( const b2DynamicTree* tree, const b2ShapeCastInput* input, uint64_t maskBits,
+									 b2TreeShapeCastCallbackFcn* callback, void* context )
+{
+	b2TreeStats stats = { 0 };
+
+	if ( tree->nodeCount == 0 || input->count == 0 )
+	{
+		return stats;
+	}
 
 	b2AABB originAABB = { input->points[0], input->points[0] };
 	for ( int i = 1; i < input->count; ++i )
@@ -1290,6 +2047,59 @@ b2TreeStats b2DynamicTree_ShapeCast( const b2DynamicTree* tree, const b2ShapeCas
 
 	int stack[B2_TREE_STACK_SIZE];
 	int stackCount = 0;
+
+	if ( tree->wideValid )
+	{
+		// Stack holds wide node indices and complemented proxy ids
+		stack[stackCount++] = 0;
+
+		while ( stackCount > 0 )
+		{
+			int childId = stack[--stackCount];
+			if ( childId >= 0 )
+			{
+				const b2WideNode* wideNode = tree->wideNodes + childId;
+				stats.nodeVisits += 1;
+
+				int lanes = b2OverlapLanes( wideNode, totalAABB ) & b2CategoryLanes( wideNode, maskBits ) &
+							b2SegmentLanes( wideNode, p1, v, abs_v, extension );
+				stackCount = b2PushLanesByDistance( wideNode, lanes, p1, stack, stackCount );
+				continue;
+			}
+
+			int proxyId = ~childId;
+			const b2TreeNode* node = nodes + proxyId;
+
+			// The cast may have been clipped after this leaf was pushed
+			if ( b2TestSegment( node->aabb, totalAABB, p1, v, abs_v, extension ) == false )
+			{
+				continue;
+			}
+
+			subInput.maxFraction = maxFraction;
+
+			float value = callback( &subInput, proxyId, node->userData, context );
+			stats.leafVisits += 1;
+
+			if ( value == 0.0f )
+			{
+				// The client has terminated the ray cast.
+				return stats;
+			}
+
+			if ( 0.0f < value && value < maxFraction )
+			{
+				// Update segment bounding box.
+				maxFraction = value;
+				t = b2MulSV( maxFraction, input->translation );
+				totalAABB.lowerBound = b2Min( originAABB.lowerBound, b2Add( originAABB.lowerBound, t ) );
+				totalAABB.upperBound = b2Max( originAABB.upperBound, b2Add( originAABB.upperBound, t ) );
+			}
+		}
+
+		return stats;
+	}
+
 	stack[stackCount++] = tree->root;
 
 	while ( stackCount > 0 )
@@ -1371,11 +2181,6 @@ b2TreeStats b2DynamicTree_ShapeCast( const b2DynamicTree* tree, const b2ShapeCas
 	return stats;
 }
 
-// Median split == 0, Surface area heuristic == 1
-#define B2_TREE_HEURISTIC 0
-
-#if B2_TREE_HEURISTIC == 0
-
 // Median split heuristic
 static int b2PartitionMid( int* indices, b2Vec2* centers, int count )
 {
@@ -1485,8 +2290,6 @@ static int b2PartitionMid( int* indices, b2Vec2* centers, int count )
 	return count / 2;
 }
 
-#else
-
 #define B2_BIN_COUNT 64
 
 typedef struct b2TreeBin
@@ -1610,12 +2413,12 @@ static int b2PartitionSAH( int* indices, int* binIndices, b2AABB* boxes, int cou
 	int i1 = 0, i2 = count;
 	while ( i1 < i2 )
 	{
-		while ( i1 < i2 && binIndices[i1] < bestPlane )
+		while ( i1 < i2 && binIndices[i1] <= bestPlane )
 		{
 			i1 += 1;
 		};
 
-		while ( i1 < i2 && binIndices[i2 - 1] >= bestPlane )
+		while ( i1 < i2 && binIndices[i2 - 1] > bestPlane )
 		{
 			i2 -= 1;
 		};
@@ -1652,8 +2455,6 @@ static int b2PartitionSAH( int* indices, int* binIndices, b2AABB* boxes, int cou
 	}
 }
 
-#endif
-
 // Temporary data used to track the rebuild of a tree node
 struct b2RebuildItem
 {
@@ -1666,38 +2467,54 @@ struct b2RebuildItem
 	int endIndex;
 };
 
-// Returns root node index
-static int b2BuildTree( b2DynamicTree* tree, int leafCount )
+// Partition the leaves in [startIndex, endIndex) and return the split index
+static int b2PartitionLeaves( b2DynamicTree* tree, int startIndex, int endIndex, bool useSAH )
+{
+	int count = endIndex - startIndex;
+	int splitIndex;
+	if ( useSAH )
+	{
+		splitIndex = b2PartitionSAH( tree->leafIndices + startIndex, tree->binIndices + startIndex,
+									 tree->leafBoxes + startIndex, count );
+	}
+	else
+	{
+		splitIndex = b2PartitionMid( tree->leafIndices + startIndex, tree->leafCenters + startIndex, count );
+	}
+
+	return startIndex + splitIndex;
+}
+
+// Every split of a leaf range happens at a unique index in [1, leafCount). So the internal node created by a split
+// is taken from the pre-allocated internal nodes by split index. This lets disjoint leaf ranges be built in parallel
+// and gives the same node indices regardless of how the work is distributed.
+static int b2GetSplitNode( const b2DynamicTree* tree, int splitIndex )
+{
+	return tree->internalIndices[splitIndex - 1];
+}
+
+// Build the subtree over the leaves in [startIndex, endIndex). Returns the subtree root node index.
+// Safe to call concurrently for disjoint leaf ranges.
+static int b2BuildSubtree( b2DynamicTree* tree, int startIndex, int endIndex, bool useSAH )
 {
 	b2TreeNode* nodes = tree->nodes;
 	int* leafIndices = tree->leafIndices;
 
-	if ( leafCount == 1 )
+	if ( endIndex - startIndex == 1 )
 	{
-		nodes[leafIndices[0]].parent = B2_NULL_INDEX;
-		return leafIndices[0];
+		nodes[leafIndices[startIndex]].parent = B2_NULL_INDEX;
+		return leafIndices[startIndex];
 	}
 
-#if B2_TREE_HEURISTIC == 0
-	b2Vec2* leafCenters = tree->leafCenters;
-#else
-	b2AABB* leafBoxes = tree->leafBoxes;
-	int* binIndices = tree->binIndices;
-#endif
-
 	// todo large stack item
 	struct b2RebuildItem stack[B2_TREE_STACK_SIZE];
 	int top = 0;
 
-	stack[0].nodeIndex = b2AllocateNode( tree );
 	stack[0].childCount = -1;
-	stack[0].startIndex = 0;
-	stack[0].endIndex = leafCount;
-#if B2_TREE_HEURISTIC == 0
-	stack[0].splitIndex = b2PartitionMid( leafIndices, leafCenters, leafCount );
-#else
-	stack[0].splitIndex = b2PartitionSAH( leafIndices, binIndices, leafBoxes, leafCount );
-#endif
+	stack[0].startIndex = startIndex;
+	stack[0].endIndex = endIndex;
+	stack[0].splitIndex = b2PartitionLeaves( tree, startIndex, endIndex, useSAH );
+	stack[0].nodeIndex = b2GetSplitNode( tree, stack[0].splitIndex );
 
 	while ( true )
 	{
@@ -1749,24 +2566,24 @@ static int b2BuildTree( b2DynamicTree* tree, int leafCount )
 		}
 		else
 		{
-			int startIndex, endIndex;
+			int childStartIndex, childEndIndex;
 			if ( item->childCount == 0 )
 			{
-				startIndex = item->startIndex;
-				endIndex = item->splitIndex;
+				childStartIndex = item->startIndex;
+				childEndIndex = item->splitIndex;
 			}
 			else
 			{
 				B2_ASSERT( item->childCount == 1 );
-				startIndex = item->splitIndex;
-				endIndex = item->endIndex;
+				childStartIndex = item->splitIndex;
+				childEndIndex = item->endIndex;
 			}
 
-			int count = endIndex - startIndex;
+			int count = childEndIndex - childStartIndex;
 
 			if ( count == 1 )
 			{
-				int childIndex = leafIndices[startIndex];
+				int childIndex = leafIndices[childStartIndex];
 				b2TreeNode* node = nodes + item->nodeIndex;
 
 				if ( item->childCount == 0 )
@@ -1792,17 +2609,11 @@ static int b2BuildTree( b2DynamicTree* tree, int leafCount )
 
 				top += 1;
 				struct b2RebuildItem* newItem = stack + top;
-				newItem->nodeIndex = b2AllocateNode( tree );
 				newItem->childCount = -1;
-				newItem->startIndex = startIndex;
-				newItem->endIndex = endIndex;
-#if B2_TREE_HEURISTIC == 0
-				newItem->splitIndex = b2PartitionMid( leafIndices + startIndex, leafCenters + startIndex, count );
-#else
-				newItem->splitIndex =
-					b2PartitionSAH( leafIndices + startIndex, binIndices + startIndex, leafBoxes + startIndex, count );
-#endif
-				newItem->splitIndex += startIndex;
+				newItem->startIndex = childStartIndex;
+				newItem->endIndex = childEndIndex;
+				newItem->splitIndex = b2PartitionLeaves( tree, childStartIndex, childEndIndex, useSAH );
+				newItem->nodeIndex = b2GetSplitNode( tree, newItem->splitIndex );
 			}
 		}
 	}
@@ -1822,14 +2633,11 @@ static int b2BuildTree( b2DynamicTree* tree, int leafCount )
 	return stack[0].nodeIndex;
 }
 
+// Collect the leaves of the rebuild and allocate the internal nodes. Returns the leaf count.
 // Not safe to access tree during this operation because it may grow
-int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild )
+static int b2PrepareRebuild( b2DynamicTree* tree, bool fullBuild )
 {
 	int proxyCount = tree->proxyCount;
-	if ( proxyCount == 0 )
-	{
-		return 0;
-	}
 
 	// Ensure capacity for rebuild space
 	if ( proxyCount > tree->rebuildCapacity )
@@ -1839,15 +2647,17 @@ int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild )
 		b2Free( tree->leafIndices, tree->rebuildCapacity * sizeof( int ) );
 		tree->leafIndices = b2Alloc( newCapacity * sizeof( int ) );
 
-#if B2_TREE_HEURISTIC == 0
 		b2Free( tree->leafCenters, tree->rebuildCapacity * sizeof( b2Vec2 ) );
 		tree->leafCenters = b2Alloc( newCapacity * sizeof( b2Vec2 ) );
-#else
+
 		b2Free( tree->leafBoxes, tree->rebuildCapacity * sizeof( b2AABB ) );
 		tree->leafBoxes = b2Alloc( newCapacity * sizeof( b2AABB ) );
 		b2Free( tree->binIndices, tree->rebuildCapacity * sizeof( int ) );
 		tree->binIndices = b2Alloc( newCapacity * sizeof( int ) );
-#endif
+
+		b2Free( tree->internalIndices, tree->rebuildCapacity * sizeof( int ) );
+		tree->internalIndices = b2Alloc( newCapacity * sizeof( int ) );
+
 		tree->rebuildCapacity = newCapacity;
 	}
 
@@ -1862,12 +2672,8 @@ int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild )
 	// These are the nodes that get sorted to rebuild the tree.
 	// I'm using indices because the node pool may grow during the build.
 	int* leafIndices = tree->leafIndices;
-
-#if B2_TREE_HEURISTIC == 0
 	b2Vec2* leafCenters = tree->leafCenters;
-#else
 	b2AABB* leafBoxes = tree->leafBoxes;
-#endif
 
 	// Gather all proxy nodes that have grown and all internal nodes that haven't grown. Both are
 	// considered leaves in the tree rebuild.
@@ -1879,11 +2685,17 @@ int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild )
 		if ( node->height == 0 || ( ( node->flags & b2_enlargedNode ) == 0 && fullBuild == false ) )
 		{
 			leafIndices[leafCount] = nodeIndex;
-#if B2_TREE_HEURISTIC == 0
-			leafCenters[leafCount] = b2AABB_Center( node->aabb );
-#else
-			leafBoxes[leafCount] = node->aabb;
-#endif
+
+			// Full builds use the surface area heuristic which needs the boxes
+			if ( fullBuild )
+			{
+				leafBoxes[leafCount] = node->aabb;
+			}
+			else
+			{
+				leafCenters[leafCount] = b2AABB_Center( node->aabb );
+			}
+
 			leafCount += 1;
 
 			// Detach
@@ -1935,9 +2747,218 @@ int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild )
 
 	B2_ASSERT( leafCount <= proxyCount );
 
-	tree->root = b2BuildTree( tree, leafCount );
+	// Allocate all internal nodes up front. The node pool may grow here, but not during the build.
+	for ( int i = 0; i < leafCount - 1; ++i )
+	{
+		tree->internalIndices[i] = b2AllocateNode( tree );
+	}
+
+	return leafCount;
+}
+
+static void b2FinishRebuild( b2DynamicTree* tree, int root )
+{
+	tree->root = root;
+	tree->wideValid = false;
+
+	b2DynamicTree_BuildWideTree( tree );
 
 	b2DynamicTree_Validate( tree );
+}
+
+// Partial rebuilds use the median split which is fast. Full rebuilds use the binned surface area heuristic which
+// gives better query performance.
+int b2DynamicTree_Rebuild( b2DynamicTree* tree, bool fullBuild )
+{
+	if ( tree->proxyCount == 0 )
+	{
+		return 0;
+	}
+
+	int leafCount = b2PrepareRebuild( tree, fullBuild );
+	int root = b2BuildSubtree( tree, 0, leafCount, fullBuild );
+	b2FinishRebuild( tree, root );
+
+	return leafCount;
+}
+
+// The top of the tree is split breadth first with one task per level. This is the number of levels.
+// The resulting leaf ranges are built by subtree tasks. A fixed depth keeps the tree independent of the worker count.
+#define B2_TREE_TASK_DEPTH 6
+#define B2_TREE_TASK_ITEM_CAPACITY ( ( 2 << B2_TREE_TASK_DEPTH ) - 1 )
+
+// Leaf ranges smaller than this are built by a single task
+#define B2_TREE_TASK_MIN_LEAF_COUNT 256
+
+// A leaf range at the top of a parallel rebuild
+typedef struct b2TreeTaskItem
+{
+	int startIndex;
+	int endIndex;
+
+	// Split index if the range is split at the top, otherwise B2_NULL_INDEX
+	int splitIndex;
+
+	// Child items if the range is split
+	int child1;
+	int child2;
+
+	// Root node of the range
+	int nodeIndex;
+} b2TreeTaskItem;
+
+typedef struct b2TreeTaskContext
+{
+	b2DynamicTree* tree;
+	b2TreeTaskItem* items;
+	int* itemIndices;
+	bool useSAH;
+} b2TreeTaskContext;
+
+static void b2SplitRangesTask( int startIndex, int endIndex, uint32_t workerIndex, void* context )
+{
+	B2_UNUSED( workerIndex );
+
+	b2TreeTaskContext* taskContext = context;
+	for ( int i = startIndex; i < endIndex; ++i )
+	{
+		b2TreeTaskItem* item = taskContext->items + taskContext->itemIndices[i];
+		item->splitIndex = b2PartitionLeaves( taskContext->tree, item->startIndex, item->endIndex, taskContext->useSAH );
+	}
+}
+
+static void b2BuildSubtreesTask( int startIndex, int endIndex, uint32_t workerIndex, void* context )
+{
+	B2_UNUSED( workerIndex );
+
+	b2TreeTaskContext* taskContext = context;
+	for ( int i = startIndex; i < endIndex; ++i )
+	{
+		b2TreeTaskItem* item = taskContext->items + taskContext->itemIndices[i];
+		item->nodeIndex = b2BuildSubtree( taskContext->tree, item->startIndex, item->endIndex, taskContext->useSAH );
+	}
+}
+
+static void b2RunTreeTask( b2TaskCallback* task, int itemCount, b2TreeTaskContext* context, b2EnqueueTaskCallback* enqueueTask,
+						   b2FinishTaskCallback* finishTask, void* userTaskContext )
+{
+	if ( itemCount == 0 )
+	{
+		return;
+	}
+
+	void* userTask = enqueueTask( task, itemCount, 1, context, userTaskContext );
+	if ( userTask != NULL )
+	{
+		finishTask( userTask, userTaskContext );
+	}
+}
+
+int b2DynamicTree_RebuildWithTasks( b2DynamicTree* tree, bool fullBuild, b2EnqueueTaskCallback* enqueueTask,
+									b2FinishTaskCallback* finishTask, void* userTaskContext )
+{
+	if ( tree->proxyCount == 0 )
+	{
+		return 0;
+	}
+
+	int leafCount = b2PrepareRebuild( tree, fullBuild );
+	if ( leafCount < 2 * B2_TREE_TASK_MIN_LEAF_COUNT )
+	{
+		int root = b2BuildSubtree( tree, 0, leafCount, fullBuild );
+		b2FinishRebuild( tree, root );
+		return leafCount;
+	}
+
+	b2TreeTaskItem items[B2_TREE_TASK_ITEM_CAPACITY];
+	int itemIndices[B2_TREE_TASK_ITEM_CAPACITY];
+	int itemCount = 0;
+
+	b2TreeTaskContext context = { tree, items, itemIndices, fullBuild };
+
+	items[itemCount++] = ( b2TreeTaskItem ){ 0, leafCount, B2_NULL_INDEX, B2_NULL_INDEX, B2_NULL_INDEX, B2_NULL_INDEX };
+
+	// Split the top levels breadth first. Ranges on a level are disjoint, so they are partitioned in parallel.
+	int levelStart = 0;
+	for ( int level = 0; level < B2_TREE_TASK_DEPTH; ++level )
+	{
+		int levelEnd = itemCount;
+		int splitCount = 0;
+		for ( int i = levelStart; i < levelEnd; ++i )
+		{
+			if ( items[i].endIndex - items[i].startIndex >= 2 * B2_TREE_TASK_MIN_LEAF_COUNT )
+			{
+				itemIndices[splitCount++] = i;
+			}
+		}
+
+		if ( splitCount == 0 )
+		{
+			break;
+		}
+
+		b2RunTreeTask( b2SplitRangesTask, splitCount, &context, enqueueTask, finishTask, userTaskContext );
+
+		for ( int i = 0; i < splitCount; ++i )
+		{
+			b2TreeTaskItem* item = items + itemIndices[i];
+			B2_ASSERT( item->startIndex < item->splitIndex && item->splitIndex < item->endIndex );
+			B2_ASSERT( itemCount + 2 <= B2_TREE_TASK_ITEM_CAPACITY );
+
+			item->child1 = itemCount;
+			items[itemCount++] = ( b2TreeTaskItem ){
+				item->startIndex, item->splitIndex, B2_NULL_INDEX, B2_NULL_INDEX, B2_NULL_INDEX, B2_NULL_INDEX,
+			};
+
+			item->child2 = itemCount;
+			items[itemCount++] = ( b2TreeTaskItem ){
+				item->splitIndex, item->endIndex, B2_NULL_INDEX, B2_NULL_INDEX, B2_NULL_INDEX, B2_NULL_INDEX,
+			};
+		}
+
+		levelStart = levelEnd;
+	}
+
+	// Build the ranges that were not split as independent subtrees
+	int subtreeCount = 0;
+	for ( int i = 0; i < itemCount; ++i )
+	{
+		if ( items[i].splitIndex == B2_NULL_INDEX )
+		{
+			itemIndices[subtreeCount++] = i;
+		}
+	}
+
+	b2RunTreeTask( b2BuildSubtreesTask, subtreeCount, &context, enqueueTask, finishTask, userTaskContext );
+
+	// Join the subtrees. Children always come after their parent, so walk backwards.
+	b2TreeNode* nodes = tree->nodes;
+	for ( int i = itemCount - 1; i >= 0; --i )
+	{
+		b2TreeTaskItem* item = items + i;
+		if ( item->splitIndex == B2_NULL_INDEX )
+		{
+			continue;
+		}
+
+		int nodeIndex = b2GetSplitNode( tree, item->splitIndex );
+		b2TreeNode* node = nodes + nodeIndex;
+		b2TreeNode* child1 = nodes + items[item->child1].nodeIndex;
+		b2TreeNode* child2 = nodes + items[item->child2].nodeIndex;
+
+		node->child1 = items[item->child1].nodeIndex;
+		node->child2 = items[item->child2].nodeIndex;
+		child1->parent = nodeIndex;
+		child2->parent = nodeIndex;
+
+		node->aabb = b2AABB_Union( child1->aabb, child2->aabb );
+		node->height = 1 + b2MaxUInt16( child1->height, child2->height );
+		node->categoryBits = child1->categoryBits | child2->categoryBits;
+
+		item->nodeIndex = nodeIndex;
+	}
+
+	b2FinishRebuild( tree, items[0].nodeIndex );
 
 	return leafCount;
 }
@@ -0,0 +1,15 @@
+//
+//  dynamic_tree.h
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+#pragma once
+
+#include "box2d/types.h"
+
+// Rebuild the tree like b2DynamicTree_Rebuild, splitting the work into tasks. The resulting tree is identical to
+// b2DynamicTree_Rebuild regardless of how the task system distributes the work.
+int b2DynamicTree_RebuildWithTasks( b2DynamicTree* tree, bool fullBuild, b2EnqueueTaskCallback* enqueueTask,
+									b2FinishTaskCallback* finishTask, void* userTaskContext );
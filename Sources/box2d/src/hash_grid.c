@@ -0,0 +1,301 @@
+//
+//  hash_grid.c
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+#include "hash_grid.h"
+
+#include "aabb.h"
+#include "arena_allocator.h"
+#include "constants.h"
+#include "core.h"
+#include "ctz.h"
+
+#include "box2d/math_functions.h"
+
+#include <math.h>
+#include <string.h>
+
+// A small proxy must fit in a cell with this margin, so rounding of cell coordinates cannot hide an overlap
+#define B2_GRID_CELL_MARGIN 1.125f
+
+// Keeps cell coordinates in the integer range
+#define B2_GRID_COORDINATE_LIMIT 1.0e9f
+
+b2HashGrid b2CreateHashGrid( float cellSize )
+{
+	b2HashGrid grid = { 0 };
+	grid.proxyIds = b2IntArray_Create( 16 );
+	grid.proxyIndices = b2IntArray_Create( 16 );
+	grid.requestedCellSize = cellSize;
+	return grid;
+}
+
+void b2DestroyHashGrid( b2HashGrid* grid )
+{
+	B2_ASSERT( grid->proxies == NULL );
+	b2IntArray_Destroy( &grid->proxyIds );
+	b2IntArray_Destroy( &grid->proxyIndices );
+	*grid = ( b2HashGrid ){ 0 };
+}
+
+void b2HashGrid_Clear( b2HashGrid* grid )
+{
+	B2_ASSERT( grid->proxies == NULL );
+	b2IntArray_Clear( &grid->proxyIds );
+	b2IntArray_Clear( &grid->proxyIndices );
+}
+
+void b2HashGrid_AddProxy( b2HashGrid* grid, int proxyId )
+{
+	b2IntArray* indices = &grid->proxyIndices;
+	int oldCount = indices->count;
+	if ( proxyId >= oldCount )
+	{
+		if ( proxyId >= indices->capacity )
+		{
+			// Grow geometrically, proxy ids usually increase one at a time
+			b2IntArray_Reserve( indices, b2MaxInt( proxyId + 1, 2 * indices->capacity ) );
+		}
+
+		b2IntArray_Resize( indices, proxyId + 1 );
+		for ( int i = oldCount; i <= proxyId; ++i )
+		{
+			indices->data[i] = B2_NULL_INDEX;
+		}
+	}
+
+	B2_ASSERT( indices->data[proxyId] == B2_NULL_INDEX );
+	indices->data[proxyId] = grid->proxyIds.count;
+	b2IntArray_Push( &grid->proxyIds, proxyId );
+}
+
+void b2HashGrid_RemoveProxy( b2HashGrid* grid, int proxyId )
+{
+	if ( proxyId >= grid->proxyIndices.count || grid->proxyIndices.data[proxyId] == B2_NULL_INDEX )
+	{
+		// Proxy without category bits
+		return;
+	}
+
+	int index = grid->proxyIndices.data[proxyId];
+	grid->proxyIndices.data[proxyId] = B2_NULL_INDEX;
+
+	int movedIndex = b2IntArray_RemoveSwap( &grid->proxyIds, index );
+	if ( movedIndex != B2_NULL_INDEX )
+	{
+		int movedProxyId = grid->proxyIds.data[index];
+		grid->proxyIndices.data[movedProxyId] = index;
+	}
+}
+
+static inline int b2GridCoordinate( float x, float inverseCellSize )
+{
+	float c = b2ClampFloat( x * inverseCellSize, -B2_GRID_COORDINATE_LIMIT, B2_GRID_COORDINATE_LIMIT );
+	return (int)floorf( c );
+}
+
+// Neighboring cells of a row go to consecutive buckets, so a query reads few cache lines
+static inline int b2GridBucket( int x, int y, int bucketMask )
+{
+	uint32_t hash = (uint32_t)x + (uint32_t)y * 19349663u;
+	return (int)( hash & (uint32_t)bucketMask );
+}
+
+static inline float b2GridExtent( b2AABB aabb )
+{
+	return b2MaxFloat( aabb.upperBound.x - aabb.lowerBound.x, aabb.upperBound.y - aabb.lowerBound.y );
+}
+
+void b2HashGrid_Build( b2HashGrid* grid, const b2DynamicTree* tree, b2ArenaAllocator* alloc )
+{
+	int count = grid->proxyIds.count;
+	grid->proxyCount = count;
+	grid->smallCount = 0;
+
+	if ( count == 0 )
+	{
+		grid->proxies = NULL;
+		grid->bucketStarts = NULL;
+		grid->bucketMask = 0;
+		return;
+	}
+
+	const int* proxyIds = grid->proxyIds.data;
+
+	float cellSize = grid->requestedCellSize;
+	if ( cellSize <= 0.0f )
+	{
+		// Twice the average extent keeps shapes of similar size out of the large proxy list
+		float extentSum = 0.0f;
+		for ( int i = 0; i < count; ++i )
+		{
+			extentSum += b2GridExtent( b2DynamicTree_GetAABB( tree, proxyIds[i] ) );
+		}
+
+		cellSize = 2.0f * extentSum / count;
+	}
+
+	cellSize = b2MaxFloat( cellSize, B2_LINEAR_SLOP );
+	float inverseCellSize = 1.0f / cellSize;
+	grid->cellSize = cellSize;
+	grid->inverseCellSize = inverseCellSize;
+
+	int bucketCount = b2RoundUpPowerOf2( 2 * count );
+	int bucketMask = bucketCount - 1;
+	grid->bucketMask = bucketMask;
+
+	b2GridProxy* proxies = b2AllocateArenaItem( alloc, count * sizeof( b2GridProxy ), "grid proxies" );
+	int* bucketStarts = b2AllocateArenaItem( alloc, ( bucketCount + 1 ) * sizeof( int ), "grid buckets" );
+	b2GridProxy* unsorted = b2AllocateArenaItem( alloc, count * sizeof( b2GridProxy ), "grid unsorted" );
+
+	memset( bucketStarts, 0, ( bucketCount + 1 ) * sizeof( int ) );
+
+	// Large proxies go to the end of the array, small proxies are counted per bucket
+	int smallCount = 0;
+	int largeIndex = count;
+	for ( int i = 0; i < count; ++i )
+	{
+		int proxyId = proxyIds[i];
+		b2AABB aabb = b2DynamicTree_GetAABB( tree, proxyId );
+		int userData = b2DynamicTree_GetUserData( tree, proxyId );
+
+		if ( B2_GRID_CELL_MARGIN * b2GridExtent( aabb ) > cellSize )
+		{
+			largeIndex -= 1;
+			proxies[largeIndex] = ( b2GridProxy ){ aabb, proxyId, userData, 0, 0 };
+			continue;
+		}
+
+		int cellX = b2GridCoordinate( aabb.lowerBound.x, inverseCellSize );
+		int cellY = b2GridCoordinate( aabb.lowerBound.y, inverseCellSize );
+		unsorted[smallCount] = ( b2GridProxy ){ aabb, proxyId, userData, cellX, cellY };
+		smallCount += 1;
+
+		bucketStarts[b2GridBucket( cellX, cellY, bucketMask )] += 1;
+	}
+
+	B2_ASSERT( smallCount == largeIndex );
+
+	// Inclusive prefix sum gives the end of each bucket
+	int sum = 0;
+	for ( int i = 0; i < bucketCount; ++i )
+	{
+		sum += bucketStarts[i];
+		bucketStarts[i] = sum;
+	}
+	bucketStarts[bucketCount] = smallCount;
+
+	// Fill buckets backwards to keep the proxy order within a bucket, leaving the start of each bucket
+	for ( int i = smallCount - 1; i >= 0; --i )
+	{
+		b2GridProxy* proxy = unsorted + i;
+		int bucket = b2GridBucket( proxy->cellX, proxy->cellY, bucketMask );
+		bucketStarts[bucket] -= 1;
+		proxies[bucketStarts[bucket]] = *proxy;
+	}
+
+	b2FreeArenaItem( alloc, unsorted );
+
+	grid->proxies = proxies;
+	grid->bucketStarts = bucketStarts;
+	grid->smallCount = smallCount;
+}
+
+void b2HashGrid_Free( b2HashGrid* grid, b2ArenaAllocator* alloc )
+{
+	if ( grid->proxies == NULL )
+	{
+		return;
+	}
+
+	b2FreeArenaItem( alloc, grid->bucketStarts );
+	b2FreeArenaItem( alloc, grid->proxies );
+	grid->bucketStarts = NULL;
+	grid->proxies = NULL;
+}
+
+b2TreeStats b2HashGrid_Query( const b2HashGrid* grid, b2AABB aabb, b2TreeQueryCallbackFcn* callback, void* context )
+{
+	b2TreeStats result = { 0 };
+
+	if ( grid->proxyCount == 0 )
+	{
+		return result;
+	}
+
+	const b2GridProxy* proxies = grid->proxies;
+	int smallCount = grid->smallCount;
+
+	// A small proxy overlapping the box has its lower bound at most one cell below the lower bound of the box
+	float inverseCellSize = grid->inverseCellSize;
+	int lowerX = b2GridCoordinate( aabb.lowerBound.x, inverseCellSize ) - 1;
+	int lowerY = b2GridCoordinate( aabb.lowerBound.y, inverseCellSize ) - 1;
+	int upperX = b2GridCoordinate( aabb.upperBound.x, inverseCellSize );
+	int upperY = b2GridCoordinate( aabb.upperBound.y, inverseCellSize );
+
+	int64_t cellCount = (int64_t)( upperX - lowerX + 1 ) * (int64_t)( upperY - lowerY + 1 );
+	if ( cellCount > smallCount )
+	{
+		// Large query box, cheaper to test every proxy
+		for ( int i = 0; i < smallCount; ++i )
+		{
+			const b2GridProxy* proxy = proxies + i;
+			result.leafVisits += 1;
+
+			if ( b2AABB_Overlaps( proxy->aabb, aabb ) && callback( proxy->proxyId, proxy->userData, context ) == false )
+			{
+				return result;
+			}
+		}
+	}
+	else
+	{
+		const int* bucketStarts = grid->bucketStarts;
+		int bucketMask = grid->bucketMask;
+
+		for ( int y = lowerY; y <= upperY; ++y )
+		{
+			for ( int x = lowerX; x <= upperX; ++x )
+			{
+				int bucket = b2GridBucket( x, y, bucketMask );
+				int start = bucketStarts[bucket];
+				int end = bucketStarts[bucket + 1];
+				result.nodeVisits += 1;
+
+				for ( int i = start; i < end; ++i )
+				{
+					const b2GridProxy* proxy = proxies + i;
+
+					// Other cells share the bucket, skip them so each proxy is reported once
+					if ( proxy->cellX != x || proxy->cellY != y )
+					{
+						continue;
+					}
+
+					result.leafVisits += 1;
+
+					if ( b2AABB_Overlaps( proxy->aabb, aabb ) && callback( proxy->proxyId, proxy->userData, context ) == false )
+					{
+						return result;
+					}
+				}
+			}
+		}
+	}
+
+	for ( int i = smallCount; i < grid->proxyCount; ++i )
+	{
+		const b2GridProxy* proxy = proxies + i;
+		result.leafVisits += 1;
+
+		if ( b2AABB_Overlaps( proxy->aabb, aabb ) && callback( proxy->proxyId, proxy->userData, context ) == false )
+		{
+			return result;
+		}
+	}
+
+	return result;
+}
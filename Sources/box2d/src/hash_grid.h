@@ -0,0 +1,63 @@
+//
+//  hash_grid.h
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+#pragma once
+
+#include "array.h"
+
+#include "box2d/collision.h"
+
+typedef struct b2ArenaAllocator b2ArenaAllocator;
+
+typedef struct b2GridProxy
+{
+	b2AABB aabb;
+	int proxyId;
+	int userData;
+	int cellX;
+	int cellY;
+} b2GridProxy;
+
+// Hashed uniform grid over the proxies of a dynamic tree. It is used instead of the tree to find new pairs.
+// The tree still owns the proxies and is used for world queries, so the grid only tracks proxy ids and
+// is rebuilt from the tree AABBs before the pair query.
+// Each proxy is stored in the cell of its lower bound, so a query only visits the cells around its lower bound.
+// Proxies larger than a cell are kept in a separate list that is tested by every query.
+typedef struct b2HashGrid
+{
+	// Proxies that can be found by queries. Proxies without category bits are never found by the tree either.
+	b2IntArray proxyIds;
+
+	// Index into proxyIds for each proxy id, B2_NULL_INDEX if not in the grid
+	b2IntArray proxyIndices;
+
+	// Requested cell size, zero to compute it on each build
+	float requestedCellSize;
+
+	// Built grid, allocated on the arena between b2HashGrid_Build and b2HashGrid_Free
+	b2GridProxy* proxies;
+	int* bucketStarts;
+	int bucketMask;
+	int smallCount;
+	int proxyCount;
+	float cellSize;
+	float inverseCellSize;
+} b2HashGrid;
+
+b2HashGrid b2CreateHashGrid( float cellSize );
+void b2DestroyHashGrid( b2HashGrid* grid );
+
+void b2HashGrid_Clear( b2HashGrid* grid );
+
+void b2HashGrid_AddProxy( b2HashGrid* grid, int proxyId );
+void b2HashGrid_RemoveProxy( b2HashGrid* grid, int proxyId );
+
+void b2HashGrid_Build( b2HashGrid* grid, const b2DynamicTree* tree, b2ArenaAllocator* alloc );
+void b2HashGrid_Free( b2HashGrid* grid, b2ArenaAllocator* alloc );
+
+// Reports every proxy with a bounding box overlapping the query box, same as b2DynamicTree_Query with all mask bits
+b2TreeStats b2HashGrid_Query( const b2HashGrid* grid, b2AABB aabb, b2TreeQueryCallbackFcn* callback, void* context );
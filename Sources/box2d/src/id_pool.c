@@ -16,6 +16,17 @@ void b2DestroyIdPool( b2IdPool* pool )
 	*pool = ( b2IdPool ){ 0 };
 }
 
+void b2ResetIdPool( b2IdPool* pool )
+{
+	// b2AllocId pops from the end
+	b2IntArray_Clear( &pool->freeArray );
+	b2IntArray_Reserve( &pool->freeArray, pool->nextIndex );
+	for ( int id = pool->nextIndex - 1; id >= 0; --id )
+	{
+		b2IntArray_Push( &pool->freeArray, id );
+	}
+}
+
 int b2AllocId( b2IdPool* pool )
 {
 	int count = pool->freeArray.count;
@@ -14,6 +14,9 @@ typedef struct b2IdPool
 b2IdPool b2CreateIdPool( void );
 void b2DestroyIdPool( b2IdPool* pool );
 
+// Free all ids, keeping the capacity. Ids are allocated again from the lowest one, like a new pool.
+void b2ResetIdPool( b2IdPool* pool );
+
 int b2AllocId( b2IdPool* pool );
 void b2FreeId( b2IdPool* pool, int id );
 void b2ValidateFreeId( b2IdPool* pool, int id );
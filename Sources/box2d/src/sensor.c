@@ -26,6 +26,7 @@ struct b2SensorQueryContext
 	b2Sensor* sensor;
 	b2Shape* sensorShape;
 	b2Transform transform;
+	bool foundAwakeShape;
 };
 
 // Sensor shapes need to
@@ -44,6 +45,12 @@ struct b2SensorQueryContext
 // Each sensor has an double buffered array of overlaps
 // These overlaps use a shape reference with index and generation
 
+// Caching
+// The overlaps of a sensor can only change if the sensor moved or a shape that can overlap it changed.
+// Static and sleeping shapes only change through proxy changes or by falling asleep, which bump the
+// broad-phase version. So a sensor keeps its overlaps if it didn't move, the version is the same, and
+// no awake shape overlaps its bounds or was overlapping it in the previous step.
+
 static bool b2SensorQueryCallback( int proxyId, int shapeId, void* context )
 {
 	B2_UNUSED( proxyId );
@@ -98,6 +105,80 @@ static bool b2SensorQueryCallback( int proxyId, int shapeId, void* context )
 	return true;
 }
 
+static bool b2AwakeShapeQueryCallback( int proxyId, int shapeId, void* context )
+{
+	B2_UNUSED( proxyId );
+
+	struct b2SensorQueryContext* queryContext = context;
+	b2Shape* sensorShape = queryContext->sensorShape;
+	if ( shapeId == sensorShape->id )
+	{
+		return true;
+	}
+
+	b2World* world = queryContext->world;
+	b2Shape* otherShape = b2ShapeArray_Get( &world->shapes, shapeId );
+	if ( otherShape->sensorIndex != B2_NULL_INDEX || b2ShouldShapesCollide( sensorShape->filter, otherShape->filter ) == false )
+	{
+		return true;
+	}
+
+	b2Body* body = b2BodyArray_Get( &world->bodies, otherShape->bodyId );
+	if ( body->setIndex == b2_awakeSet )
+	{
+		// Found a shape that may have moved, stop the query
+		queryContext->foundAwakeShape = true;
+		return false;
+	}
+
+	return true;
+}
+
+// Returns true if the overlaps of the sensor from the previous step are still valid.
+static bool b2IsSensorUnchanged( b2World* world, b2Sensor* sensor, b2Shape* sensorShape, b2Transform transform )
+{
+	if ( sensor->hasQuery == false || sensor->version != world->broadPhase.version )
+	{
+		return false;
+	}
+
+	if ( sensor->transform.p.x != transform.p.x || sensor->transform.p.y != transform.p.y ||
+		 sensor->transform.q.c != transform.q.c || sensor->transform.q.s != transform.q.s )
+	{
+		return false;
+	}
+
+	// A shape may have moved out of the sensor bounds
+	int count = sensor->overlaps2.count;
+	for ( int i = 0; i < count; ++i )
+	{
+		b2Shape* otherShape = b2ShapeArray_Get( &world->shapes, sensor->overlaps2.data[i].shapeId );
+		b2Body* body = b2BodyArray_Get( &world->bodies, otherShape->bodyId );
+		if ( body->setIndex == b2_awakeSet )
+		{
+			return false;
+		}
+	}
+
+	// A shape may have moved into the sensor bounds. Static shapes are covered by the version.
+	struct b2SensorQueryContext queryContext = {
+		.world = world,
+		.sensorShape = sensorShape,
+		.sensor = sensor,
+	};
+
+	b2DynamicTree* trees = world->broadPhase.trees;
+	b2AABB queryBounds = sensorShape->aabb;
+	uint64_t maskBits = sensorShape->filter.maskBits;
+	b2DynamicTree_Query( trees + b2_kinematicBody, queryBounds, maskBits, b2AwakeShapeQueryCallback, &queryContext );
+	if ( queryContext.foundAwakeShape == false )
+	{
+		b2DynamicTree_Query( trees + b2_dynamicBody, queryBounds, maskBits, b2AwakeShapeQueryCallback, &queryContext );
+	}
+
+	return queryContext.foundAwakeShape == false;
+}
+
 static int b2CompareShapeRefs( const void* a, const void* b )
 {
 	const b2ShapeRef* sa = a;
@@ -139,6 +220,17 @@ static void b2SensorTask( int startIndex, int endIndex, uint32_t threadIndex, vo
 	{
 		b2Sensor* sensor = b2SensorArray_Get( &world->sensors, sensorIndex );
 		b2Shape* sensorShape = b2ShapeArray_Get( &world->shapes, sensor->shapeId );
+		b2Transform transform = b2GetBodyTransform( world, sensorShape->bodyId );
+
+		if ( b2IsSensorUnchanged( world, sensor, sensorShape, transform ) )
+		{
+			// Overlaps are the same, keep them without events
+			continue;
+		}
+
+		sensor->transform = transform;
+		sensor->version = world->broadPhase.version;
+		sensor->hasQuery = true;
 
 		// swap overlap arrays
 		b2ShapeRefArray temp = sensor->overlaps1;
@@ -146,8 +238,6 @@ static void b2SensorTask( int startIndex, int endIndex, uint32_t threadIndex, vo
 		sensor->overlaps2 = temp;
 		b2ShapeRefArray_Clear( &sensor->overlaps2 );
 
-		b2Transform transform = b2GetBodyTransform( world, sensorShape->bodyId );
-
 		struct b2SensorQueryContext queryContext = {
 			.world = world,
 			.taskContext = taskContext,
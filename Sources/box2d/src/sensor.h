@@ -6,6 +6,8 @@
 #include "array.h"
 #include "bitset.h"
 
+#include "box2d/math_functions.h"
+
 typedef struct b2Shape b2Shape;
 typedef struct b2World b2World;
 
@@ -19,6 +21,12 @@ typedef struct b2Sensor
 {
 	b2ShapeRefArray overlaps1;
 	b2ShapeRefArray overlaps2;
+
+	// Sensor transform and broad-phase version of the last query, used to skip sensors in unchanged regions
+	b2Transform transform;
+	uint32_t version;
+	bool hasQuery;
+
 	int shapeId;
 } b2Sensor;
 
@@ -170,6 +170,9 @@ void b2TrySleepIsland( b2World* world, int islandId )
 	// - identify non-touching contacts that should move to sleeping solver set or disabled set
 	// - remove old island
 	// - fix island
+	// Bodies of the island may have moved in this step, sensors must not rely on them being asleep
+	world->broadPhase.version += 1;
+
 	int sleepSetId = b2AllocId( &world->solverSetIdPool );
 	if ( sleepSetId == world->solverSets.count )
 	{
@@ -18,6 +18,7 @@
 #include "contact.h"
 #include "core.h"
 #include "ctz.h"
+#include "dynamic_tree.h"
 #include "island.h"
 #include "joint.h"
 #include "sensor.h"
@@ -129,7 +130,7 @@ b2WorldId b2CreateWorld( const b2WorldDef* def )
 	world->inUse = true;
 
 	world->stackAllocator = b2CreateArenaAllocator( 2048 );
-	b2CreateBroadPhase( &world->broadPhase );
+	b2CreateBroadPhase( &world->broadPhase, def );
 	b2CreateGraph( &world->constraintGraph, 16 );
 
 	// pools
@@ -354,6 +355,139 @@ void b2DestroyWorld( b2WorldId worldId )
 	world->generation = generation + 1;
 }
 
+void b2World_Reset( b2WorldId worldId )
+{
+	b2World* world = b2GetWorldFromId( worldId );
+	B2_ASSERT( world->locked == false );
+	if ( world->locked )
+	{
+		return;
+	}
+
+	// Objects are freed like their destroy functions do, so the slots keep their generation and old ids stay invalid
+	int bodyCapacity = world->bodies.count;
+	for ( int i = 0; i < bodyCapacity; ++i )
+	{
+		b2Body* body = world->bodies.data + i;
+		body->setIndex = B2_NULL_INDEX;
+		body->localIndex = B2_NULL_INDEX;
+		body->id = B2_NULL_INDEX;
+	}
+
+	int shapeCapacity = world->shapes.count;
+	for ( int i = 0; i < shapeCapacity; ++i )
+	{
+		world->shapes.data[i].id = B2_NULL_INDEX;
+	}
+
+	int chainCapacity = world->chainShapes.count;
+	for ( int i = 0; i < chainCapacity; ++i )
+	{
+		b2ChainShape* chain = world->chainShapes.data + i;
+		if ( chain->id != B2_NULL_INDEX )
+		{
+			b2FreeChainData( chain );
+			chain->id = B2_NULL_INDEX;
+		}
+	}
+
+	int jointCapacity = world->joints.count;
+	for ( int i = 0; i < jointCapacity; ++i )
+	{
+		b2Joint* joint = world->joints.data + i;
+		joint->setIndex = B2_NULL_INDEX;
+		joint->localIndex = B2_NULL_INDEX;
+		joint->colorIndex = B2_NULL_INDEX;
+		joint->jointId = B2_NULL_INDEX;
+	}
+
+	int contactCapacity = world->contacts.count;
+	for ( int i = 0; i < contactCapacity; ++i )
+	{
+		b2Contact* contact = world->contacts.data + i;
+		contact->contactId = B2_NULL_INDEX;
+		contact->setIndex = B2_NULL_INDEX;
+		contact->colorIndex = B2_NULL_INDEX;
+		contact->localIndex = B2_NULL_INDEX;
+	}
+
+	int islandCapacity = world->islands.count;
+	for ( int i = 0; i < islandCapacity; ++i )
+	{
+		b2Island* island = world->islands.data + i;
+		island->islandId = B2_NULL_INDEX;
+		island->setIndex = B2_NULL_INDEX;
+	}
+
+	int sensorCount = world->sensors.count;
+	for ( int i = 0; i < sensorCount; ++i )
+	{
+		b2ShapeRefArray_Destroy( &world->sensors.data[i].overlaps1 );
+		b2ShapeRefArray_Destroy( &world->sensors.data[i].overlaps2 );
+	}
+
+	b2SensorArray_Clear( &world->sensors );
+
+	// Sleeping sets are created with new arrays when islands fall asleep, the other sets keep their arrays
+	int setCapacity = world->solverSets.count;
+	for ( int i = 0; i < setCapacity; ++i )
+	{
+		b2SolverSet* set = world->solverSets.data + i;
+		if ( i >= b2_firstSleepingSet )
+		{
+			if ( set->setIndex != B2_NULL_INDEX )
+			{
+				b2DestroySolverSet( world, i );
+			}
+
+			continue;
+		}
+
+		b2BodySimArray_Clear( &set->bodySims );
+		b2BodyStateArray_Clear( &set->bodyStates );
+		b2JointSimArray_Clear( &set->jointSims );
+		b2ContactSimArray_Clear( &set->contactSims );
+		b2IslandSimArray_Clear( &set->islandSims );
+	}
+
+	b2ResetIdPool( &world->bodyIdPool );
+	b2ResetIdPool( &world->shapeIdPool );
+	b2ResetIdPool( &world->chainIdPool );
+	b2ResetIdPool( &world->contactIdPool );
+	b2ResetIdPool( &world->jointIdPool );
+	b2ResetIdPool( &world->islandIdPool );
+	b2ResetIdPool( &world->solverSetIdPool );
+
+	// Static, disabled, and awake sets
+	for ( int i = 0; i < b2_firstSleepingSet; ++i )
+	{
+		int setIndex = b2AllocId( &world->solverSetIdPool );
+		B2_UNUSED( setIndex );
+		B2_ASSERT( setIndex == i && world->solverSets.data[i].setIndex == i );
+	}
+
+	b2ResetGraph( &world->constraintGraph );
+	b2ResetBroadPhase( &world->broadPhase );
+
+	b2BodyMoveEventArray_Clear( &world->bodyMoveEvents );
+	b2SensorBeginTouchEventArray_Clear( &world->sensorBeginEvents );
+	b2SensorEndTouchEventArray_Clear( world->sensorEndEvents + 0 );
+	b2SensorEndTouchEventArray_Clear( world->sensorEndEvents + 1 );
+	b2ContactBeginTouchEventArray_Clear( &world->contactBeginEvents );
+	b2ContactEndTouchEventArray_Clear( world->contactEndEvents + 0 );
+	b2ContactEndTouchEventArray_Clear( world->contactEndEvents + 1 );
+	b2ContactHitEventArray_Clear( &world->contactHitEvents );
+	world->endEventArrayIndex = 0;
+
+	world->stepIndex = 0;
+	world->splitIslandId = B2_NULL_INDEX;
+	world->activeTaskCount = 0;
+	world->taskCount = 0;
+	world->profile = ( b2Profile ){ 0 };
+
+	b2ValidateSolverSets( world );
+}
+
 static void b2CollideTask( int startIndex, int endIndex, uint32_t threadIndex, void* context )
 {
 	b2TracyCZoneNC( collide_task, "Collide", b2_colorDodgerBlue, true );
@@ -1815,6 +1949,7 @@ b2Counters b2World_GetCounters( b2WorldId worldId )
 	s.contactCount = b2GetIdCount( &world->contactIdPool );
 	s.jointCount = b2GetIdCount( &world->jointIdPool );
 	s.islandCount = b2GetIdCount( &world->islandIdPool );
+	s.awakeIslandCount = b2SolverSetArray_Get( &world->solverSets, b2_awakeSet )->islandSims.count;
 
 	b2DynamicTree* staticTree = world->broadPhase.trees + b2_staticBody;
 	s.staticTreeHeight = b2DynamicTree_GetHeight( staticTree );
@@ -2730,7 +2865,7 @@ void b2World_RebuildStaticTree( b2WorldId worldId )
 	}
 
 	b2DynamicTree* staticTree = world->broadPhase.trees + b2_staticBody;
-	b2DynamicTree_Rebuild( staticTree, true );
+	b2DynamicTree_RebuildWithTasks( staticTree, true, world->enqueueTaskFcn, world->finishTaskFcn, world->userTaskContext );
 }
 
 void b2World_EnableSpeculative( b2WorldId worldId, bool flag )
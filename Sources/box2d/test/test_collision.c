@@ -2,8 +2,10 @@
 // SPDX-License-Identifier: MIT
 
 #include "aabb.h"
+#include "dynamic_tree.h"
 #include "test_macros.h"
 
+#include "box2d/collision.h"
 #include "box2d/math_functions.h"
 
 static int AABBTest( void )
@@ -31,9 +33,248 @@ static int AABBTest( void )
 	return 0;
 }
 
+#define TREE_PROXY_COUNT 400
+
+typedef struct TreeResults
+{
+	int proxyIds[TREE_PROXY_COUNT];
+	int count;
+} TreeResults;
+
+static bool TreeQueryCallback( int proxyId, int userData, void* context )
+{
+	( (void)userData );
+	TreeResults* results = context;
+	results->proxyIds[results->count++] = proxyId;
+	return true;
+}
+
+static float TreeRayCastCallback( const b2RayCastInput* input, int proxyId, int userData, void* context )
+{
+	( (void)userData );
+	TreeResults* results = context;
+	results->proxyIds[results->count++] = proxyId;
+	return input->maxFraction;
+}
+
+static int CompareProxyIds( TreeResults* a, TreeResults* b )
+{
+	ENSURE( a->count == b->count );
+	for ( int i = 0; i < a->count; ++i )
+	{
+		ENSURE( a->proxyIds[i] == b->proxyIds[i] );
+	}
+
+	return 0;
+}
+
+static void SortProxyIds( TreeResults* results )
+{
+	for ( int i = 1; i < results->count; ++i )
+	{
+		int id = results->proxyIds[i];
+		int j = i;
+		while ( j > 0 && results->proxyIds[j - 1] > id )
+		{
+			results->proxyIds[j] = results->proxyIds[j - 1];
+			j -= 1;
+		}
+		results->proxyIds[j] = id;
+	}
+}
+
+// The wide tree must report the same proxies as the binary tree, and report query results in the same order
+static int CompareTreeTraversals( b2DynamicTree* tree )
+{
+	b2AABB boxes[] = {
+		{ { -5.0f, -5.0f }, { 5.0f, 5.0f } },
+		{ { -100.0f, -100.0f }, { 100.0f, 100.0f } },
+		{ { 12.0f, -3.0f }, { 13.0f, 20.0f } },
+		{ { 50.0f, 50.0f }, { 60.0f, 60.0f } },
+	};
+
+	b2RayCastInput rays[] = {
+		{ { -30.0f, -30.0f }, { 60.0f, 55.0f }, 1.0f },
+		{ { 0.0f, -40.0f }, { 0.0f, 80.0f }, 0.5f },
+		{ { -40.0f, 3.0f }, { 80.0f, 0.0f }, 1.0f },
+	};
+
+	uint64_t maskBits[] = { B2_DEFAULT_MASK_BITS, 0x2 };
+
+	for ( int m = 0; m < 2; ++m )
+	{
+		for ( int i = 0; i < 4; ++i )
+		{
+			TreeResults wideResults = { 0 };
+			TreeResults binaryResults = { 0 };
+
+			ENSURE( tree->wideValid );
+			b2DynamicTree_Query( tree, boxes[i], maskBits[m], TreeQueryCallback, &wideResults );
+
+			tree->wideValid = false;
+			b2DynamicTree_Query( tree, boxes[i], maskBits[m], TreeQueryCallback, &binaryResults );
+			tree->wideValid = true;
+
+			ENSURE( CompareProxyIds( &wideResults, &binaryResults ) == 0 );
+		}
+
+		for ( int i = 0; i < 3; ++i )
+		{
+			TreeResults wideResults = { 0 };
+			TreeResults binaryResults = { 0 };
+
+			b2DynamicTree_RayCast( tree, rays + i, maskBits[m], TreeRayCastCallback, &wideResults );
+
+			tree->wideValid = false;
+			b2DynamicTree_RayCast( tree, rays + i, maskBits[m], TreeRayCastCallback, &binaryResults );
+			tree->wideValid = true;
+
+			SortProxyIds( &wideResults );
+			SortProxyIds( &binaryResults );
+			ENSURE( wideResults.count > 0 || m == 1 );
+			ENSURE( CompareProxyIds( &wideResults, &binaryResults ) == 0 );
+		}
+	}
+
+	return 0;
+}
+
+static int WideTreeTest( void )
+{
+	b2DynamicTree tree = b2DynamicTree_Create();
+
+	int proxyIds[TREE_PROXY_COUNT];
+	uint32_t seed = 12345;
+	for ( int i = 0; i < TREE_PROXY_COUNT; ++i )
+	{
+		seed = 1664525u * seed + 1013904223u;
+		float x = -40.0f + 80.0f * (float)( seed >> 8 ) / (float)( 1 << 24 );
+		seed = 1664525u * seed + 1013904223u;
+		float y = -40.0f + 80.0f * (float)( seed >> 8 ) / (float)( 1 << 24 );
+		float size = 0.25f + 0.125f * ( i % 8 );
+
+		b2AABB box = { { x - size, y - size }, { x + size, y + size } };
+		uint64_t categoryBits = ( i % 3 ) == 0 ? 0x2 : 0x1;
+		proxyIds[i] = b2DynamicTree_CreateProxy( &tree, box, categoryBits, i );
+	}
+
+	ENSURE( tree.wideValid == false );
+
+	b2DynamicTree_Rebuild( &tree, true );
+	b2DynamicTree_Validate( &tree );
+	ENSURE( CompareTreeTraversals( &tree ) == 0 );
+
+	// Enlarging proxies refits the wide tree
+	for ( int i = 0; i < TREE_PROXY_COUNT; i += 7 )
+	{
+		b2AABB box = b2DynamicTree_GetAABB( &tree, proxyIds[i] );
+		box.upperBound = b2Add( box.upperBound, ( b2Vec2 ){ 3.0f, 1.0f } );
+		b2DynamicTree_EnlargeProxy( &tree, proxyIds[i], box );
+	}
+
+	ENSURE( tree.wideValid );
+	b2DynamicTree_Validate( &tree );
+	ENSURE( CompareTreeTraversals( &tree ) == 0 );
+
+	// Moving a proxy changes the structure
+	b2DynamicTree_MoveProxy( &tree, proxyIds[0], ( b2AABB ){ { 1.0f, 1.0f }, { 2.0f, 2.0f } } );
+	ENSURE( tree.wideValid == false );
+
+	b2DynamicTree_Rebuild( &tree, false );
+	ENSURE( CompareTreeTraversals( &tree ) == 0 );
+
+	b2DynamicTree_Destroy( &tree );
+
+	return 0;
+}
+
+// Runs the task items in reversed chunks to mimic workers picking up the work in a different order
+static void* ReversedChunksEnqueueTask( b2TaskCallback* task, int itemCount, int minRange, void* taskContext, void* userContext )
+{
+	int chunkSize = *(int*)userContext;
+	chunkSize = chunkSize > minRange ? chunkSize : minRange;
+
+	int chunkCount = ( itemCount + chunkSize - 1 ) / chunkSize;
+	for ( int i = chunkCount - 1; i >= 0; --i )
+	{
+		int startIndex = i * chunkSize;
+		int endIndex = startIndex + chunkSize < itemCount ? startIndex + chunkSize : itemCount;
+		task( startIndex, endIndex, (uint32_t)i, taskContext );
+	}
+
+	return NULL;
+}
+
+static void FinishTask( void* userTask, void* userContext )
+{
+	( (void)userTask );
+	( (void)userContext );
+}
+
+#define REBUILD_PROXY_COUNT 5000
+
+static void CreateRandomProxies( b2DynamicTree* tree )
+{
+	uint32_t seed = 54321;
+	for ( int i = 0; i < REBUILD_PROXY_COUNT; ++i )
+	{
+		seed = 1664525u * seed + 1013904223u;
+		float x = -200.0f + 400.0f * (float)( seed >> 8 ) / (float)( 1 << 24 );
+		seed = 1664525u * seed + 1013904223u;
+		float y = -50.0f + 100.0f * (float)( seed >> 8 ) / (float)( 1 << 24 );
+		float width = 0.5f + 0.25f * ( i % 5 );
+		float height = 0.5f + 0.5f * ( i % 3 );
+
+		b2AABB box = { { x - width, y - height }, { x + width, y + height } };
+		b2DynamicTree_CreateProxy( tree, box, B2_DEFAULT_CATEGORY_BITS, i );
+	}
+}
+
+static int TreeRebuildTest( void )
+{
+	b2DynamicTree serialTree = b2DynamicTree_Create();
+	CreateRandomProxies( &serialTree );
+
+	float insertedRatio = b2DynamicTree_GetAreaRatio( &serialTree );
+
+	int leafCount = b2DynamicTree_Rebuild( &serialTree, true );
+	ENSURE( leafCount == REBUILD_PROXY_COUNT );
+
+	float serialRatio = b2DynamicTree_GetAreaRatio( &serialTree );
+	int serialHeight = b2DynamicTree_GetHeight( &serialTree );
+
+	// The surface area heuristic should not be worse than incremental insertion
+	ENSURE( serialRatio <= insertedRatio );
+
+	int chunkSizes[] = { 1, 3, 64 };
+	for ( int i = 0; i < 3; ++i )
+	{
+		b2DynamicTree taskTree = b2DynamicTree_Create();
+		CreateRandomProxies( &taskTree );
+
+		leafCount =
+			b2DynamicTree_RebuildWithTasks( &taskTree, true, ReversedChunksEnqueueTask, FinishTask, chunkSizes + i );
+		ENSURE( leafCount == REBUILD_PROXY_COUNT );
+
+		b2DynamicTree_Validate( &taskTree );
+
+		// Same tree regardless of the work distribution
+		ENSURE( b2DynamicTree_GetAreaRatio( &taskTree ) == serialRatio );
+		ENSURE( b2DynamicTree_GetHeight( &taskTree ) == serialHeight );
+
+		b2DynamicTree_Destroy( &taskTree );
+	}
+
+	b2DynamicTree_Destroy( &serialTree );
+
+	return 0;
+}
+
 int CollisionTest( void )
 {
 	RUN_SUBTEST( AABBTest );
+	RUN_SUBTEST( WideTreeTest );
+	RUN_SUBTEST( TreeRebuildTest );
 
 	return 0;
 }
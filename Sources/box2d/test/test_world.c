@@ -1,9 +1,12 @@
 // SPDX-FileCopyrightText: 2023 Erin Catto
 // SPDX-License-Identifier: MIT
 
+#include "broad_phase.h"
 #include "constants.h"
+#include "contact.h"
 #include "core.h"
 #include "test_macros.h"
+#include "world.h"
 
 #include "box2d/box2d.h"
 #include "box2d/collision.h"
@@ -244,6 +247,126 @@ int TestWorldRecycle( void )
 	return 0;
 }
 
+#define RESET_BODY_COUNT 40
+
+// Ground chain, stacked boxes, a joint chain, and a sensor
+static void CreateResetScene( b2WorldId worldId, b2BodyId* bodyIds )
+{
+	b2BodyDef bodyDef = b2DefaultBodyDef();
+	b2BodyId groundId = b2CreateBody( worldId, &bodyDef );
+
+	b2Vec2 points[4] = { { 30.0f, 10.0f }, { 30.0f, 0.0f }, { -30.0f, 0.0f }, { -30.0f, 10.0f } };
+	b2ChainDef chainDef = b2DefaultChainDef();
+	chainDef.points = points;
+	chainDef.count = 4;
+	b2CreateChain( groundId, &chainDef );
+
+	b2ShapeDef shapeDef = b2DefaultShapeDef();
+	shapeDef.isSensor = true;
+	b2Polygon sensorBox = b2MakeOffsetBox( 4.0f, 1.0f, ( b2Vec2 ){ 10.0f, 1.0f }, b2Rot_identity );
+	b2CreatePolygonShape( groundId, &shapeDef, &sensorBox );
+
+	shapeDef = b2DefaultShapeDef();
+	bodyDef.type = b2_dynamicBody;
+	b2Polygon box = b2MakeSquare( 0.5f );
+	for ( int i = 0; i < RESET_BODY_COUNT; ++i )
+	{
+		bodyDef.position = ( b2Vec2 ){ -10.0f + 1.5f * ( i % 10 ), 0.5f + 1.1f * ( i / 10 ) };
+		bodyIds[i] = b2CreateBody( worldId, &bodyDef );
+		b2CreatePolygonShape( bodyIds[i], &shapeDef, &box );
+	}
+
+	b2RevoluteJointDef jointDef = b2DefaultRevoluteJointDef();
+	for ( int i = 1; i < 10; ++i )
+	{
+		jointDef.bodyIdA = bodyIds[i - 1];
+		jointDef.bodyIdB = bodyIds[i];
+		jointDef.localAnchorA = ( b2Vec2 ){ 0.75f, 0.0f };
+		jointDef.localAnchorB = ( b2Vec2 ){ -0.75f, 0.0f };
+		b2CreateRevoluteJoint( worldId, &jointDef );
+	}
+}
+
+static int TestWorldReset( void )
+{
+	b2WorldDef worldDef = b2DefaultWorldDef();
+	b2WorldId resetWorldId = b2CreateWorld( &worldDef );
+
+	b2BodyId freshBodyIds[RESET_BODY_COUNT];
+	b2BodyId resetBodyIds[RESET_BODY_COUNT];
+
+	// Fill the world so that some islands fall asleep, then reset it
+	CreateResetScene( resetWorldId, resetBodyIds );
+	for ( int i = 0; i < 300; ++i )
+	{
+		b2World_Step( resetWorldId, 1.0f / 60.0f, 4 );
+	}
+
+	b2ShapeId oldShapeId;
+	b2Body_GetShapes( resetBodyIds[0], &oldShapeId, 1 );
+	b2JointId oldJointId;
+	b2Body_GetJoints( resetBodyIds[0], &oldJointId, 1 );
+	b2BodyId oldBodyId = resetBodyIds[0];
+
+	b2World_Reset( resetWorldId );
+
+	ENSURE( b2World_IsValid( resetWorldId ) );
+	ENSURE( b2Body_IsValid( oldBodyId ) == false );
+	ENSURE( b2Shape_IsValid( oldShapeId ) == false );
+	ENSURE( b2Joint_IsValid( oldJointId ) == false );
+
+	b2Counters counters = b2World_GetCounters( resetWorldId );
+	ENSURE( counters.bodyCount == 0 );
+	ENSURE( counters.shapeCount == 0 );
+	ENSURE( counters.contactCount == 0 );
+	ENSURE( counters.jointCount == 0 );
+	ENSURE( counters.islandCount == 0 );
+
+	// A reset world simulates exactly like a new world
+	b2WorldId freshWorldId = b2CreateWorld( &worldDef );
+	CreateResetScene( freshWorldId, freshBodyIds );
+	CreateResetScene( resetWorldId, resetBodyIds );
+
+	ENSURE( b2Body_IsValid( oldBodyId ) == false );
+
+	for ( int i = 0; i < 300; ++i )
+	{
+		b2World_Step( freshWorldId, 1.0f / 60.0f, 4 );
+		b2World_Step( resetWorldId, 1.0f / 60.0f, 4 );
+
+		ENSURE( b2World_GetContactEvents( freshWorldId ).beginCount ==
+				b2World_GetContactEvents( resetWorldId ).beginCount );
+		ENSURE( b2World_GetSensorEvents( freshWorldId ).beginCount ==
+				b2World_GetSensorEvents( resetWorldId ).beginCount );
+	}
+
+	for ( int i = 0; i < RESET_BODY_COUNT; ++i )
+	{
+		b2Transform freshTransform = b2Body_GetTransform( freshBodyIds[i] );
+		b2Transform resetTransform = b2Body_GetTransform( resetBodyIds[i] );
+		ENSURE( freshTransform.p.x == resetTransform.p.x && freshTransform.p.y == resetTransform.p.y );
+		ENSURE( freshTransform.q.c == resetTransform.q.c && freshTransform.q.s == resetTransform.q.s );
+	}
+
+	b2DestroyWorld( freshWorldId );
+
+	// Once the id pools have room for all ids, the same scene fits in the kept memory
+	int byteCount = b2GetByteCount();
+
+	b2World_Reset( resetWorldId );
+	CreateResetScene( resetWorldId, resetBodyIds );
+	for ( int i = 0; i < 300; ++i )
+	{
+		b2World_Step( resetWorldId, 1.0f / 60.0f, 4 );
+	}
+
+	ENSURE( b2GetByteCount() == byteCount );
+
+	b2DestroyWorld( resetWorldId );
+
+	return 0;
+}
+
 static bool CustomFilter( b2ShapeId shapeIdA, b2ShapeId shapeIdB, void* context )
 {
 	(void)shapeIdA;
@@ -392,6 +515,277 @@ static int TestSensor( void )
 	return 0;
 }
 
+#define SENSOR_CACHE_BODY_COUNT 20
+
+// Shape ids of the same shape in two worlds
+#define SAME_SHAPE( id1, id2 ) ( id1.index1 == id2.index1 && id1.generation == id2.generation )
+
+static void CreateSensorCacheScene( b2WorldId worldId, b2BodyId* bodyIds, b2BodyId* kinematicId )
+{
+	b2BodyDef bodyDef = b2DefaultBodyDef();
+	b2BodyId groundId = b2CreateBody( worldId, &bodyDef );
+	b2ShapeDef shapeDef = b2DefaultShapeDef();
+	b2Segment segment = { { -40.0f, 0.0f }, { 40.0f, 0.0f } };
+	b2CreateSegmentShape( groundId, &shapeDef, &segment );
+
+	// Static pickup sensors along the ground
+	shapeDef = b2DefaultShapeDef();
+	shapeDef.isSensor = true;
+	for ( int i = 0; i < 10; ++i )
+	{
+		b2Polygon box = b2MakeOffsetBox( 1.0f, 1.0f, ( b2Vec2 ){ -20.0f + 4.0f * i, 1.0f }, b2Rot_identity );
+		b2CreatePolygonShape( groundId, &shapeDef, &box );
+	}
+
+	// Moving sensor
+	bodyDef = b2DefaultBodyDef();
+	bodyDef.type = b2_kinematicBody;
+	bodyDef.position = ( b2Vec2 ){ -30.0f, 2.0f };
+	bodyDef.linearVelocity = ( b2Vec2 ){ 5.0f, 0.0f };
+	*kinematicId = b2CreateBody( worldId, &bodyDef );
+	b2Circle circle = { { 0.0f, 0.0f }, 1.5f };
+	b2CreateCircleShape( *kinematicId, &shapeDef, &circle );
+
+	// Boxes falling on the sensors and going to sleep
+	shapeDef = b2DefaultShapeDef();
+	bodyDef = b2DefaultBodyDef();
+	bodyDef.type = b2_dynamicBody;
+	b2Polygon box = b2MakeSquare( 0.4f );
+	for ( int i = 0; i < SENSOR_CACHE_BODY_COUNT; ++i )
+	{
+		bodyDef.position = ( b2Vec2 ){ -20.0f + 2.0f * i, 3.0f + 0.5f * ( i % 3 ) };
+		bodyIds[i] = b2CreateBody( worldId, &bodyDef );
+		b2CreatePolygonShape( bodyIds[i], &shapeDef, &box );
+	}
+}
+
+static void ChangeSensorCacheScene( b2WorldId worldId, int step, b2BodyId* bodyIds, b2BodyId kinematicId )
+{
+	if ( step == 200 )
+	{
+		b2Body_SetLinearVelocity( kinematicId, b2Vec2_zero );
+	}
+	else if ( step == 250 )
+	{
+		// Destroy sleeping bodies inside sensors
+		b2DestroyBody( bodyIds[0] );
+		b2DestroyBody( bodyIds[6] );
+	}
+	else if ( step == 260 )
+	{
+		// Static shape created inside a sensor
+		b2BodyDef bodyDef = b2DefaultBodyDef();
+		bodyDef.position = ( b2Vec2 ){ -16.0f, 1.0f };
+		b2BodyId staticId = b2CreateBody( worldId, &bodyDef );
+		b2ShapeDef shapeDef = b2DefaultShapeDef();
+		b2Polygon box = b2MakeSquare( 0.25f );
+		b2CreatePolygonShape( staticId, &shapeDef, &box );
+	}
+	else if ( step == 270 )
+	{
+		// Filter of a sleeping shape
+		b2ShapeId shapeId;
+		b2Body_GetShapes( bodyIds[2], &shapeId, 1 );
+		b2Filter filter = b2DefaultFilter();
+		filter.categoryBits = 2;
+		filter.maskBits = ~2ull;
+		b2Shape_SetFilter( shapeId, filter );
+	}
+	else if ( step == 280 )
+	{
+		b2Body_SetTransform( bodyIds[4], ( b2Vec2 ){ 30.0f, 5.0f }, b2Rot_identity );
+	}
+}
+
+// Cached sensor overlaps must produce the same events as querying all sensors every step
+static int TestSensorCache( void )
+{
+	b2WorldDef worldDef = b2DefaultWorldDef();
+	b2WorldId cachedWorldId = b2CreateWorld( &worldDef );
+	b2WorldId queriedWorldId = b2CreateWorld( &worldDef );
+
+	b2BodyId cachedBodyIds[SENSOR_CACHE_BODY_COUNT], queriedBodyIds[SENSOR_CACHE_BODY_COUNT];
+	b2BodyId cachedKinematicId, queriedKinematicId;
+	CreateSensorCacheScene( cachedWorldId, cachedBodyIds, &cachedKinematicId );
+	CreateSensorCacheScene( queriedWorldId, queriedBodyIds, &queriedKinematicId );
+
+	int beginCount = 0;
+	int endCount = 0;
+	for ( int step = 0; step < 400; ++step )
+	{
+		ChangeSensorCacheScene( cachedWorldId, step, cachedBodyIds, cachedKinematicId );
+		ChangeSensorCacheScene( queriedWorldId, step, queriedBodyIds, queriedKinematicId );
+
+		// Invalidate all cached overlaps
+		b2GetWorldFromId( queriedWorldId )->broadPhase.version += 1;
+
+		b2World_Step( cachedWorldId, 1.0f / 60.0f, 4 );
+		b2World_Step( queriedWorldId, 1.0f / 60.0f, 4 );
+
+		b2SensorEvents cached = b2World_GetSensorEvents( cachedWorldId );
+		b2SensorEvents queried = b2World_GetSensorEvents( queriedWorldId );
+
+		ENSURE( cached.beginCount == queried.beginCount );
+		ENSURE( cached.endCount == queried.endCount );
+
+		for ( int i = 0; i < cached.beginCount; ++i )
+		{
+			ENSURE( SAME_SHAPE( cached.beginEvents[i].sensorShapeId, queried.beginEvents[i].sensorShapeId ) );
+			ENSURE( SAME_SHAPE( cached.beginEvents[i].visitorShapeId, queried.beginEvents[i].visitorShapeId ) );
+		}
+
+		for ( int i = 0; i < cached.endCount; ++i )
+		{
+			ENSURE( SAME_SHAPE( cached.endEvents[i].sensorShapeId, queried.endEvents[i].sensorShapeId ) );
+			ENSURE( SAME_SHAPE( cached.endEvents[i].visitorShapeId, queried.endEvents[i].visitorShapeId ) );
+		}
+
+		beginCount += cached.beginCount;
+		endCount += cached.endCount;
+	}
+
+	ENSURE( beginCount > 0 );
+	ENSURE( endCount > 0 );
+
+	b2DestroyWorld( cachedWorldId );
+	b2DestroyWorld( queriedWorldId );
+
+	return 0;
+}
+
+#define GRID_BODY_COUNT 400
+
+static float GridRandom( uint32_t* seed, float lo, float hi )
+{
+	*seed = *seed * 1664525u + 1013904223u;
+	return lo + ( hi - lo ) * (float)( *seed >> 8 ) / (float)( 1u << 24 );
+}
+
+static void CreateGridScene( b2WorldId worldId, b2BodyId* bodyIds )
+{
+	uint32_t seed = 7;
+
+	b2BodyDef bodyDef = b2DefaultBodyDef();
+	b2BodyId groundId = b2CreateBody( worldId, &bodyDef );
+	b2ShapeDef shapeDef = b2DefaultShapeDef();
+	for ( int i = 0; i < 20; ++i )
+	{
+		b2Polygon box = b2MakeOffsetBox( 1.0f, 0.5f, ( b2Vec2 ){ -40.0f + 4.0f * i, 0.0f }, b2Rot_identity );
+		b2CreatePolygonShape( groundId, &shapeDef, &box );
+	}
+
+	for ( int i = 0; i < GRID_BODY_COUNT; ++i )
+	{
+		bodyDef = b2DefaultBodyDef();
+		bodyDef.type = i % 10 == 0 ? b2_kinematicBody : b2_dynamicBody;
+		bodyDef.position = ( b2Vec2 ){ GridRandom( &seed, -40.0f, 40.0f ), GridRandom( &seed, -5.0f, 40.0f ) };
+		bodyIds[i] = b2CreateBody( worldId, &bodyDef );
+
+		shapeDef = b2DefaultShapeDef();
+		if ( i % 17 == 0 )
+		{
+			// Not found by queries
+			shapeDef.filter.categoryBits = 0;
+		}
+		else if ( i % 13 == 0 )
+		{
+			shapeDef.filter.groupIndex = -1;
+		}
+
+		if ( i % 50 == 0 )
+		{
+			// Large shapes go to the large proxy list of the grid
+			b2Polygon box = b2MakeBox( 8.0f, 1.0f );
+			b2CreatePolygonShape( bodyIds[i], &shapeDef, &box );
+		}
+		else
+		{
+			b2Circle circle = { { 0.0f, 0.0f }, GridRandom( &seed, 0.2f, 0.5f ) };
+			b2CreateCircleShape( bodyIds[i], &shapeDef, &circle );
+		}
+	}
+}
+
+// Returns true if both worlds have contacts for the same shape pairs
+static bool HaveSameContacts( b2World* worldA, b2World* worldB )
+{
+	if ( b2GetIdCount( &worldA->contactIdPool ) != b2GetIdCount( &worldB->contactIdPool ) )
+	{
+		return false;
+	}
+
+	for ( int i = 0; i < worldA->contacts.count; ++i )
+	{
+		b2Contact* contact = worldA->contacts.data + i;
+		if ( contact->setIndex == B2_NULL_INDEX )
+		{
+			continue;
+		}
+
+		uint64_t pairKey = B2_SHAPE_PAIR_KEY( contact->shapeIdA, contact->shapeIdB );
+		if ( b2ContainsKey( &worldB->broadPhase.pairSet, pairKey ) == false )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// The grid broad-phase must find the same pairs as the tree
+static int TestGridBroadPhase( void )
+{
+	b2WorldDef worldDef = b2DefaultWorldDef();
+	b2WorldId treeWorldId = b2CreateWorld( &worldDef );
+
+	worldDef.dynamicBroadPhase = b2_gridBroadPhase;
+	worldDef.kinematicBroadPhase = b2_gridBroadPhase;
+	b2WorldId gridWorldId = b2CreateWorld( &worldDef );
+
+	b2BodyId treeBodyIds[GRID_BODY_COUNT], gridBodyIds[GRID_BODY_COUNT];
+	CreateGridScene( treeWorldId, treeBodyIds );
+	CreateGridScene( gridWorldId, gridBodyIds );
+
+	b2World* treeWorld = b2GetWorldFromId( treeWorldId );
+	b2World* gridWorld = b2GetWorldFromId( gridWorldId );
+
+	uint32_t seed = 11;
+	for ( int round = 0; round < 20; ++round )
+	{
+		b2UpdateBroadPhasePairs( treeWorld );
+		b2UpdateBroadPhasePairs( gridWorld );
+
+		ENSURE( b2GetIdCount( &treeWorld->contactIdPool ) > 0 );
+		ENSURE( HaveSameContacts( treeWorld, gridWorld ) );
+		ENSURE( HaveSameContacts( gridWorld, treeWorld ) );
+
+		// Move a part of the bodies, their proxies go to the move buffer
+		for ( int i = round % 3; i < GRID_BODY_COUNT; i += 3 )
+		{
+			if ( B2_IS_NULL( treeBodyIds[i] ) )
+			{
+				continue;
+			}
+
+			b2Vec2 position = { GridRandom( &seed, -40.0f, 40.0f ), GridRandom( &seed, -5.0f, 40.0f ) };
+			b2Rot rotation = b2MakeRot( GridRandom( &seed, -B2_PI, B2_PI ) );
+			b2Body_SetTransform( treeBodyIds[i], position, rotation );
+			b2Body_SetTransform( gridBodyIds[i], position, rotation );
+		}
+
+		int destroyIndex = 7 * round + 3;
+		b2DestroyBody( treeBodyIds[destroyIndex] );
+		b2DestroyBody( gridBodyIds[destroyIndex] );
+		treeBodyIds[destroyIndex] = b2_nullBodyId;
+		gridBodyIds[destroyIndex] = b2_nullBodyId;
+	}
+
+	b2DestroyWorld( treeWorldId );
+	b2DestroyWorld( gridWorldId );
+
+	return 0;
+}
+
 int WorldTest( void )
 {
 	RUN_SUBTEST( HelloWorld );
@@ -399,8 +793,11 @@ int WorldTest( void )
 	RUN_SUBTEST( DestroyAllBodiesWorld );
 	RUN_SUBTEST( TestIsValid );
 	RUN_SUBTEST( TestWorldRecycle );
+	RUN_SUBTEST( TestWorldReset );
 	RUN_SUBTEST( TestWorldCoverage );
 	RUN_SUBTEST( TestSensor );
+	RUN_SUBTEST( TestSensorCache );
+	RUN_SUBTEST( TestGridBroadPhase );
 
 	return 0;
 }
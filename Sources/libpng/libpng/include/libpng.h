@@ -3,6 +3,7 @@
 #endif
 
 #include "png.h"
+#include "swift_png_stream.h"
 
 png_uint_32 swift_png_image_row_stride(png_image image) {
     return PNG_IMAGE_ROW_STRIDE(image);
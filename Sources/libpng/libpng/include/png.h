@@ -3326,7 +3326,11 @@ PNG_EXPORT(245, int, png_image_write_to_memory, (png_imagep image, void *memory,
 #  define PNG_RISCV_RVV   14 /* HARDWARE: RISC-V RVV SIMD instructions supported */
 #endif
 
-#define PNG_OPTION_NEXT  16 /* Next option - numbers must be even */
+/* Set in all builds, so callers don't depend on how libpng was compiled. */
+#define PNG_INTEL_SSE_DISABLE 16 /* SOFTWARE: use C code instead of SSE2 and
+                                  * AVX2, set before the first row is read */
+
+#define PNG_OPTION_NEXT  18 /* Next option - numbers must be even */
 
 /* Return values: NOTE: there are four values and 'off' is *not* zero */
 #define PNG_OPTION_UNSET   0 /* Unset - defaults to off */
@@ -1531,6 +1531,8 @@ PNG_INTERNAL_FUNCTION(void,png_read_filter_row_paeth3_sse2,(png_row_infop
     row_info, png_bytep row, png_const_bytep prev_row),PNG_EMPTY);
 PNG_INTERNAL_FUNCTION(void,png_read_filter_row_paeth4_sse2,(png_row_infop
     row_info, png_bytep row, png_const_bytep prev_row),PNG_EMPTY);
+PNG_INTERNAL_FUNCTION(void,png_read_filter_row_up_avx2,(png_row_infop
+    row_info, png_bytep row, png_const_bytep prev_row),PNG_EMPTY);
 #endif
 
 #if PNG_LOONGARCH_LSX_IMPLEMENTATION == 1
@@ -2210,6 +2212,26 @@ PNG_INTERNAL_FUNCTION(int,
                       PNG_EMPTY);
 #endif
 
+#if PNG_INTEL_SSE_IMPLEMENTATION > 0
+/* Returns non-zero if AVX2 can be used, checked once per png_struct. */
+PNG_INTERNAL_FUNCTION(int, png_intel_have_avx2, (png_structrp), PNG_EMPTY);
+/* Returns zero if PNG_INTEL_SSE_DISABLE is on. */
+PNG_INTERNAL_FUNCTION(int, png_intel_sse_enabled, (png_const_structrp),
+                      PNG_EMPTY);
+PNG_INTERNAL_FUNCTION(void,
+                      png_riffle_palette_sse2,
+                      (png_structrp),
+                      PNG_EMPTY);
+PNG_INTERNAL_FUNCTION(int,
+                      png_do_expand_palette_rgba8_sse2,
+                      (png_structrp,
+                       png_row_infop,
+                       png_const_bytep,
+                       const png_bytepp,
+                       const png_bytepp),
+                      PNG_EMPTY);
+#endif
+
 /* Maintainer: Put new private prototypes here ^ */
 
 #include "pngdebug.h"
@@ -0,0 +1,62 @@
+/* swift_png_stream.h - progressive PNG decoding into caller memory
+ *
+ * This code is released under the libpng license.
+ * For conditions of distribution and use, see the disclaimer
+ * and license in png.h
+ */
+
+#ifndef SWIFT_PNG_STREAM_H
+#define SWIFT_PNG_STREAM_H
+
+#include "png.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A push decoder built on the progressive reader.  Bytes are fed in chunks of
+ * any size as they are read, decoded rows are written as RGBA8 straight into
+ * memory returned by the allocate callback.
+ *
+ * Levels are tightly packed one after another, level n is
+ * max(1, width >> n) by max(1, height >> n) pixels.  Without
+ * SWIFT_PNG_STREAM_MIPMAPS there is a single level.
+ */
+typedef struct swift_png_stream swift_png_stream;
+
+/* Multiply color channels by alpha. */
+#define SWIFT_PNG_STREAM_PREMULTIPLY_ALPHA 0x1U
+/* Generate levels down to 1x1 with a 2x2 box filter. */
+#define SWIFT_PNG_STREAM_MIPMAPS 0x2U
+/* Decode with the generic C code instead of SIMD paths. */
+#define SWIFT_PNG_STREAM_NO_SIMD 0x4U
+
+/* Called once the header is read.  Returns memory of at least size bytes that
+ * is not initialized by the decoder, or NULL to stop decoding.
+ */
+typedef void *(*swift_png_stream_allocate_fn)(void *context,
+    png_uint_32 width, png_uint_32 height, png_uint_32 levels, size_t size);
+
+/* Returns NULL if memory can't be allocated. */
+swift_png_stream *swift_png_stream_create(void *context,
+    swift_png_stream_allocate_fn allocate, unsigned int flags);
+
+/* Decodes the next bytes of the file.  Returns 0 if the data is invalid or
+ * the allocate callback failed, the stream can't be used after that.
+ */
+int swift_png_stream_push(swift_png_stream *stream, const void *bytes,
+    size_t size);
+
+/* Returns 1 once all rows are decoded and the image end is read. */
+int swift_png_stream_is_finished(const swift_png_stream *stream);
+
+/* The message of the error that stopped decoding, empty if there is none. */
+const char *swift_png_stream_error_message(const swift_png_stream *stream);
+
+void swift_png_stream_destroy(swift_png_stream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SWIFT_PNG_STREAM_H */
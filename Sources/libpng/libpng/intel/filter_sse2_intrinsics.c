@@ -0,0 +1,317 @@
+/* filter_sse2_intrinsics.c - SSE2 and AVX2 optimised filter functions
+ *
+ * This code is released under the libpng license.
+ * For conditions of distribution and use, see the disclaimer
+ * and license in png.h
+ */
+
+#include "pngpriv.h"
+
+#ifdef PNG_READ_SUPPORTED
+#if PNG_INTEL_SSE_IMPLEMENTATION > 0
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define PNG_INTEL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define PNG_INTEL_TARGET_AVX2
+#endif
+
+/* Functions in this file look at most 3 pixels (a,b,c) to predict the 4th (d).
+ * They're positioned like this:
+ *    prev:  c b
+ *    row:   a d
+ * The Sub filter predicts d=a, Avg d=(a+b)/2, and Paeth predicts d to be
+ * whichever of a, b, or c is closest to p=a+b-c.
+ *
+ * Rows are not padded, so loads and stores of 3 byte pixels go through memcpy
+ * to avoid touching the bytes past the end of the row.
+ */
+
+static __m128i
+load4(const void *p)
+{
+   int tmp;
+   memcpy(&tmp, p, sizeof(tmp));
+   return _mm_cvtsi32_si128(tmp);
+}
+
+static void
+store4(void *p, __m128i v)
+{
+   int tmp = _mm_cvtsi128_si32(v);
+   memcpy(p, &tmp, sizeof(int));
+}
+
+static __m128i
+load3(const void *p)
+{
+   png_uint_32 tmp = 0;
+   memcpy(&tmp, p, 3);
+   return _mm_cvtsi32_si128((int)tmp);
+}
+
+static void
+store3(void *p, __m128i v)
+{
+   int tmp = _mm_cvtsi128_si32(v);
+   memcpy(p, &tmp, 3);
+}
+
+void
+png_read_filter_row_sub3_sse2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   /* The Sub filter is a running sum of pixels.  Four pixels of a 16 byte
+    * block are summed with two shifted adds, the last pixel of the block is
+    * then replicated and added to the next block.
+    */
+   size_t rb = row_info->rowbytes;
+   const __m128i mask = _mm_cvtsi32_si128(0x00ffffff);
+   __m128i a = _mm_setzero_si128();
+   __m128i x;
+
+   png_debug(1, "in png_read_filter_row_sub3_sse2");
+
+   PNG_UNUSED(prev)
+
+   /* 16 bytes are loaded, but only the first 12 are stored. */
+   while (rb >= 16)
+   {
+      x = _mm_loadu_si128((const __m128i *)row);
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 3));
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 6));
+      x = _mm_add_epi8(x, a);
+
+      _mm_storel_epi64((__m128i *)row, x);
+      store4(row + 8, _mm_srli_si128(x, 8));
+
+      a = _mm_and_si128(_mm_srli_si128(x, 9), mask);
+      a = _mm_or_si128(a, _mm_slli_si128(a, 3));
+      a = _mm_or_si128(a, _mm_slli_si128(a, 6));
+
+      row += 12;
+      rb -= 12;
+   }
+
+   while (rb > 0)
+   {
+      a = _mm_add_epi8(a, load3(row));
+      store3(row, a);
+      row += 3;
+      rb -= 3;
+   }
+}
+
+void
+png_read_filter_row_sub4_sse2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   /* Same running sum as for 3 byte pixels, a block holds exactly four
+    * pixels.
+    */
+   size_t rb = row_info->rowbytes;
+   __m128i a = _mm_setzero_si128();
+   __m128i x;
+
+   png_debug(1, "in png_read_filter_row_sub4_sse2");
+
+   PNG_UNUSED(prev)
+
+   while (rb >= 16)
+   {
+      x = _mm_loadu_si128((const __m128i *)row);
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+      x = _mm_add_epi8(x, a);
+      _mm_storeu_si128((__m128i *)row, x);
+
+      a = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+      row += 16;
+      rb -= 16;
+   }
+
+   while (rb > 0)
+   {
+      a = _mm_add_epi8(a, load4(row));
+      store4(row, a);
+      row += 4;
+      rb -= 4;
+   }
+}
+
+/* The average of a and b rounded down; _mm_avg_epu8 rounds up. */
+static __m128i
+avg_floor(__m128i a, __m128i b)
+{
+   __m128i avg = _mm_avg_epu8(a, b);
+   return _mm_sub_epi8(avg,
+       _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+}
+
+void
+png_read_filter_row_avg3_sse2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   size_t rb = row_info->rowbytes;
+   __m128i a = _mm_setzero_si128();
+   __m128i b;
+
+   png_debug(1, "in png_read_filter_row_avg3_sse2");
+
+   while (rb > 0)
+   {
+      b = load3(prev);
+      a = _mm_add_epi8(avg_floor(a, b), load3(row));
+      store3(row, a);
+
+      prev += 3;
+      row += 3;
+      rb -= 3;
+   }
+}
+
+void
+png_read_filter_row_avg4_sse2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   size_t rb = row_info->rowbytes;
+   __m128i a = _mm_setzero_si128();
+   __m128i b;
+
+   png_debug(1, "in png_read_filter_row_avg4_sse2");
+
+   while (rb > 0)
+   {
+      b = load4(prev);
+      a = _mm_add_epi8(avg_floor(a, b), load4(row));
+      store4(row, a);
+
+      prev += 4;
+      row += 4;
+      rb -= 4;
+   }
+}
+
+/* SSE2 has no 16-bit absolute value or blend, SSSE3 and SSE4.1 do. */
+static __m128i
+abs_i16(__m128i x)
+{
+   return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+static __m128i
+if_then_else(__m128i c, __m128i t, __m128i e)
+{
+   return _mm_or_si128(_mm_and_si128(c, t), _mm_andnot_si128(c, e));
+}
+
+/* Paeth prediction of a pixel, a, b and c are unpacked to 16-bit lanes. */
+static __m128i
+paeth_predict(__m128i a, __m128i b, __m128i c)
+{
+   __m128i pa, pb, pc, smallest, nearest;
+
+   /* |p-a| = |b-c|, |p-b| = |a-c|, |p-c| = |(b-c) + (a-c)| */
+   pa = _mm_sub_epi16(b, c);
+   pb = _mm_sub_epi16(a, c);
+   pc = _mm_add_epi16(pa, pb);
+
+   pa = abs_i16(pa);
+   pb = abs_i16(pb);
+   pc = abs_i16(pc);
+
+   smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+
+   /* Ties are broken in favor of a, then b. */
+   nearest = if_then_else(_mm_cmpeq_epi16(smallest, pa), a,
+       if_then_else(_mm_cmpeq_epi16(smallest, pb), b, c));
+
+   return _mm_packus_epi16(nearest, nearest);
+}
+
+void
+png_read_filter_row_paeth3_sse2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   size_t rb = row_info->rowbytes;
+   const __m128i zero = _mm_setzero_si128();
+   __m128i a = zero, c = zero;
+   __m128i b, d;
+
+   png_debug(1, "in png_read_filter_row_paeth3_sse2");
+
+   while (rb > 0)
+   {
+      b = _mm_unpacklo_epi8(load3(prev), zero);
+      d = _mm_add_epi8(paeth_predict(a, b, c), load3(row));
+      store3(row, d);
+
+      a = _mm_unpacklo_epi8(d, zero);
+      c = b;
+
+      prev += 3;
+      row += 3;
+      rb -= 3;
+   }
+}
+
+void
+png_read_filter_row_paeth4_sse2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   size_t rb = row_info->rowbytes;
+   const __m128i zero = _mm_setzero_si128();
+   __m128i a = zero, c = zero;
+   __m128i b, d;
+
+   png_debug(1, "in png_read_filter_row_paeth4_sse2");
+
+   while (rb > 0)
+   {
+      b = _mm_unpacklo_epi8(load4(prev), zero);
+      d = _mm_add_epi8(paeth_predict(a, b, c), load4(row));
+      store4(row, d);
+
+      a = _mm_unpacklo_epi8(d, zero);
+      c = b;
+
+      prev += 4;
+      row += 4;
+      rb -= 4;
+   }
+}
+
+/* Selected by png_init_filter_functions_sse2 only if the CPU supports AVX2. */
+PNG_INTEL_TARGET_AVX2 void
+png_read_filter_row_up_avx2(png_row_infop row_info, png_bytep row,
+    png_const_bytep prev)
+{
+   size_t rb = row_info->rowbytes;
+   __m256i x;
+
+   png_debug(1, "in png_read_filter_row_up_avx2");
+
+   while (rb >= 32)
+   {
+      x = _mm256_loadu_si256((const __m256i *)row);
+      x = _mm256_add_epi8(x, _mm256_loadu_si256((const __m256i *)prev));
+      _mm256_storeu_si256((__m256i *)row, x);
+
+      prev += 32;
+      row += 32;
+      rb -= 32;
+   }
+
+   while (rb > 0)
+   {
+      *row = (png_byte)(*row + *prev);
+      prev++;
+      row++;
+      rb--;
+   }
+}
+
+#endif /* PNG_INTEL_SSE_IMPLEMENTATION > 0 */
+#endif /* PNG_READ_SUPPORTED */
@@ -0,0 +1,124 @@
+/* intel_init.c - SSE2 and AVX2 optimised filter functions
+ *
+ * This code is released under the libpng license.
+ * For conditions of distribution and use, see the disclaimer
+ * and license in png.h
+ */
+
+#include "pngpriv.h"
+
+#ifdef PNG_READ_SUPPORTED
+#if PNG_INTEL_SSE_IMPLEMENTATION > 0
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#else
+#  include <cpuid.h>
+#endif
+
+/* SSE2 is part of x86-64, so only the AVX2 paths are selected at run time.
+ * AVX2 requires both the CPU flag and the operating system saving the YMM
+ * registers on context switches.
+ */
+static int
+png_intel_detect_avx2(void)
+{
+   unsigned int ebx, ecx;
+   unsigned long long xcr0;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+   int info[4];
+
+   __cpuid(info, 0);
+   if (info[0] < 7)
+      return 0;
+
+   __cpuid(info, 1);
+   ecx = (unsigned int)info[2];
+   if ((ecx & (1U << 27)) == 0 || (ecx & (1U << 28)) == 0) /* OSXSAVE, AVX */
+      return 0;
+
+   xcr0 = _xgetbv(0);
+   __cpuidex(info, 7, 0);
+   ebx = (unsigned int)info[1];
+#else
+   unsigned int eax, edx;
+
+   if (__get_cpuid_max(0, NULL) < 7)
+      return 0;
+
+   if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+      return 0;
+   if ((ecx & (1U << 27)) == 0 || (ecx & (1U << 28)) == 0) /* OSXSAVE, AVX */
+      return 0;
+
+   __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+   xcr0 = ((unsigned long long)edx << 32) | eax;
+   __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#endif
+
+   if ((xcr0 & 0x6) != 0x6) /* XMM and YMM state */
+      return 0;
+
+   return (ebx & (1U << 5)) != 0; /* AVX2 */
+}
+
+int
+png_intel_have_avx2(png_structrp png_ptr)
+{
+   /* The result is kept in png_struct rather than in a static variable, like
+    * the rest of the reader state it is only accessed by one thread at a time.
+    */
+   if (png_ptr->intel_avx2 == 0)
+      png_ptr->intel_avx2 = (png_byte)(png_intel_detect_avx2() != 0 ? 2 : 1);
+
+   return png_ptr->intel_avx2 == 2;
+}
+
+int
+png_intel_sse_enabled(png_const_structrp png_ptr)
+{
+#ifdef PNG_SET_OPTION_SUPPORTED
+   if (((png_ptr->options >> PNG_INTEL_SSE_DISABLE) & 3) == PNG_OPTION_ON)
+      return 0;
+#else
+   PNG_UNUSED(png_ptr)
+#endif
+
+   return 1;
+}
+
+void
+png_init_filter_functions_sse2(png_structp pp, unsigned int bpp)
+{
+   /* Sub, Avg and Paeth depend on the previous pixel, so the SSE2 versions
+    * process a whole 3 or 4 byte pixel per step instead of a byte.  Up has no
+    * such dependency; the generic C code auto-vectorizes to SSE2, so only the
+    * wider AVX2 version replaces it.
+    */
+   png_debug(1, "in png_init_filter_functions_sse2");
+
+   if (png_intel_sse_enabled(pp) == 0)
+      return;
+
+   if (bpp == 3)
+   {
+      pp->read_filter[PNG_FILTER_VALUE_SUB-1] = png_read_filter_row_sub3_sse2;
+      pp->read_filter[PNG_FILTER_VALUE_AVG-1] = png_read_filter_row_avg3_sse2;
+      pp->read_filter[PNG_FILTER_VALUE_PAETH-1] =
+         png_read_filter_row_paeth3_sse2;
+   }
+   else if (bpp == 4)
+   {
+      pp->read_filter[PNG_FILTER_VALUE_SUB-1] = png_read_filter_row_sub4_sse2;
+      pp->read_filter[PNG_FILTER_VALUE_AVG-1] = png_read_filter_row_avg4_sse2;
+      pp->read_filter[PNG_FILTER_VALUE_PAETH-1] =
+         png_read_filter_row_paeth4_sse2;
+   }
+
+   if (png_intel_have_avx2(pp) != 0)
+      pp->read_filter[PNG_FILTER_VALUE_UP-1] = png_read_filter_row_up_avx2;
+}
+
+#endif /* PNG_INTEL_SSE_IMPLEMENTATION > 0 */
+#endif /* PNG_READ_SUPPORTED */
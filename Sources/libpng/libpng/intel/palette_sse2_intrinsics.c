@@ -0,0 +1,117 @@
+/* palette_sse2_intrinsics.c - SSE2 and AVX2 optimised palette expansion
+ *
+ * This code is released under the libpng license.
+ * For conditions of distribution and use, see the disclaimer
+ * and license in png.h
+ */
+
+#include "pngpriv.h"
+
+#ifdef PNG_READ_SUPPORTED
+#if PNG_INTEL_SSE_IMPLEMENTATION > 0
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define PNG_INTEL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define PNG_INTEL_TARGET_AVX2
+#endif
+
+/* Build an RGBA8 palette from the separate RGB and alpha palettes. */
+void
+png_riffle_palette_sse2(png_structrp png_ptr)
+{
+   png_const_colorp palette = png_ptr->palette;
+   png_bytep riffled_palette = png_ptr->riffled_palette;
+   png_const_bytep trans_alpha = png_ptr->trans_alpha;
+   int num_trans = png_ptr->num_trans;
+   int i;
+
+   png_debug(1, "in png_riffle_palette_sse2");
+
+   /* The palette always holds PNG_MAX_PALETTE_LENGTH entries, unused entries
+    * are black like in the generic code.
+    */
+   for (i = 0; i < 256; i++)
+   {
+      riffled_palette[(i << 2) + 0] = palette[i].red;
+      riffled_palette[(i << 2) + 1] = palette[i].green;
+      riffled_palette[(i << 2) + 2] = palette[i].blue;
+      riffled_palette[(i << 2) + 3] = i < num_trans ? trans_alpha[i] : 0xff;
+   }
+}
+
+static png_uint_32
+riffled_color(png_const_bytep riffled_palette, png_byte index)
+{
+   png_uint_32 color;
+   memcpy(&color, riffled_palette + ((size_t)index << 2), sizeof(color));
+   return color;
+}
+
+/* Expands 8 pixels per step with one gather from the riffled palette. */
+PNG_INTEL_TARGET_AVX2 static png_uint_32
+png_do_expand_palette_rgba8_avx2(png_const_bytep riffled_palette,
+    png_uint_32 row_width, png_const_bytep sp, png_bytep dp)
+{
+   const png_uint_32 pixels_per_chunk = 8;
+   png_uint_32 i;
+
+   for (i = 0; i + pixels_per_chunk <= row_width; i += pixels_per_chunk)
+   {
+      __m128i indices = _mm_loadl_epi64(
+          (const __m128i *)(sp - i - (pixels_per_chunk - 1)));
+      __m256i colors = _mm256_i32gather_epi32((const int *)riffled_palette,
+          _mm256_cvtepu8_epi32(indices), 4);
+
+      _mm256_storeu_si256(
+          (__m256i *)(dp - ((i + pixels_per_chunk) << 2) + 1), colors);
+   }
+
+   return i;
+}
+
+/* Expands a palettized row into RGBA8.
+ *
+ * Like the generic code, pixels are expanded in place from the end of the row,
+ * so a chunk of source indices is loaded before its colors overwrite them.
+ */
+int
+png_do_expand_palette_rgba8_sse2(png_structrp png_ptr, png_row_infop row_info,
+    png_const_bytep row, png_bytepp ssp, png_bytepp ddp)
+{
+   png_uint_32 row_width = row_info->width;
+   png_const_bytep riffled_palette = png_ptr->riffled_palette;
+   const png_uint_32 pixels_per_chunk = 4;
+   png_bytep sp = *ssp, dp = *ddp;
+   png_uint_32 i = 0;
+
+   png_debug(1, "in png_do_expand_palette_rgba8_sse2");
+
+   PNG_UNUSED(row)
+
+   if (png_intel_have_avx2(png_ptr) != 0)
+      i = png_do_expand_palette_rgba8_avx2(riffled_palette, row_width, sp, dp);
+
+   for (; i + pixels_per_chunk <= row_width; i += pixels_per_chunk)
+   {
+      png_const_bytep s = sp - i;
+      __m128i colors = _mm_set_epi32(
+          (int)riffled_color(riffled_palette, s[0]),
+          (int)riffled_color(riffled_palette, s[-1]),
+          (int)riffled_color(riffled_palette, s[-2]),
+          (int)riffled_color(riffled_palette, s[-3]));
+
+      _mm_storeu_si128(
+          (__m128i *)(dp - ((i + pixels_per_chunk) << 2) + 1), colors);
+   }
+
+   /* The remaining pixels are expanded by the generic code. */
+   *ssp = sp - i;
+   *ddp = dp - (i << 2);
+   return (int)i;
+}
+
+#endif /* PNG_INTEL_SSE_IMPLEMENTATION > 0 */
+#endif /* PNG_READ_SUPPORTED */
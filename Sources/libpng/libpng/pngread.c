@@ -810,7 +810,8 @@ png_read_destroy(png_structrp png_ptr)
 
 #if defined(PNG_READ_EXPAND_SUPPORTED) && \
     (defined(PNG_ARM_NEON_IMPLEMENTATION) || \
-     defined(PNG_RISCV_RVV_IMPLEMENTATION))
+     defined(PNG_RISCV_RVV_IMPLEMENTATION) || \
+     defined(PNG_INTEL_SSE_IMPLEMENTATION))
    png_free(png_ptr, png_ptr->riffled_palette);
    png_ptr->riffled_palette = NULL;
 #endif
@@ -4403,6 +4403,15 @@ png_do_expand_palette(png_structrp png_ptr, png_row_infop row_info,
                   i = png_do_expand_palette_rgba8_neon(png_ptr, row_info, row,
                       &sp, &dp);
                }
+#elif PNG_INTEL_SSE_IMPLEMENTATION > 0
+               if (png_ptr->riffled_palette != NULL)
+               {
+                  /* Same as for NEON, the palette is riffled only if the
+                   * image bit depth is 8.
+                   */
+                  i = png_do_expand_palette_rgba8_sse2(png_ptr, row_info, row,
+                      &sp, &dp);
+               }
 #else
                PNG_UNUSED(png_ptr)
 #endif
@@ -4862,6 +4871,18 @@ png_do_read_transformations(png_structrp png_ptr, png_row_infop row_info)
                png_riffle_palette_neon(png_ptr);
             }
          }
+#elif PNG_INTEL_SSE_IMPLEMENTATION > 0
+         if ((png_ptr->num_trans > 0) && (png_ptr->bit_depth == 8) &&
+             png_intel_sse_enabled(png_ptr) != 0)
+         {
+            if (png_ptr->riffled_palette == NULL)
+            {
+               /* Initialize the accelerated palette expansion. */
+               png_ptr->riffled_palette =
+                   (png_bytep)png_malloc(png_ptr, 256 * 4);
+               png_riffle_palette_sse2(png_ptr);
+            }
+         }
 #endif
          png_do_expand_palette(png_ptr, row_info, png_ptr->row_buf + 1,
              png_ptr->palette, png_ptr->trans_alpha, png_ptr->num_trans);
@@ -0,0 +1,313 @@
+/* swift_png_stream.c - progressive PNG decoding into caller memory
+ *
+ * This code is released under the libpng license.
+ * For conditions of distribution and use, see the disclaimer
+ * and license in png.h
+ */
+
+#include "swift_png_stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SWIFT_PNG_STREAM_MAX_LEVELS 32
+
+struct swift_png_stream
+{
+   png_structp png_ptr;
+   png_infop info_ptr;
+
+   void *context;
+   swift_png_stream_allocate_fn allocate;
+   unsigned int flags;
+
+   png_bytep pixels;
+   png_uint_32 width;
+   png_uint_32 height;
+   png_uint_32 levels;
+   size_t offsets[SWIFT_PNG_STREAM_MAX_LEVELS];
+
+   int interlaced;
+   int finished;
+   int failed;
+   char message[128];
+};
+
+static png_uint_32
+level_extent(png_uint_32 extent, png_uint_32 level)
+{
+   extent >>= level;
+   return extent > 0 ? extent : 1;
+}
+
+static png_bytep
+level_row(swift_png_stream *stream, png_uint_32 level, png_uint_32 y)
+{
+   return stream->pixels + stream->offsets[level] +
+       (size_t)y * level_extent(stream->width, level) * 4;
+}
+
+/* Rounds to nearest, c * a / 255 is exact for a of 0 and 255. */
+static void
+premultiply_row(png_bytep row, png_uint_32 width)
+{
+   png_uint_32 x;
+
+   for (x = 0; x < width; x++, row += 4)
+   {
+      unsigned int a = row[3], c, t;
+
+      if (a == 255)
+         continue;
+
+      for (c = 0; c < 3; c++)
+      {
+         t = row[c] * a + 128;
+         row[c] = (png_byte)((t + (t >> 8)) >> 8);
+      }
+   }
+}
+
+/* Called when row y of a level is final.  Row r of the next level averages
+ * rows 2r and 2r+1 and is written once both are final; the last row and
+ * column of an odd extent are clamped, so 1 pixel wide levels still reduce.
+ */
+static void
+reduce_row(swift_png_stream *stream, png_uint_32 level, png_uint_32 y)
+{
+   while (level + 1 < stream->levels)
+   {
+      png_uint_32 width = level_extent(stream->width, level);
+      png_uint_32 height = level_extent(stream->height, level);
+      png_uint_32 next_width = level_extent(stream->width, level + 1);
+      png_uint_32 next_height = level_extent(stream->height, level + 1);
+      png_uint_32 r = y >> 1, x;
+      png_const_bytep top, bottom;
+      png_bytep dp;
+
+      if (r >= next_height || y != (2 * r + 1 < height ? 2 * r + 1 : height - 1))
+         return;
+
+      top = level_row(stream, level, 2 * r);
+      bottom = level_row(stream, level, y);
+      dp = level_row(stream, level + 1, r);
+
+      for (x = 0; x < next_width; x++, dp += 4)
+      {
+         size_t x0 = (size_t)(2 * x) * 4;
+         size_t x1 = (size_t)(2 * x + 1 < width ? 2 * x + 1 : width - 1) * 4;
+         unsigned int c;
+
+         for (c = 0; c < 4; c++)
+            dp[c] = (png_byte)((top[x0 + c] + top[x1 + c] +
+                bottom[x0 + c] + bottom[x1 + c] + 2) >> 2);
+      }
+
+      level++;
+      y = r;
+   }
+}
+
+static void
+finish_row(swift_png_stream *stream, png_uint_32 y)
+{
+   if ((stream->flags & SWIFT_PNG_STREAM_PREMULTIPLY_ALPHA) != 0)
+      premultiply_row(level_row(stream, 0, y), stream->width);
+
+   reduce_row(stream, 0, y);
+}
+
+static void PNGCBAPI
+stream_error(png_structp png_ptr, png_const_charp message)
+{
+   swift_png_stream *stream = (swift_png_stream *)png_get_error_ptr(png_ptr);
+
+   strncpy(stream->message, message, sizeof stream->message - 1);
+   png_longjmp(png_ptr, 1);
+}
+
+static void PNGCBAPI
+stream_warning(png_structp png_ptr, png_const_charp message)
+{
+   (void)png_ptr;
+   (void)message;
+}
+
+/* Sets up transformations to RGBA8 like the simplified API does for
+ * PNG_FORMAT_RGBA, then asks for the destination memory.
+ */
+static void PNGCBAPI
+stream_info(png_structp png_ptr, png_infop info_ptr)
+{
+   swift_png_stream *stream =
+       (swift_png_stream *)png_get_progressive_ptr(png_ptr);
+   png_uint_32 width = png_get_image_width(png_ptr, info_ptr);
+   png_uint_32 height = png_get_image_height(png_ptr, info_ptr);
+   png_uint_32 levels = 1, level;
+   size_t size = 0;
+
+   /* Without gamma information the simplified API assumes 16-bit images are
+    * linear, the first call only sets that default.
+    */
+   if (png_get_bit_depth(png_ptr, info_ptr) == 16)
+      png_set_alpha_mode_fixed(png_ptr, PNG_ALPHA_PNG, PNG_GAMMA_LINEAR);
+   png_set_alpha_mode(png_ptr, PNG_ALPHA_PNG, PNG_DEFAULT_sRGB);
+   png_set_expand(png_ptr);
+   png_set_scale_16(png_ptr);
+   png_set_gray_to_rgb(png_ptr);
+   png_set_add_alpha(png_ptr, 0xff, PNG_FILLER_AFTER);
+   stream->interlaced = png_set_interlace_handling(png_ptr) > 1;
+   png_read_update_info(png_ptr, info_ptr);
+
+   if (png_get_rowbytes(png_ptr, info_ptr) != (size_t)width * 4)
+      png_error(png_ptr, "unexpected row size after transformations");
+
+   if ((stream->flags & SWIFT_PNG_STREAM_MIPMAPS) != 0)
+   {
+      png_uint_32 extent = width > height ? width : height;
+
+      while ((extent >>= 1) > 0)
+         levels++;
+   }
+
+   for (level = 0; level < levels; level++)
+   {
+      size_t pixels = (size_t)level_extent(width, level) *
+          level_extent(height, level);
+
+      if (pixels > (PNG_SIZE_MAX - size) / 4)
+         png_error(png_ptr, "image is too large");
+
+      stream->offsets[level] = size;
+      size += pixels * 4;
+   }
+
+   stream->width = width;
+   stream->height = height;
+   stream->levels = levels;
+   stream->pixels = (png_bytep)stream->allocate(stream->context, width,
+       height, levels, size);
+
+   if (stream->pixels == NULL)
+      png_error(png_ptr, "no memory for decoded pixels");
+}
+
+/* Rows of an interlaced image change until the last pass, so they are
+ * finished in stream_end.
+ */
+static void PNGCBAPI
+stream_row(png_structp png_ptr, png_bytep new_row, png_uint_32 row_num,
+    int pass)
+{
+   swift_png_stream *stream =
+       (swift_png_stream *)png_get_progressive_ptr(png_ptr);
+
+   (void)pass;
+
+   if (new_row == NULL || row_num >= stream->height)
+      return;
+
+   png_progressive_combine_row(png_ptr, level_row(stream, 0, row_num),
+       new_row);
+
+   if (stream->interlaced == 0)
+      finish_row(stream, row_num);
+}
+
+static void PNGCBAPI
+stream_end(png_structp png_ptr, png_infop info_ptr)
+{
+   swift_png_stream *stream =
+       (swift_png_stream *)png_get_progressive_ptr(png_ptr);
+   png_uint_32 y;
+
+   (void)info_ptr;
+
+   if (stream->interlaced != 0)
+      for (y = 0; y < stream->height; y++)
+         finish_row(stream, y);
+
+   stream->finished = 1;
+}
+
+swift_png_stream *
+swift_png_stream_create(void *context, swift_png_stream_allocate_fn allocate,
+    unsigned int flags)
+{
+   swift_png_stream *stream;
+
+   if (allocate == NULL)
+      return NULL;
+
+   stream = (swift_png_stream *)calloc(1, sizeof *stream);
+   if (stream == NULL)
+      return NULL;
+
+   stream->context = context;
+   stream->allocate = allocate;
+   stream->flags = flags;
+
+   stream->png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, stream,
+       stream_error, stream_warning);
+   if (stream->png_ptr != NULL)
+      stream->info_ptr = png_create_info_struct(stream->png_ptr);
+
+   if (stream->info_ptr == NULL)
+   {
+      swift_png_stream_destroy(stream);
+      return NULL;
+   }
+
+#ifdef PNG_SET_OPTION_SUPPORTED
+   if ((flags & SWIFT_PNG_STREAM_NO_SIMD) != 0)
+      png_set_option(stream->png_ptr, PNG_INTEL_SSE_DISABLE, PNG_OPTION_ON);
+#endif
+
+   png_set_progressive_read_fn(stream->png_ptr, stream, stream_info,
+       stream_row, stream_end);
+   return stream;
+}
+
+int
+swift_png_stream_push(swift_png_stream *stream, const void *bytes,
+    size_t size)
+{
+   if (stream->failed != 0)
+      return 0;
+
+   /* Bytes after the image end are ignored. */
+   if (stream->finished != 0 || size == 0)
+      return 1;
+
+   if (setjmp(png_jmpbuf(stream->png_ptr)))
+   {
+      stream->failed = 1;
+      return 0;
+   }
+
+   png_process_data(stream->png_ptr, stream->info_ptr,
+       (png_bytep)bytes, size);
+   return 1;
+}
+
+int
+swift_png_stream_is_finished(const swift_png_stream *stream)
+{
+   return stream->finished;
+}
+
+const char *
+swift_png_stream_error_message(const swift_png_stream *stream)
+{
+   return stream->message;
+}
+
+void
+swift_png_stream_destroy(swift_png_stream *stream)
+{
+   if (stream == NULL)
+      return;
+
+   png_destroy_read_struct(&stream->png_ptr, &stream->info_ptr, NULL);
+   free(stream);
+}
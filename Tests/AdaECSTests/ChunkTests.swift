@@ -212,6 +212,67 @@ struct ChunksTests {
         #expect(chunks.chunks[1].entities.count == 32)
         #expect(chunks.chunks[2].entities.count == 0)
     }
+
+    @Test
+    mutating func `moved out entities free their chunk`() throws {
+        (0..<64).forEach { index in
+            chunks.insertEntity(index, components: [A(), B()], tick: Tick(value: 0))
+        }
+
+        var newChunks = Chunks(
+            entitiesPerChunk: 32,
+            componentLayout: ComponentLayout(componentTypes: [A.self])
+        )
+        _ = chunks.moveEntity(5, to: &newChunks)
+
+        #expect(chunks.getFreeChunkIndex() == 0)
+        #expect(chunks.count == 2)
+
+        chunks.insertEntity(64, components: [A(), B()], tick: Tick(value: 0))
+        #expect(chunks.chunks[0].count == 32)
+        #expect(chunks.getFreeChunkIndex() == 2)
+    }
+
+    @Test
+    mutating func `remove entity updates location of swapped entity`() throws {
+        let a = A()
+        chunks.insertEntity(1, components: [A(), B()], tick: Tick(value: 0))
+        chunks.insertEntity(2, components: [a, B()], tick: Tick(value: 0))
+
+        let result = chunks.removeEntity(1)
+        #expect(result?.swappedEntity == 2)
+        #expect(chunks.entities[1] == nil)
+        #expect(chunks.entities[2]?.entityRow == 0)
+
+        var newChunks = Chunks(
+            entitiesPerChunk: 32,
+            componentLayout: ComponentLayout(componentTypes: [A.self])
+        )
+        let moveResult = chunks.moveEntity(2, to: &newChunks)
+        #expect(newChunks.chunks[moveResult.newLocation.chunkIndex].get(A.self, for: 2) == a)
+    }
+
+    @Test
+    func `move entity deinitializes dropped components`() throws {
+        let deinitCounter = DeinitCounter()
+        var sourceChunks = Chunks(
+            entitiesPerChunk: 32,
+            componentLayout: ComponentLayout(componentTypes: [TrackableComponent.self, A.self])
+        )
+        sourceChunks.insertEntity(
+            1,
+            components: [TrackableComponent(id: "Dropped", counter: deinitCounter), A()],
+            tick: Tick(value: 0)
+        )
+
+        var destChunks = Chunks(
+            entitiesPerChunk: 32,
+            componentLayout: ComponentLayout(componentTypes: [A.self])
+        )
+        _ = sourceChunks.moveEntity(1, to: &destChunks)
+
+        #expect(deinitCounter.deinitializedIds == ["Dropped"])
+    }
 }
 
 @Suite("Chunk Tests")
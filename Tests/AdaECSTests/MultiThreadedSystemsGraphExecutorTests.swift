@@ -5,6 +5,7 @@
 
 import AdaECS
 import Foundation
+import Synchronization
 import Testing
 
 @Suite("MultiThreaded systems graph executor")
@@ -70,6 +71,36 @@ struct MultiThreadedSystemsGraphExecutorTests {
         #expect(multiThreadedLog == singleThreadedLog)
     }
 
+    @Test("dependent systems start without waiting unrelated systems")
+    func dependentSystemsStartWithoutWaitingUnrelatedSystems() async throws {
+        let world = World()
+        world.addScheduler(Scheduler(name: .multiThreadedStartTest, graphExecutor: MultiThreadedSystemsGraphExecutor()))
+        world.addSystem(SlowUnrelatedSystem.self, on: .multiThreadedStartTest)
+        world.addSystem(FirstChainedSystem.self, on: .multiThreadedStartTest)
+        world.addSystem(SecondChainedSystem.self, on: .multiThreadedStartTest)
+
+        SecondChainedSystem.didRun.reset()
+        SlowUnrelatedSystem.sawSecondChainedSystem.store(false, ordering: .relaxed)
+        await world.runScheduler(.multiThreadedStartTest)
+
+        #expect(SlowUnrelatedSystem.sawSecondChainedSystem.load(ordering: .relaxed))
+    }
+
+    @Test("each of 343 independent systems runs once per frame")
+    func manyIndependentSystemsRunOncePerFrame() async {
+        let world = World()
+        world.addScheduler(Scheduler(name: .multiThreadedDispatchTest, graphExecutor: MultiThreadedSystemsGraphExecutor()))
+        addDispatchSystems(to: world)
+
+        let frameCount = 20
+        DispatchDigit0.runCount.store(0, ordering: .relaxed)
+        for _ in 0..<frameCount {
+            await world.runScheduler(.multiThreadedDispatchTest)
+        }
+
+        #expect(DispatchDigit0.runCount.load(ordering: .relaxed) == frameCount * 343)
+    }
+
     private func runOrderTest(with executor: any SystemsGraphExecutor) async throws -> [String] {
         let world = World()
         world.addScheduler(Scheduler(name: .multiThreadedOrderTest, graphExecutor: executor))
@@ -169,7 +200,148 @@ struct SecondConflictingOrderSystem {
     }
 }
 
+@PlainSystem
+struct SlowUnrelatedSystem {
+    static let sawSecondChainedSystem = Atomic<Bool>(false)
+
+    init(world: World) {}
+
+    func update(context: UpdateContext) async {
+        // The chained systems must start while this system is still running.
+        let didRun = await SecondChainedSystem.didRun.wait(timeout: .seconds(5))
+        Self.sawSecondChainedSystem.store(didRun, ordering: .relaxed)
+    }
+}
+
+@PlainSystem
+struct FirstChainedSystem {
+    init(world: World) {}
+
+    func update(context: UpdateContext) { }
+}
+
+@PlainSystem(dependencies: [
+    .after(FirstChainedSystem.self)
+])
+struct SecondChainedSystem {
+    static let didRun = OneShotSignal()
+
+    init(world: World) {}
+
+    func update(context: UpdateContext) {
+        Self.didRun.send()
+    }
+}
+
+/// A signal sent once, which resumes a single waiter.
+final class OneShotSignal: Sendable {
+    private struct State {
+        var isSent = false
+        var waiter: CheckedContinuation<Bool, Never>?
+    }
+
+    private let state = Mutex(State())
+
+    func reset() {
+        state.withLock { $0 = State() }
+    }
+
+    func send() {
+        let waiter = state.withLock { state in
+            state.isSent = true
+            defer { state.waiter = nil }
+            return state.waiter
+        }
+        waiter?.resume(returning: true)
+    }
+
+    /// Returns true once the signal is sent, or false if it isn't sent before the timeout.
+    func wait(timeout: Duration) async -> Bool {
+        await withTaskGroup(of: Void.self) { group in
+            group.addTask {
+                try? await Task.sleep(for: timeout)
+                self.resumeWaiter(returning: false)
+            }
+
+            let isSent = await withCheckedContinuation { continuation in
+                let isSent = state.withLock { state in
+                    if !state.isSent {
+                        state.waiter = continuation
+                    }
+                    return state.isSent
+                }
+                if isSent {
+                    continuation.resume(returning: true)
+                }
+            }
+
+            group.cancelAll()
+            return isSent
+        }
+    }
+
+    private func resumeWaiter(returning value: Bool) {
+        let waiter = state.withLock { state in
+            defer { state.waiter = nil }
+            return state.waiter
+        }
+        waiter?.resume(returning: value)
+    }
+}
+
+protocol DispatchDigit: Sendable {}
+enum DispatchDigit0: DispatchDigit {
+    static let runCount = Atomic<Int>(0)
+}
+enum DispatchDigit1: DispatchDigit {}
+enum DispatchDigit2: DispatchDigit {}
+enum DispatchDigit3: DispatchDigit {}
+enum DispatchDigit4: DispatchDigit {}
+enum DispatchDigit5: DispatchDigit {}
+enum DispatchDigit6: DispatchDigit {}
+
+/// Each combination of digits is a distinct system type.
+struct DispatchSystem<A: DispatchDigit, B: DispatchDigit, C: DispatchDigit>: System {
+    init(world: World) {}
+
+    func update(context: UpdateContext) async {
+        DispatchDigit0.runCount.add(1, ordering: .relaxed)
+    }
+}
+
+private func addDispatchSystems(to world: World) {
+    func add<A: DispatchDigit>(_ a: A.Type) {
+        add(a, DispatchDigit0.self)
+        add(a, DispatchDigit1.self)
+        add(a, DispatchDigit2.self)
+        add(a, DispatchDigit3.self)
+        add(a, DispatchDigit4.self)
+        add(a, DispatchDigit5.self)
+        add(a, DispatchDigit6.self)
+    }
+
+    func add<A: DispatchDigit, B: DispatchDigit>(_ a: A.Type, _ b: B.Type) {
+        world.addSystem(DispatchSystem<A, B, DispatchDigit0>.self, on: .multiThreadedDispatchTest)
+        world.addSystem(DispatchSystem<A, B, DispatchDigit1>.self, on: .multiThreadedDispatchTest)
+        world.addSystem(DispatchSystem<A, B, DispatchDigit2>.self, on: .multiThreadedDispatchTest)
+        world.addSystem(DispatchSystem<A, B, DispatchDigit3>.self, on: .multiThreadedDispatchTest)
+        world.addSystem(DispatchSystem<A, B, DispatchDigit4>.self, on: .multiThreadedDispatchTest)
+        world.addSystem(DispatchSystem<A, B, DispatchDigit5>.self, on: .multiThreadedDispatchTest)
+        world.addSystem(DispatchSystem<A, B, DispatchDigit6>.self, on: .multiThreadedDispatchTest)
+    }
+
+    add(DispatchDigit0.self)
+    add(DispatchDigit1.self)
+    add(DispatchDigit2.self)
+    add(DispatchDigit3.self)
+    add(DispatchDigit4.self)
+    add(DispatchDigit5.self)
+    add(DispatchDigit6.self)
+}
+
 private extension SchedulerName {
     static let multiThreadedTest: SchedulerName = "MultiThreadedTest"
     static let multiThreadedOrderTest: SchedulerName = "MultiThreadedOrderTest"
+    static let multiThreadedStartTest: SchedulerName = "MultiThreadedStartTest"
+    static let multiThreadedDispatchTest: SchedulerName = "MultiThreadedDispatchTest"
 }
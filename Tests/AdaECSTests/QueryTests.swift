@@ -187,4 +187,100 @@ struct QueryTests {
         query.update(from: world)
         #expect(query.wrappedValue.count == 4)
     }
+
+    @Test("Query matches only new archetypes")
+    func queryMatchesOnlyNewArchetypes() {
+        final class Counter: @unchecked Sendable {
+            var value = 0
+        }
+
+        let world = World()
+        world.spawn {
+            Transform()
+        }
+
+        let counter = Counter()
+        let query = EntityQuery(where: QueryPredicate { archetype in
+            counter.value += 1
+            return archetype.componentLayout.maskSet.contains(Transform.identifier)
+        })
+        query.update(from: world)
+        let archetypeCount = world.archetypes.archetypes.count
+        #expect(counter.value == archetypeCount)
+        #expect(query.wrappedValue.count == 1)
+
+        // No new archetypes, nothing to evaluate
+        world.spawn {
+            Transform()
+        }
+        query.update(from: world)
+        #expect(counter.value == archetypeCount)
+        #expect(query.wrappedValue.count == 2)
+
+        let generation = world.archetypes.generation
+        world.spawn {
+            Transform()
+            Velocity()
+        }
+        #expect(world.archetypes.generation == generation + 1)
+
+        query.update(from: world)
+        #expect(counter.value == archetypeCount + 1)
+        #expect(query.wrappedValue.count == 3)
+
+        // Other world is matched from scratch
+        let otherWorld = World()
+        otherWorld.spawn {
+            Velocity()
+        }
+        query.update(from: otherWorld)
+        #expect(counter.value == archetypeCount + 1 + otherWorld.archetypes.archetypes.count)
+        #expect(query.wrappedValue.count == 0)
+    }
+
+    @Test("Parallel query collects results in iteration order")
+    func parallelQueryCollectsResultsInOrder() async {
+        let world = World()
+        world.spawnBatch(count: 1500) { index in
+            Transform(position: [Float(index), 0, 0])
+        }
+        world.spawnBatch(count: 700) { index in
+            Transform(position: [Float(1500 + index), 0, 0])
+            Velocity()
+        }
+
+        let query = Query<Transform>()
+        query.update(from: world)
+
+        let sequential = query.wrappedValue.map { $0.position.x }
+        let parallel = await query.wrappedValue.parallel(batchSize: 100).map { $0.position.x }
+        #expect(parallel == sequential)
+
+        let sum = await query.wrappedValue.parallel(batchSize: 100).reduce(0) { result, transform in
+            result += Int(transform.position.x)
+        } combine: { $0 + $1 }
+        #expect(sum == (0..<2200).reduce(0, +))
+    }
+
+    @Test("Parallel query writes components with worker scratch")
+    func parallelQueryWritesComponentsWithScratch() async {
+        let world = World()
+        world.spawnBatch(count: 1000) { index in
+            Transform(position: [Float(index), 0, 0])
+        }
+
+        let query = Query<Ref<Transform>>()
+        query.update(from: world)
+
+        await query.wrappedValue.parallel(batchSize: 64).forEach(scratch: { [Float]() }) { scratch, transform in
+            scratch.removeAll(keepingCapacity: true)
+            scratch.append(transform.wrappedValue.position.x)
+            transform.wrappedValue.position.y = scratch[0] * 2
+        }
+
+        let values = await query.wrappedValue.parallel().compactMap { transform in
+            transform.wrappedValue.position.y == transform.wrappedValue.position.x * 2 ? nil : transform.wrappedValue.position
+        }
+        #expect(values.isEmpty)
+    }
 }
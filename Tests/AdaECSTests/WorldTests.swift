@@ -1,3 +1,4 @@
+import Foundation
 import Testing
 import AdaUtils
 @_spi(Internal) @testable import AdaECS
@@ -21,6 +22,11 @@ struct ComponentC: Equatable { }
 @Component(required: [ComponentA.self])
 struct ComponentWithRequirement {}
 
+@Component
+struct SnapshotLabel: Codable, Equatable {
+    var text: String
+}
+
 struct TestResource: Resource, Equatable {
     var value: Int
 }
@@ -356,6 +362,108 @@ extension WorldTests {
         #expect(sum == expectedSum)
     }
 
+    @Test("Spawn entities with one batch across chunks")
+    func spawnBatchAcrossChunks() {
+        let entityCount = 600
+        let entities = world.spawnBatch(count: entityCount) { index in
+            ComponentB(value: "\(index)")
+            ComponentWithRequirement()
+        }
+
+        #expect(entities.count == entityCount)
+        let location = world.entities.entities[entities[0].id]!
+        #expect(world.archetypes.archetypes[location.archetypeId].entities.count == entityCount)
+        #expect(world.archetypes.archetypes[location.archetypeId].chunks.count == 3)
+
+        for (index, entity) in entities.enumerated() {
+            #expect(world.get(ComponentB.self, from: entity.id)?.value == "\(index)")
+            #expect(world.get(ComponentA.self, from: entity.id) == ComponentA.defaultValue)
+        }
+
+        let query = world.performQuery(Query<Entity, ComponentB>())
+        #expect(query.count == entityCount)
+    }
+
+    @Test("Command spawn batch and insert batch")
+    func commandSpawnBatchAndInsertBatch() {
+        let commands = world.makeCommands()
+        let entities = commands.spawnBatch(count: 300) { index in
+            ComponentA(value: index)
+        }
+        commands.insertBatch(entities.enumerated().map { index, entity in
+            (entity, ComponentB(value: "\(index)"))
+        })
+        commands.finish(world)
+        world.flush()
+
+        let query = world.performQuery(Query<Entity, ComponentA, ComponentB>())
+        #expect(query.count == 300)
+        for (entity, a, b) in query {
+            #expect(b.value == "\(a.value)")
+            #expect(entity.id == entities[a.value])
+        }
+    }
+
+    @Test("Command add and remove child spawned by commands")
+    func commandAddAndRemoveSpawnedChild() {
+        let parent = world.spawn("Parent") {
+            ComponentA(value: 0)
+        }
+
+        let commands = world.makeCommands()
+        let child = commands.spawn("Child") {
+            ComponentA(value: 1)
+        }
+        commands.entity(parent.id).addChild(child.entityId)
+        commands.finish(world)
+        world.flush()
+
+        #expect(parent.children.map(\.id) == [child.entityId])
+        #expect(world.getEntityByID(child.entityId)?.parent?.id == parent.id)
+
+        commands.entity(parent.id).removeChild(child.entityId)
+        commands.finish(world)
+        world.flush()
+
+        #expect(parent.children.isEmpty)
+        #expect(world.getEntityByID(child.entityId)?.parent == nil)
+    }
+
+    @Test("Snapshot restores entities and components")
+    @MainActor
+    func snapshotRoundTrip() throws {
+        ComponentA.registerComponent()
+        SnapshotLabel.registerComponent()
+
+        let entities = world.spawnBatch("Tile", count: 600) { index in
+            ComponentA(value: index)
+            SnapshotLabel(text: "tile \(index)")
+        }
+        world.spawn("Single") {
+            ComponentA(value: -1)
+        }
+        let snapshot = try world.makeSnapshot()
+
+        world.removeEntity(entities[0].id)
+        world.insert(ComponentA(value: 1000), for: entities[1].id)
+        try world.restoreSnapshot(snapshot)
+
+        let query = world.performQuery(Query<Entity, ComponentA, SnapshotLabel>())
+        #expect(query.count == 600)
+        for (entity, a, label) in query {
+            #expect(entity.id == entities[a.value].id)
+            #expect(entity.name == "Tile")
+            #expect(label.text == "tile \(a.value)")
+        }
+        #expect(world.getEntityByName("Single")?.components[ComponentA.self]?.value == -1)
+
+        let newEntity = world.spawn("New")
+        #expect(world.getEntities().filter { $0.id == newEntity.id }.count == 1)
+        #expect(throws: WorldSnapshotError.self) {
+            try world.restoreSnapshot(WorldSnapshot(data: Data([1, 2, 3])))
+        }
+    }
+
     @Test("Remove Missing Component")
     func removeMissingComponent() {
         let e = world.spawn {
@@ -433,6 +541,36 @@ extension WorldTests {
         #expect(changedEntitiesAfterMove.contains(e1.id))
     }
 
+    @Test("Changed filter skips chunks without changes")
+    func changedFilterSkipsChunksWithoutChanges() async {
+        let entities = world.spawnBatch(count: 1000) { index in
+            ComponentA(value: index)
+        }
+        world.clearTrackers()
+
+        let query = Query<Ref<ComponentA>>()
+        query.update(from: world)
+        for component in query where component.wrappedValue.value == 600 {
+            component.wrappedValue.value = -1
+        }
+
+        let location = world.entities.entities[entities[600].id]!
+        let chunks = world.archetypes.archetypes[location.archetypeId].chunks.chunks
+        let changedChunks = chunks.indices.filter { index in
+            chunks[index].componentsData[ComponentA.identifier]!.lastTicks.changed.tick
+                .isNewerThan(lastTick: world.lastTick, currentTick: world.currentTick)
+        }
+        #expect(changedChunks == [location.chunkIndex])
+
+        let changedQuery = world.performQuery(FilterQuery<Entity, Changed<ComponentA>>())
+        #expect(changedQuery.map(\.id) == [entities[600].id])
+
+        let parallelQuery = FilterQuery<Entity, Changed<ComponentA>>()
+        parallelQuery.update(from: world)
+        let parallelChanged = await parallelQuery.parallel().map { $0.id }
+        #expect(parallelChanged == [entities[600].id])
+    }
+
     @Test
     func requiredComponent() {
         world.registerRequiredComponent(RequiredComponentForA.self, for: ComponentA.self) {
@@ -49,4 +49,16 @@ struct FixedTimestepTests {
         #expect(result.isFixedTick)
         #expect(timestep.accumulator <= stepsPerSecond * 5)
     }
+
+    @Test
+    func overstepFraction() {
+        let step: Float = 1.0 / 60.0
+        var timestep = FixedTimestep(stepsPerSecond: 60)
+
+        _ = timestep.advance(with: step * 1.25)
+        #expect(abs(timestep.overstepFraction - 0.25) < 0.001)
+
+        _ = timestep.advance(with: step * 0.5)
+        #expect(abs(timestep.overstepFraction - 0.75) < 0.001)
+    }
 }
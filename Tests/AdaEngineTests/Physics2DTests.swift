@@ -10,6 +10,8 @@ import AdaECS
 @_spi(Internal) @testable import AdaApp
 @testable import AdaPhysics
 import AdaTransform
+import box2d
+import Math
 
 @MainActor
 struct Physics2DTests {
@@ -26,6 +28,92 @@ struct Physics2DTests {
             .addPlugin(TransformPlugin())
         try await world.build()
     }
+
+    @Test
+    func groupStepsWorldsLikeSerialStepping() async {
+        let serial = Self.makeFallingWorlds(count: 4)
+        let grouped = Self.makeFallingWorlds(count: 4)
+        let group = PhysicsWorld2DGroup(worlds: grouped.worlds)
+
+        for _ in 0..<120 {
+            for world in serial.worlds {
+                world.step(1.0 / 60.0)
+            }
+            await group.step(1.0 / 60.0)
+        }
+
+        let serialPositions = serial.bodies.map { $0.map { $0.getPosition() } }
+        let groupedPositions = grouped.bodies.map { $0.map { $0.getPosition() } }
+        #expect(groupedPositions == serialPositions)
+        // Boxes fell and landed on the ground.
+        #expect(serialPositions.allSatisfy { $0.dropFirst().allSatisfy { $0.y < 10 && $0.y > -9 } })
+    }
+
+    @Test
+    func resetDetachesRuntimeBodiesOfLiveComponents() throws {
+        let physicsWorld = try #require(world.main.physicsWorld2D)
+        var dynamicDef = unsafe b2DefaultBodyDef()
+        unsafe dynamicDef.type = b2_dynamicBody
+
+        let entity = world.main.spawn {
+            Collision2DComponent(shapes: [.generateBox()])
+            PhysicsBody2DComponent(shapes: [.generateBox()], mass: 1)
+            Transform()
+        }
+        entity.components[Collision2DComponent.self]?.runtimeBody = unsafe physicsWorld.createBody(with: b2DefaultBodyDef(), for: entity)
+        entity.components[PhysicsBody2DComponent.self]?.runtimeBody = unsafe physicsWorld.createBody(with: dynamicDef, for: entity)
+
+        // When: World is reset while components are alive
+        physicsWorld.reset()
+
+        // Then: Components don't use bodies of the previous simulation
+        #expect(entity.components[Collision2DComponent.self]?.runtimeBody == nil)
+        #expect(entity.components[PhysicsBody2DComponent.self]?.runtimeBody == nil)
+
+        // When: New bodies reuse ids of the old ones, then the entity is despawned
+        let newBodies = (0..<2).map { _ in
+            unsafe physicsWorld.createBody(with: dynamicDef, for: Entity())
+        }
+        world.main.removeEntity(entity)
+
+        // Then: Released old bodies don't destroy the new ones
+        #expect(newBodies.allSatisfy { b2Body_IsValid($0.bodyId) })
+        physicsWorld.step(1.0 / 60.0)
+        #expect(newBodies.allSatisfy { $0.getPosition().y < 0 })
+    }
+
+    /// Worlds with a ground and a stack of boxes, each world has its own gravity.
+    private static func makeFallingWorlds(count: Int) -> (worlds: [PhysicsWorld2D], bodies: [[Body2D]]) {
+        var worlds: [PhysicsWorld2D] = []
+        var bodies: [[Body2D]] = []
+
+        for index in 0..<count {
+            let world = PhysicsWorld2D(gravity: [0, -9.81 - Float(index)])
+
+            var groundDef = unsafe b2DefaultBodyDef()
+            unsafe groundDef.position = Vector2(0, -10).b2Vec
+            let ground = unsafe world.createBody(with: groundDef, for: Entity())
+            unsafe ground.appendShape(.generateBox(width: 100, height: 2), transform: Transform(), shapeDef: b2DefaultShapeDef())
+            var worldBodies = [ground]
+
+            for boxIndex in 0..<8 {
+                var bodyDef = unsafe b2DefaultBodyDef()
+                unsafe bodyDef.type = b2_dynamicBody
+                unsafe bodyDef.position = Vector2(Float(boxIndex) * 0.5, 2 + Float(boxIndex) * 1.5).b2Vec
+                var shapeDef = unsafe b2DefaultShapeDef()
+                unsafe shapeDef.density = 1
+
+                let body = unsafe world.createBody(with: bodyDef, for: Entity())
+                unsafe body.appendShape(.generateBox(), transform: Transform(), shapeDef: shapeDef)
+                worldBodies.append(body)
+            }
+
+            worlds.append(world)
+            bodies.append(worldBodies)
+        }
+
+        return (worlds, bodies)
+    }
 //    
 //    @Test
 //    func createStaticBody() async throws {
@@ -0,0 +1,83 @@
+//
+//  TileCollisionBakerTests.swift
+//  AdaEngine
+//
+//  Created by Vladislav Prusakov on 18.10.2026.
+//
+
+import Testing
+@testable import AdaTilemap
+import Math
+
+struct TileCollisionBakerTests {
+
+    @Test
+    func mergesCollinearEdgesOfSolidBlock() {
+        var baker = TileCollisionBaker(width: 4, height: 4)
+        for y in 0..<2 {
+            for x in 0..<3 {
+                baker[x, y] = true
+            }
+        }
+
+        let contours = baker.contours()
+        #expect(contours == [[[0, 0], [3, 0], [3, 2], [0, 2]]])
+    }
+
+    @Test
+    func holesAreClockwise() {
+        var baker = TileCollisionBaker(width: 3, height: 3)
+        for y in 0..<3 {
+            for x in 0..<3 where !(x == 1 && y == 1) {
+                baker[x, y] = true
+            }
+        }
+
+        let contours = baker.contours()
+        #expect(contours.count == 2)
+        #expect(contours.map(Self.signedArea).sorted() == [-1, 9])
+    }
+
+    @Test
+    func diagonalCellsAreSeparateContours() {
+        var baker = TileCollisionBaker(width: 2, height: 2)
+        baker[0, 0] = true
+        baker[1, 1] = true
+
+        let contours = baker.contours()
+        #expect(contours.count == 2)
+        #expect(contours.allSatisfy { $0.count == 4 && Self.signedArea($0) == 1 })
+    }
+
+    @Test
+    func rectanglesCoverSolidCellsOnce() {
+        var baker = TileCollisionBaker(width: 4, height: 3)
+        let solid: [PointInt] = [[0, 0], [1, 0], [2, 0], [0, 1], [1, 1], [2, 1], [3, 2]]
+        for cell in solid {
+            baker[cell.x, cell.y] = true
+        }
+
+        let rectangles = baker.rectangles()
+        #expect(rectangles == [
+            RectInt(x: 0, y: 0, width: 3, height: 2),
+            RectInt(x: 3, y: 2, width: 1, height: 1)
+        ])
+    }
+
+    @Test
+    func collisionChunkOfNegativeCells() {
+        let size = TileMapLayer.collisionChunkSize
+        #expect(TileMapLayer.collisionChunk(for: [0, size - 1]) == [0, 0])
+        #expect(TileMapLayer.collisionChunk(for: [-1, size]) == [-1, 1])
+        #expect(TileMapLayer.collisionChunk(for: [-size, -size - 1]) == [-1, -2])
+    }
+
+    private static func signedArea(_ contour: [PointInt]) -> Int {
+        var area = 0
+        for index in contour.indices {
+            let next = contour[(index + 1) % contour.count]
+            area += contour[index].x * next.y - next.x * contour[index].y
+        }
+        return area / 2
+    }
+}
@@ -0,0 +1,116 @@
+//
+//  ImageDecodeServiceTests.swift
+//  AdaEngine
+//
+
+import AdaAssets
+@testable import AdaRender
+import Foundation
+import Testing
+
+@Suite("Image Decode Service")
+struct ImageDecodeServiceTests {
+
+    @Test("premultiplied alpha and mipmaps are decoded with the image")
+    func premultipliedAlphaAndMipmaps() throws {
+        let width = 5
+        let height = 3
+        let pixels = (0..<width * height * 4).map { index in
+            UInt8(truncatingIfNeeded: index &* 37 &+ 11)
+        }
+        let encoded = try PNGDecodingTests.encodePNG(pixels, width: width, height: height)
+
+        let decoded = try ImageDecodeService().decodeImage(
+            from: encoded,
+            options: ImageDecodeOptions(premultipliesAlpha: true, generatesMipmaps: true)
+        )
+
+        let premultiplied = pixels.indices.map { index in
+            let alpha = Int(pixels[index | 3])
+            return index % 4 == 3 ? pixels[index] : UInt8((Int(pixels[index]) * alpha * 2 + 255) / 510)
+        }
+        #expect(decoded.isAlphaPremultiplied)
+        #expect(decoded.image.data == Data(premultiplied))
+
+        // 5x3 -> 2x1 -> 1x1, the last column of an odd width is clamped.
+        #expect(decoded.mipmaps.map { [$0.width, $0.height] } == [[2, 1], [1, 1]])
+        let level1 = (0..<2 * 4).map { index in
+            let x = index / 4
+            let channel = index % 4
+            let sum = [(2 * x, 0), (2 * x + 1, 0), (2 * x, 1), (2 * x + 1, 1)].reduce(0) { sum, position in
+                sum + Int(premultiplied[(position.1 * width + position.0) * 4 + channel])
+            }
+            return UInt8((sum + 2) / 4)
+        }
+        #expect(decoded.mipmaps[0].data == Data(level1))
+    }
+
+    @Test("batch results are in the order of files")
+    func batchResultsAreOrdered() async throws {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer {
+            try? FileManager.default.removeItem(at: directory)
+        }
+
+        var urls: [URL] = []
+        for width in 1...16 {
+            let pixels = [UInt8](repeating: UInt8(width), count: width * 2 * 4)
+            let url = directory.appendingPathComponent("sprite_\(width).png")
+            try PNGDecodingTests.encodePNG(pixels, width: width, height: 2).write(to: url)
+            urls.append(url)
+        }
+        urls.insert(directory.appendingPathComponent("missing.png"), at: 3)
+
+        // Small reads make every file take several decoder pushes.
+        let results = await ImageDecodeService(maxConcurrentDecodes: 4).decodeImages(
+            contentsOf: urls,
+            options: ImageDecodeOptions(readChunkSize: 17)
+        )
+
+        #expect(results.count == urls.count)
+        #expect(throws: ImageDecodeError.self) {
+            try results[3].get()
+        }
+        let widths = try results.enumerated().filter { $0.offset != 3 }.map { try $0.element.get().image.width }
+        #expect(widths == Array(1...16))
+    }
+
+    @Test("images loaded by the assets manager keep the order of paths")
+    func assetsBatchLoading() async throws {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer {
+            try? FileManager.default.removeItem(at: directory)
+        }
+
+        var paths: [String] = []
+        for width in 1...8 {
+            let pixels = [UInt8](repeating: UInt8(width), count: width * 3 * 4)
+            let url = directory.appendingPathComponent("tile_\(width).png")
+            try PNGDecodingTests.encodePNG(pixels, width: width, height: 3).write(to: url)
+            paths.append(url.path)
+        }
+        paths.append(paths[2])
+
+        let handles = try await AssetsManager.load(Image.self, at: paths)
+
+        #expect(handles.map { $0.asset.width } == Array(1...8) + [3])
+        #expect(handles[8] === handles[2])
+        #expect(handles[4].asset.data == Data(repeating: 5, count: 5 * 3 * 4))
+        #expect(handles[4].asset.assetPath == paths[4])
+        #expect(try Image(contentsOf: URL(fileURLWithPath: paths[4])).data == handles[4].asset.data)
+    }
+
+    @Test("truncated data fails")
+    func truncatedDataFails() throws {
+        let pixels = [UInt8](repeating: 200, count: 32 * 32 * 4)
+        let encoded = try PNGDecodingTests.encodePNG(pixels, width: 32, height: 32)
+
+        #expect(throws: ImageDecodeError.self) {
+            try ImageDecodeService().decodeImage(from: encoded.prefix(encoded.count / 2))
+        }
+    }
+}
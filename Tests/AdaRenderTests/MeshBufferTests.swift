@@ -233,6 +233,47 @@ struct MeshBufferTests {
         #expect(reflection.descriptorSets[1].samplers.keys.contains(1))
     }
 
+    @Test func `shader reflection blob contains vertex inputs and buffer layout`() throws {
+        let source = try ShaderSource(source: """
+        #version 450 core
+        #pragma stage : vert
+
+        layout (location = 1) in vec2 a_TexCoord;
+        layout (location = 0) in vec3 a_Position;
+
+        layout (binding = 0) uniform Globals {
+            mat4 u_View;
+            vec4 u_Tint;
+        };
+
+        [[main]]
+        void test_vertex()
+        {
+            gl_Position = u_View * vec4(a_Position, 1.0) * u_Tint + vec4(a_TexCoord, 0.0, 0.0);
+        }
+        """)
+        let compiler = ShaderCompiler(shaderSource: source)
+        let spirv = try compiler.compileSpirvBin(for: .vertex, ignoreCache: true)
+        let blob = try SpirvCompiler(
+            spriv: spirv.data,
+            stage: .vertex,
+            deviceLang: .glsl
+        ).reflectionBlob()
+        let reflection = try ShaderReflectionData(reflectionBlob: blob, stage: .vertex)
+
+        #expect(reflection.vertexInputs.map(\.name) == ["a_Position", "a_TexCoord"])
+        #expect(reflection.vertexInputs.map(\.type) == [.vec3, .vec2])
+
+        let globals = try #require(reflection.shaderBuffers["Globals"])
+        #expect(globals.size == 80)
+        #expect(globals.members["u_View"]?.type == .mat4)
+        #expect(globals.members["u_Tint"]?.offset == 64)
+
+        #expect(throws: ShaderReflectionData.BlobError.self) {
+            try ShaderReflectionData(reflectionBlob: blob.prefix(blob.count - 1), stage: .vertex)
+        }
+    }
+
     #if canImport(Metal)
     @Test func `mesh2d positions and colors pipeline compiles on Metal`() throws {
         guard let device = MTLCreateSystemDefaultDevice() else {
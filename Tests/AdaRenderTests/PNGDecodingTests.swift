@@ -0,0 +1,175 @@
+//
+//  PNGDecodingTests.swift
+//  AdaEngine
+//
+
+@testable import AdaRender
+import Foundation
+import libpng
+import Testing
+
+@Suite("PNG Decoding")
+struct PNGDecodingTests {
+
+    /// Widths cover rows shorter than one SIMD block and rows with a partial last block.
+    @Test("decoded pixels match encoded pixels", arguments: [1, 3, 5, 17, 64, 257])
+    func decodedPixelsMatchEncodedPixels(width: Int) throws {
+        let height = 9
+        let pixels = (0..<width * height * 4).map { index in
+            // Opaque, so pixels are decoded without alpha conversions.
+            index % 4 == 3 ? 255 : UInt8(truncatingIfNeeded: (index &* 7) ^ (index / 4) ^ (index / (width * 4)))
+        }
+
+        let encoded = try Self.encodePNG(pixels, width: width, height: height)
+        let image = try Image.decode(from: encoded)
+
+        #expect(image.width == width)
+        #expect(image.height == height)
+        #expect(image.data == Data(pixels))
+    }
+
+    /// Fixtures go through the SIMD unfilters and palette expansion, the generic C code is the reference.
+    @Test("fixtures match the scalar decoder", arguments: Fixture.allCases, [1, 3, 5, 17, 64, 257])
+    func fixturesMatchScalarDecoder(fixture: Fixture, width: Int) throws {
+        let height = 9
+        let (encoded, expected) = fixture.make(width: width, height: height)
+
+        var scalarOptions = ImageDecodeOptions()
+        scalarOptions.usesSIMD = false
+        let service = ImageDecodeService()
+        let image = try service.decodeImage(from: encoded).image
+        let scalarImage = try service.decodeImage(from: encoded, options: scalarOptions).image
+
+        #expect(image.width == width)
+        #expect(image.height == height)
+        #expect(image.data == scalarImage.data)
+        #expect(image.data == Data(expected))
+    }
+
+    /// Color types other than RGBA, and interlaced images that are decoded pass by pass.
+    enum Fixture: CaseIterable, Sendable {
+        case rgb
+        case paletteWithTransparency
+        case grayAlpha
+        case interlacedRGB
+        case interlacedRGBA
+
+        private var colorType: Int32 {
+            switch self {
+            case .rgb, .interlacedRGB:
+                return PNG_COLOR_TYPE_RGB
+            case .paletteWithTransparency:
+                return PNG_COLOR_TYPE_PALETTE
+            case .grayAlpha:
+                return PNG_COLOR_TYPE_GRAY_ALPHA
+            case .interlacedRGBA:
+                return PNG_COLOR_TYPE_RGB_ALPHA
+            }
+        }
+
+        private var channels: Int {
+            switch self {
+            case .rgb, .interlacedRGB:
+                return 3
+            case .paletteWithTransparency:
+                return 1
+            case .grayAlpha:
+                return 2
+            case .interlacedRGBA:
+                return 4
+            }
+        }
+
+        private var isInterlaced: Bool {
+            return self == .interlacedRGB || self == .interlacedRGBA
+        }
+
+        /// Returns the encoded image and its pixels in RGBA8.
+        func make(width: Int, height: Int) -> (encoded: Data, pixels: [UInt8]) {
+            let channels = self.channels
+            var pixels = (0..<width * height * channels).map { index in
+                UInt8(truncatingIfNeeded: (index &* 7) ^ (index / channels) ^ (index / (width * channels)))
+            }
+            let palette = (0..<256).map { index in
+                png_color(red: UInt8(index), green: UInt8(255 - index), blue: UInt8(truncatingIfNeeded: index &* 7))
+            }
+            let paletteAlpha = (0..<256).map { UInt8(truncatingIfNeeded: $0 &* 3) }
+
+            var expected: [UInt8] = []
+            expected.reserveCapacity(width * height * 4)
+            for index in stride(from: 0, to: pixels.count, by: channels) {
+                switch self {
+                case .rgb, .interlacedRGB:
+                    expected += pixels[index..<index + 3] + [255]
+                case .paletteWithTransparency:
+                    let color = palette[Int(pixels[index])]
+                    expected += [color.red, color.green, color.blue, paletteAlpha[Int(pixels[index])]]
+                case .grayAlpha:
+                    expected += [pixels[index], pixels[index], pixels[index], pixels[index + 1]]
+                case .interlacedRGBA:
+                    expected += pixels[index..<index + 4]
+                }
+            }
+
+            let buffer = PNGWriteBuffer()
+            var png = unsafe png_create_write_struct(PNG_LIBPNG_VER_STRING, nil, nil, nil)
+            var info = unsafe png_create_info_struct(png)
+            unsafe png_set_write_fn(png, Unmanaged.passUnretained(buffer).toOpaque(), { png, bytes, count in
+                let buffer = unsafe Unmanaged<PNGWriteBuffer>.fromOpaque(png_get_io_ptr(png)!).takeUnretainedValue()
+                unsafe buffer.data.append(bytes!, count: count)
+            }, nil)
+            unsafe png_set_IHDR(
+                png,
+                info,
+                png_uint_32(width),
+                png_uint_32(height),
+                8,
+                self.colorType,
+                self.isInterlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
+                PNG_COMPRESSION_TYPE_DEFAULT,
+                PNG_FILTER_TYPE_DEFAULT
+            )
+            if self == .paletteWithTransparency {
+                unsafe png_set_PLTE(png, info, palette, Int32(palette.count))
+                unsafe png_set_tRNS(png, info, paletteAlpha, Int32(paletteAlpha.count), nil)
+            }
+            unsafe png_write_info(png, info)
+
+            // Rows are written pass by pass if the image is interlaced.
+            unsafe pixels.withUnsafeMutableBufferPointer { pixels in
+                var rows = unsafe (0..<height).map { row -> UnsafeMutablePointer<UInt8>? in
+                    unsafe pixels.baseAddress! + row * width * channels
+                }
+                unsafe png_write_image(png, &rows)
+            }
+            unsafe png_write_end(png, nil)
+            unsafe png_destroy_write_struct(&png, &info)
+
+            return (buffer.data, expected)
+        }
+    }
+
+    static func encodePNG(_ pixels: [UInt8], width: Int, height: Int) throws -> Data {
+        var pngImage = unsafe png_image()
+        unsafe pngImage.version = png_uint_32(PNG_IMAGE_VERSION)
+        unsafe pngImage.width = png_uint_32(width)
+        unsafe pngImage.height = png_uint_32(height)
+        unsafe pngImage.format = PNG_FORMAT_FLAG_COLOR | PNG_FORMAT_FLAG_ALPHA
+
+        var size = unsafe swift_png_image_png_size_max(pngImage)
+        var data = Data(count: size)
+        let isSuccess = unsafe data.withUnsafeMutableBytes { buffer in
+            unsafe pixels.withUnsafeBytes { pixels in
+                unsafe png_image_write_to_memory(&pngImage, buffer.baseAddress, &size, 0, pixels.baseAddress, 0, nil) == 1
+            }
+        }
+        unsafe png_image_free(&pngImage)
+        try #require(isSuccess)
+
+        return data.prefix(size)
+    }
+}
+
+private final class PNGWriteBuffer {
+    var data = Data()
+}
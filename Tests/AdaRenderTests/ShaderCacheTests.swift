@@ -7,6 +7,7 @@
 
 import Testing
 @testable import AdaRender
+import AdaUtils
 import Foundation
 
 @Suite("Shader Cache Tests")
@@ -45,7 +46,8 @@ struct ShaderCacheTests {
         
         // Create ShaderSource from the file
         let shader = try ShaderSource(from: shaderFileURL)
-        let version = 1
+        // Cache is content addressed and shared between runs, unique version keeps the first lookup a miss.
+        let version = Int.random(in: 1...Int.max)
         
         // When: First call to hasChanges (no cache exists)
         let firstCallChanges = ShaderCache.hasChanges(for: shader, version: version)
@@ -53,7 +55,12 @@ struct ShaderCacheTests {
         // Then: Should return vertex stage as changed (first time = no cache)
         #expect(firstCallChanges.contains(.vertex))
         
-        // When: Second call with the same source (cache exists)
+        // Then: Lookup doesn't store anything, source stays changed until compiled
+        #expect(ShaderCache.hasChanges(for: shader, version: version).contains(.vertex))
+        
+        // When: Compiled shader is stored
+        let spirv = try ShaderCompiler(shaderSource: shader).compileSpirvBin(for: .vertex, ignoreCache: true)
+        try ShaderCache.save(spirv, source: shader, stage: .vertex, version: version)
         let secondCallChanges = ShaderCache.hasChanges(for: shader, version: version)
         
         // Then: Should return empty set (no changes)
@@ -69,6 +76,203 @@ struct ShaderCacheTests {
         #expect(thirdCallChanges.contains(.vertex))
     }
 
+    @Test func `if included file change we update shader`() throws {
+        let tempDirectory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: tempDirectory, withIntermediateDirectories: true)
+
+        defer {
+            try? FileManager.default.removeItem(at: tempDirectory)
+        }
+
+        let includeFileURL = tempDirectory.appendingPathComponent("common.glsl")
+        let shaderFileURL = tempDirectory.appendingPathComponent("include_shader.glsl")
+        try writeUTF8("vec4 position() { return vec4(0.0); }\n", to: includeFileURL)
+        try writeUTF8("""
+        #version 450 core
+        #pragma stage : vert
+        #include "common.glsl"
+
+        void main() {
+            gl_Position = position();
+        }
+        """, to: shaderFileURL)
+
+        let compiler = try ShaderCompiler(from: shaderFileURL)
+
+        // When: Compile shader, include closure is stored in cache
+        let spirv = try compiler.compileSpirvBin(for: .vertex, ignoreCache: true)
+        let version = spirv.version
+        #expect(spirv.includes.map(\.path) == [includeFileURL.path])
+
+        // Then: Nothing changed
+        #expect(
+            ShaderCache.hasChanges(
+                for: compiler.shaderSource,
+                version: version,
+                includeSearchPaths: compiler.includeSearchPaths
+            ).isEmpty
+        )
+
+        // When: Modify included file
+        try writeUTF8("vec4 position() { return vec4(1.0, 1.0, 1.0, 1.0); }\n", to: includeFileURL)
+
+        // Then: Stage that includes the file should be invalidated
+        #expect(
+            ShaderCache.hasChanges(
+                for: compiler.shaderSource,
+                version: version,
+                includeSearchPaths: compiler.includeSearchPaths
+            ).contains(.vertex)
+        )
+    }
+
+    @Test func `compacted spirv keeps reflection names`() throws {
+        let tempDirectory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: tempDirectory, withIntermediateDirectories: true)
+
+        defer {
+            try? FileManager.default.removeItem(at: tempDirectory)
+        }
+
+        let shaderFileURL = tempDirectory.appendingPathComponent("uniform_shader.glsl")
+        try writeUTF8("""
+        #version 450 core
+        #pragma stage : frag
+
+        layout(std140, binding = 0) uniform Globals {
+            vec4 tint;
+            float time;
+        } globals;
+        layout(binding = 1) uniform sampler2D albedo;
+        layout(location = 0) in vec2 uv;
+        layout(location = 0) out vec4 color;
+
+        void main() {
+            color = texture(albedo, uv) * globals.tint + vec4(globals.time);
+        }
+        """, to: shaderFileURL)
+
+        let compiler = try ShaderCompiler(from: shaderFileURL)
+        let spirv = try compiler.compileSpirvBin(for: .fragment, ignoreCache: true)
+
+        // When: Strip debug info
+        let (module, names) = try spirv.compacted()
+
+        // Then: Module is smaller, names are kept in the side table
+        #expect(module.count < spirv.data.count)
+        #expect(!names.isEmpty)
+
+        // When: Restore names
+        let restored = try SpirvBinary.restoringNames(names, in: module)
+
+        // Then: Reflection is the same as for the original module
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        let originalReflection = try SpirvCompiler(spriv: spirv.data, stage: .fragment, deviceLang: .glsl).reflection()
+        let restoredReflection = try SpirvCompiler(spriv: restored, stage: .fragment, deviceLang: .glsl).reflection()
+        #expect(try encoder.encode(restoredReflection) == encoder.encode(originalReflection))
+    }
+
+    @Test func `batched variants match per variant compilation`() throws {
+        let source = try ShaderSource(source: """
+        #version 450 core
+        #pragma stage : vert
+
+        void main() {
+        #ifdef OFFSET
+            gl_Position = vec4(OFFSET, 0.0, 0.0, 1.0);
+        #else
+            gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+        #endif
+        }
+
+        #pragma stage : frag
+
+        layout(location = 0) out vec4 color;
+
+        void main() {
+        #ifdef TINT
+            color = vec4(TINT);
+        #else
+            color = vec4(1.0);
+        #endif
+        }
+        """)
+        let variants = [ShaderStage.vertex, .fragment].flatMap { stage in
+            [
+                ShaderVariant(source: source, stage: stage),
+                ShaderVariant(source: source, stage: stage, defines: [.define("OFFSET", value: "0.5")]),
+                ShaderVariant(source: source, stage: stage, defines: [.define("TINT", value: "0.25")]),
+                ShaderVariant(source: source, stage: stage, defines: [.define("OFFSET"), .define("TINT")])
+            ]
+        }
+
+        // When: All variants are compiled in a single batch
+        let batched = try ShaderCompiler.compileSpirvVariants(variants, ignoreCache: true)
+
+        // Then: Each binary is the same as compiled alone
+        #expect(batched.count == variants.count)
+        for (variant, binary) in zip(variants, batched) {
+            let compiler = ShaderCompiler(shaderSource: source)
+            for define in variant.defines {
+                compiler.setMacro(define.name, value: define.value, for: variant.stage)
+            }
+            let single = try compiler.compileSpirvBin(for: variant.stage, ignoreCache: true)
+
+            #expect(binary.stage == variant.stage)
+            #expect(binary.version == single.version)
+            #expect(binary.data == single.data)
+        }
+    }
+
+    @Test func `shader cache archive tolerates corrupted tail`() throws {
+        let archiveURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("archive")
+
+        defer {
+            try? FileManager.default.removeItem(at: archiveURL)
+        }
+
+        var hasher = SHA256Hasher()
+        hasher.combine("shader")
+        let spirvKey = ShaderCacheArchive.Key(digest: hasher.finalize(), kind: .spirv)
+        let reflectionKey = ShaderCacheArchive.Key(digest: spirvKey.digest, kind: .reflection)
+
+        // Given: Archive with two entries, one of them written twice
+        let archive = ShaderCacheArchive(fileURL: archiveURL)
+        try archive.write(Data([1, 2, 3]), for: spirvKey)
+        try archive.write(Data([4, 5]), for: reflectionKey)
+        try archive.write(Data([6, 7, 8, 9]), for: spirvKey)
+        #expect(archive.entry(for: spirvKey) == Data([6, 7, 8, 9]))
+
+        // When: Incomplete record is appended at the end
+        let handle = try FileHandle(forWritingTo: archiveURL)
+        try handle.seekToEnd()
+        try handle.write(contentsOf: Data(repeating: 0xAB, count: 13))
+        try handle.close()
+
+        // Then: Valid entries are still readable and the last write wins
+        let reopened = ShaderCacheArchive(fileURL: archiveURL)
+        #expect(reopened.entry(for: spirvKey) == Data([6, 7, 8, 9]))
+        #expect(reopened.entry(for: reflectionKey) == Data([4, 5]))
+
+        // Then: Next write overwrites the broken tail
+        try reopened.write(Data([10]), for: reflectionKey)
+        #expect(ShaderCacheArchive(fileURL: archiveURL).entry(for: reflectionKey) == Data([10]))
+
+        // When: Compact archive offline
+        let recordsCount = try ShaderCacheArchive.compact(at: archiveURL)
+
+        // Then: Only the last record for each key is kept
+        #expect(recordsCount == 2)
+        let compacted = ShaderCacheArchive(fileURL: archiveURL)
+        #expect(compacted.entry(for: spirvKey) == Data([6, 7, 8, 9]))
+        #expect(compacted.entry(for: reflectionKey) == Data([10]))
+    }
+
     @Test func `shader source loads generated wgsl sidecar for stage`() throws {
         let tempDirectory = FileManager.default.temporaryDirectory
             .appendingPathComponent(UUID().uuidString)
@@ -0,0 +1,92 @@
+//
+//  SceneSerializationTests.swift
+//  AdaEngine
+//
+
+import AdaAssets
+import AdaECS
+import AdaScene
+import Foundation
+import Testing
+
+@Component
+struct SceneTestPosition: Codable, Equatable {
+    var x: Float
+    var y: Float
+}
+
+@Component
+struct SceneTestLabel: Codable, Equatable {
+    var text: String
+}
+
+@Suite("Scene Serialization", .serialized)
+struct SceneSerializationTests {
+
+    @Test("binary scene round trips through the scene loader")
+    @MainActor
+    func binarySceneRoundTrip() async throws {
+        SceneTestPosition.registerComponent()
+        SceneTestLabel.registerComponent()
+
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+        defer {
+            try? FileManager.default.removeItem(at: directory)
+        }
+
+        let scene = Scene(name: "Level")
+        for index in 0..<100 {
+            scene.world.spawn("Tile") {
+                SceneTestPosition(x: Float(index), y: 1)
+                SceneTestLabel(text: "tile \(index)")
+            }
+        }
+        scene.world.spawn("Player") {
+            SceneTestPosition(x: -1, y: -1)
+        }
+
+        let fileName = "level.\(Scene.binaryExtension)"
+        try await AssetsManager.save(scene, at: directory.path, name: fileName)
+
+        let url = directory.appendingPathComponent(fileName)
+        #expect(try Data(contentsOf: url).prefix(4) == Data("SCNB".utf8))
+
+        let loaded = try await AssetsManager.load(Scene.self, at: url.path).asset!
+        #expect(loaded.name == "Level")
+
+        let query = loaded.world.performQuery(Query<Entity, SceneTestPosition, SceneTestLabel>())
+        #expect(query.count == 100)
+        for (entity, position, label) in query {
+            #expect(entity.name == "Tile")
+            #expect(label.text == "tile \(Int(position.x))")
+        }
+        let player = loaded.world.getEntityByName("Player")
+        #expect(player?.components[SceneTestPosition.self] == SceneTestPosition(x: -1, y: -1))
+    }
+
+    @Test("text scenes are loaded by the fallback path")
+    @MainActor
+    func textSceneFallback() async throws {
+        SceneTestLabel.registerComponent()
+
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+        defer {
+            try? FileManager.default.removeItem(at: directory)
+        }
+
+        let scene = Scene(name: "Menu")
+        scene.world.spawn("Title") {
+            SceneTestLabel(text: "Start")
+        }
+
+        try await AssetsManager.save(scene, at: directory.path, name: "menu.ascn")
+        let url = directory.appendingPathComponent("menu.ascn")
+        #expect(try Data(contentsOf: url).prefix(4) != Data("SCNB".utf8))
+
+        let loaded = try await AssetsManager.load(Scene.self, at: url.path).asset!
+        #expect(loaded.name == "Menu")
+        #expect(loaded.world.getEntityByName("Title")?.components[SceneTestLabel.self]?.text == "Start")
+    }
+}
@@ -99,4 +99,35 @@ struct UniqueHashableTests {
         let int1: Int = 42
         #expect(int1.uniqueHashValue == -55488592825689361)
     }
+
+    @Test
+    func `SHA256Hasher matches reference vectors`() {
+        let vectors: [(String, String)] = [
+            ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"),
+            ("abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"),
+            (
+                "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"
+            )
+        ]
+
+        for (message, expectedDigest) in vectors {
+            var hasher = SHA256Hasher()
+            hasher.combine(contentsOf: message.utf8)
+            #expect(hasher.finalize().hexString == expectedDigest)
+        }
+    }
+
+    @Test
+    func `SHA256Hasher separates sequential strings`() {
+        var hasher1 = SHA256Hasher()
+        hasher1.combine("ab")
+        hasher1.combine("c")
+
+        var hasher2 = SHA256Hasher()
+        hasher2.combine("a")
+        hasher2.combine("bc")
+
+        #expect(hasher1.finalize() != hasher2.finalize())
+    }
 }